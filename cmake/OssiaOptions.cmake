@@ -68,6 +68,8 @@ option(OSSIA_ENABLE_FFT "Enable FFT support" OFF)
 option(OSSIA_ENABLE_FFTW "Enable FFT through FFTW" OFF)
 option(OSSIA_ENABLE_KFR "Enable KFR library" OFF)
 
+option(OSSIA_AUDIO_FLOAT "Use single precision samples in the audio graph" OFF)
+
 # List of all the available protocols
 set(OSSIA_AVAILABLE_PROTOCOLS
   AUDIO MIDI
@@ -2,6 +2,7 @@
 
 #include "audio_protocol.hpp"
 
+#include <ossia/dataflow/audio_kernels.hpp>
 #include <ossia/dataflow/execution_state.hpp>
 #include <ossia/dataflow/nodes/sound.hpp>
 #include <ossia/network/common/complex_type.hpp>
@@ -30,8 +31,7 @@ void audio_parameter::clone_value(audio_vector& res_vec) const
     if(res.size() < N)
       res.resize(N);
 
-    for(std::size_t i = 0; i < N; i++)
-      res[i] += double(src[i]);
+    audio_mix(audio_kernels(), src.data(), res.data(), N);
   }
 }
 
@@ -43,10 +43,7 @@ void audio_parameter::push_value(const audio_port& port)
     auto& src = port.channel(chan);
     auto& dst = audio[chan];
     const auto N = std::min(src.size(), (std::size_t)dst.size());
-    for(std::size_t i = 0; i < N; i++)
-    {
-      dst[i] += float(src[i] * m_gain);
-    }
+    audio_mix_gain(audio_kernels(), src.data(), dst.data(), N, m_gain);
   }
 }
 
@@ -0,0 +1,86 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <ossia/dataflow/audio_arena.hpp>
+
+#include <cassert>
+#include <new>
+
+namespace ossia
+{
+namespace
+{
+constexpr std::size_t align_up(std::size_t bytes) noexcept
+{
+  return (bytes + audio_arena::alignment - 1) & ~(audio_arena::alignment - 1);
+}
+}
+
+audio_arena* audio_arena::create() noexcept
+{
+  return new(std::nothrow) audio_arena;
+}
+
+audio_arena::~audio_arena()
+{
+  if(m_slab)
+    heap::deallocate(m_slab, m_capacity);
+}
+
+void* audio_arena::allocate(std::size_t bytes) noexcept
+{
+#if defined(NDEBUG)
+  return allocate_unchecked(bytes);
+#else
+  // Two threads allocating at once would get the same part of the slab
+  [[maybe_unused]] const bool busy
+      = m_allocating.exchange(true, std::memory_order_acquire);
+  assert(!busy);
+  auto p = allocate_unchecked(bytes);
+  m_allocating.store(false, std::memory_order_release);
+  return p;
+#endif
+}
+
+void* audio_arena::allocate_unchecked(std::size_t bytes) noexcept
+{
+  bytes = align_up(bytes ? bytes : 1);
+
+  if(m_live.load(std::memory_order_acquire) == 0)
+  {
+    // Nothing uses the slab anymore: start a new cycle,
+    // with a slab large enough for everything the previous one needed.
+    if(m_demand > m_capacity)
+    {
+      if(m_slab)
+        heap::deallocate(m_slab, m_capacity);
+      m_slab = heap::allocate(m_demand);
+      m_capacity = m_slab ? m_demand : 0;
+    }
+    m_used = 0;
+    m_demand = 0;
+  }
+
+  m_demand += bytes;
+  m_live.fetch_add(1, std::memory_order_relaxed);
+
+  if(m_used + bytes <= m_capacity)
+  {
+    auto p = m_slab + m_used;
+    m_used += bytes;
+    return p;
+  }
+
+  return heap::allocate(bytes);
+}
+
+void audio_arena::deallocate(void* p) noexcept
+{
+  if(!p)
+    return;
+
+  if(!owns(p))
+    heap::deallocate(static_cast<char*>(p), 0);
+
+  m_live.fetch_sub(1, std::memory_order_release);
+}
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+
+#include <ossia/detail/pod_vector.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace ossia
+{
+/**
+ * @brief Contiguous storage for the channels of an audio port.
+ *
+ * The channels of a port allocate from a single slab, one after the other,
+ * each allocation starting on a cache line. The slab is rewound as soon as
+ * no channel uses it anymore, which happens once per tick when the graph
+ * clears the port.
+ *
+ * Allocations which do not fit in the slab go to the heap. The slab is
+ * then regrown, at the next rewind, to what the whole cycle needed, so
+ * that after a few ticks all the channels of the port are contiguous.
+ *
+ * The arena is reference-counted by the allocators using it: a channel
+ * moved out of its port stays valid.
+ *
+ * allocate() must only be called by one thread at a time: the arena belongs
+ * to a single port, and is used by the node running that port. Channels
+ * which leave the port, for instance when move_data swaps the channels of
+ * the two ports of a cable, are then only resized by the node at the other
+ * end, which never runs at the same time. Debug builds assert this.
+ * deallocate() can be called from any thread.
+ */
+class OSSIA_EXPORT audio_arena
+{
+public:
+  static constexpr std::size_t alignment = 64;
+
+  //! A new arena, without any reference, or nullptr if out of memory.
+  static audio_arena* create() noexcept;
+
+  void retain() noexcept { m_refs.fetch_add(1, std::memory_order_relaxed); }
+  void release() noexcept
+  {
+    if(m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete this;
+  }
+
+  //! Not thread-safe, see above
+  void* allocate(std::size_t bytes) noexcept;
+  void deallocate(void* p) noexcept;
+
+  [[nodiscard]] bool owns(const void* p) const noexcept
+  {
+    return p >= m_slab && p < m_slab + m_capacity;
+  }
+
+  //! Size of the slab
+  [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+  //! Bytes used in the slab since the last rewind
+  [[nodiscard]] std::size_t used() const noexcept { return m_used; }
+
+  //! Number of live allocations, in the slab or not
+  [[nodiscard]] std::size_t allocations() const noexcept
+  {
+    return m_live.load(std::memory_order_relaxed);
+  }
+
+private:
+  audio_arena() noexcept = default;
+  ~audio_arena();
+
+  void* allocate_unchecked(std::size_t bytes) noexcept;
+
+  using heap = aligned_pod_allocator<char, alignment>;
+
+  char* m_slab{};
+  std::size_t m_capacity{};
+  std::size_t m_used{};
+  std::size_t m_demand{};
+  std::atomic_size_t m_live{};
+  std::atomic_int m_refs{};
+  std::atomic_bool m_allocating{};
+};
+
+/**
+ * @brief Allocator of audio_channel.
+ *
+ * Without an arena it behaves like the allocator of pod_vector.
+ * Copies of a channel do not share its arena: they allocate on the heap.
+ */
+template <typename T>
+class audio_channel_allocator
+{
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  template <class U>
+  struct rebind
+  {
+    using other = audio_channel_allocator<U>;
+  };
+
+  audio_channel_allocator() noexcept = default;
+  explicit audio_channel_allocator(audio_arena* arena) noexcept
+      : m_arena{arena}
+  {
+    if(m_arena)
+      m_arena->retain();
+  }
+
+  template <typename U>
+  audio_channel_allocator(const audio_channel_allocator<U>& other) noexcept
+      : audio_channel_allocator{other.arena()}
+  {
+  }
+
+  audio_channel_allocator(const audio_channel_allocator& other) noexcept
+      : audio_channel_allocator{other.m_arena}
+  {
+  }
+
+  audio_channel_allocator(audio_channel_allocator&& other) noexcept
+      : m_arena{std::exchange(other.m_arena, nullptr)}
+  {
+  }
+
+  audio_channel_allocator& operator=(const audio_channel_allocator& other) noexcept
+  {
+    audio_channel_allocator{other}.swap(*this);
+    return *this;
+  }
+
+  audio_channel_allocator& operator=(audio_channel_allocator&& other) noexcept
+  {
+    audio_channel_allocator{std::move(other)}.swap(*this);
+    return *this;
+  }
+
+  ~audio_channel_allocator()
+  {
+    if(m_arena)
+      m_arena->release();
+  }
+
+  void swap(audio_channel_allocator& other) noexcept { std::swap(m_arena, other.m_arena); }
+
+  T* allocate(std::size_t num) noexcept
+  {
+    if(m_arena)
+      return static_cast<T*>(m_arena->allocate(sizeof(T) * num));
+    return pod_allocator_avx2<T>::allocate(num);
+  }
+
+  void deallocate(T* p, std::size_t num) noexcept
+  {
+    if(m_arena)
+      m_arena->deallocate(p);
+    else
+      pod_allocator_avx2<T>::deallocate(p, num);
+  }
+
+  audio_channel_allocator select_on_container_copy_construction() const noexcept
+  {
+    return {};
+  }
+
+  [[nodiscard]] audio_arena* arena() const noexcept { return m_arena; }
+
+  friend bool
+  operator==(const audio_channel_allocator& lhs, const audio_channel_allocator& rhs) noexcept
+  {
+    return lhs.m_arena == rhs.m_arena;
+  }
+  friend bool
+  operator!=(const audio_channel_allocator& lhs, const audio_channel_allocator& rhs) noexcept
+  {
+    return lhs.m_arena != rhs.m_arena;
+  }
+
+private:
+  audio_arena* m_arena{};
+};
+}
@@ -0,0 +1,403 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <ossia/dataflow/audio_kernels.hpp>
+
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define OSSIA_KERNELS_SSE2 1
+#include <emmintrin.h>
+// AVX2 functions are compiled with the target attribute and only
+// called after checking the CPU.
+#if defined(__GNUC__) || defined(__clang__)
+#define OSSIA_KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define OSSIA_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace ossia
+{
+namespace kernels_scalar
+{
+#define OSSIA_KERNEL_TARGET
+struct simd
+{
+  using vd = double;
+  using vf = float;
+  using vi = int32_t;
+  static constexpr std::size_t dw = 1;
+  static constexpr std::size_t fw = 1;
+
+  static vd load_d(const double* p) noexcept { return *p; }
+  static void store_d(double* p, vd v) noexcept { *p = v; }
+  static vd set1_d(double v) noexcept { return v; }
+  static vd add_d(vd a, vd b) noexcept { return a + b; }
+  static vd mul_d(vd a, vd b) noexcept { return a * b; }
+  static vd fma_d(vd a, vd b, vd c) noexcept { return a * b + c; }
+  static vd load_f_as_d(const float* p) noexcept { return *p; }
+  static void store_d_as_f(float* p, vd v) noexcept { *p = float(v); }
+
+  static vf load_f(const float* p) noexcept { return *p; }
+  static void store_f(float* p, vf v) noexcept { *p = v; }
+  static vf set1_f(float v) noexcept { return v; }
+  static vf add_f(vf a, vf b) noexcept { return a + b; }
+  static vf sub_f(vf a, vf b) noexcept { return a - b; }
+  static vf mul_f(vf a, vf b) noexcept { return a * b; }
+  static vf div_f(vf a, vf b) noexcept { return a / b; }
+  static vf fma_f(vf a, vf b, vf c) noexcept { return a * b + c; }
+  static vf min_f(vf a, vf b) noexcept { return a < b ? a : b; }
+  static vf max_f(vf a, vf b) noexcept { return a > b ? a : b; }
+
+  static vi cvtt_f(vf v) noexcept { return vi(v); }
+  static void store_i32(int32_t* p, vi v) noexcept { *p = v; }
+  static void store_i16(int16_t* p, vi a, vi b) noexcept
+  {
+    // The inputs are already clamped to the int16 range
+    p[0] = int16_t(a);
+    p[1] = int16_t(b);
+  }
+  static vf load_i32_as_f(const int32_t* p) noexcept { return vf(*p); }
+  static vf load_i16_as_f(const int16_t* p) noexcept { return vf(*p); }
+
+  static void interleave2(float* out, vf a, vf b) noexcept
+  {
+    out[0] = a;
+    out[1] = b;
+  }
+  static void deinterleave2(const float* in, vf& a, vf& b) noexcept
+  {
+    a = in[0];
+    b = in[1];
+  }
+};
+
+#include <ossia/dataflow/audio_kernels_impl.hpp>
+#undef OSSIA_KERNEL_TARGET
+}
+
+#if defined(OSSIA_KERNELS_SSE2)
+namespace kernels_sse2
+{
+#define OSSIA_KERNEL_TARGET
+struct simd
+{
+  using vd = __m128d;
+  using vf = __m128;
+  using vi = __m128i;
+  static constexpr std::size_t dw = 2;
+  static constexpr std::size_t fw = 4;
+
+  static vd load_d(const double* p) noexcept { return _mm_loadu_pd(p); }
+  static void store_d(double* p, vd v) noexcept { _mm_storeu_pd(p, v); }
+  static vd set1_d(double v) noexcept { return _mm_set1_pd(v); }
+  static vd add_d(vd a, vd b) noexcept { return _mm_add_pd(a, b); }
+  static vd mul_d(vd a, vd b) noexcept { return _mm_mul_pd(a, b); }
+  static vd fma_d(vd a, vd b, vd c) noexcept { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+  static vd load_f_as_d(const float* p) noexcept
+  {
+    return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)p)));
+  }
+  static void store_d_as_f(float* p, vd v) noexcept
+  {
+    _mm_storel_epi64((__m128i*)p, _mm_castps_si128(_mm_cvtpd_ps(v)));
+  }
+
+  static vf load_f(const float* p) noexcept { return _mm_loadu_ps(p); }
+  static void store_f(float* p, vf v) noexcept { _mm_storeu_ps(p, v); }
+  static vf set1_f(float v) noexcept { return _mm_set1_ps(v); }
+  static vf add_f(vf a, vf b) noexcept { return _mm_add_ps(a, b); }
+  static vf sub_f(vf a, vf b) noexcept { return _mm_sub_ps(a, b); }
+  static vf mul_f(vf a, vf b) noexcept { return _mm_mul_ps(a, b); }
+  static vf div_f(vf a, vf b) noexcept { return _mm_div_ps(a, b); }
+  static vf fma_f(vf a, vf b, vf c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+  static vf min_f(vf a, vf b) noexcept { return _mm_min_ps(a, b); }
+  static vf max_f(vf a, vf b) noexcept { return _mm_max_ps(a, b); }
+
+  static vi cvtt_f(vf v) noexcept { return _mm_cvttps_epi32(v); }
+  static void store_i32(int32_t* p, vi v) noexcept { _mm_storeu_si128((__m128i*)p, v); }
+  static void store_i16(int16_t* p, vi a, vi b) noexcept
+  {
+    _mm_storeu_si128((__m128i*)p, _mm_packs_epi32(a, b));
+  }
+  static vf load_i32_as_f(const int32_t* p) noexcept
+  {
+    return _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)p));
+  }
+  static vf load_i16_as_f(const int16_t* p) noexcept
+  {
+    // Sign extension of the four int16 to int32
+    const __m128i x = _mm_loadl_epi64((const __m128i*)p);
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+  }
+
+  static void interleave2(float* out, vf a, vf b) noexcept
+  {
+    _mm_storeu_ps(out, _mm_unpacklo_ps(a, b));
+    _mm_storeu_ps(out + 4, _mm_unpackhi_ps(a, b));
+  }
+  static void deinterleave2(const float* in, vf& a, vf& b) noexcept
+  {
+    const vf x = _mm_loadu_ps(in);
+    const vf y = _mm_loadu_ps(in + 4);
+    a = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+    b = _mm_shuffle_ps(x, y, _MM_SHUFFLE(3, 1, 3, 1));
+  }
+};
+
+#include <ossia/dataflow/audio_kernels_impl.hpp>
+#undef OSSIA_KERNEL_TARGET
+}
+#endif
+
+#if defined(OSSIA_KERNELS_AVX2)
+namespace kernels_avx2
+{
+#define OSSIA_KERNEL_TARGET __attribute__((target("avx2,fma")))
+struct simd
+{
+  using vd = __m256d;
+  using vf = __m256;
+  using vi = __m256i;
+  static constexpr std::size_t dw = 4;
+  static constexpr std::size_t fw = 8;
+
+  OSSIA_KERNEL_TARGET static vd load_d(const double* p) noexcept
+  {
+    return _mm256_loadu_pd(p);
+  }
+  OSSIA_KERNEL_TARGET static void store_d(double* p, vd v) noexcept
+  {
+    _mm256_storeu_pd(p, v);
+  }
+  OSSIA_KERNEL_TARGET static vd set1_d(double v) noexcept { return _mm256_set1_pd(v); }
+  OSSIA_KERNEL_TARGET static vd add_d(vd a, vd b) noexcept
+  {
+    return _mm256_add_pd(a, b);
+  }
+  OSSIA_KERNEL_TARGET static vd mul_d(vd a, vd b) noexcept
+  {
+    return _mm256_mul_pd(a, b);
+  }
+  OSSIA_KERNEL_TARGET static vd fma_d(vd a, vd b, vd c) noexcept
+  {
+    return _mm256_fmadd_pd(a, b, c);
+  }
+  OSSIA_KERNEL_TARGET static vd load_f_as_d(const float* p) noexcept
+  {
+    return _mm256_cvtps_pd(_mm_loadu_ps(p));
+  }
+  OSSIA_KERNEL_TARGET static void store_d_as_f(float* p, vd v) noexcept
+  {
+    _mm_storeu_ps(p, _mm256_cvtpd_ps(v));
+  }
+
+  OSSIA_KERNEL_TARGET static vf load_f(const float* p) noexcept
+  {
+    return _mm256_loadu_ps(p);
+  }
+  OSSIA_KERNEL_TARGET static void store_f(float* p, vf v) noexcept
+  {
+    _mm256_storeu_ps(p, v);
+  }
+  OSSIA_KERNEL_TARGET static vf set1_f(float v) noexcept { return _mm256_set1_ps(v); }
+  OSSIA_KERNEL_TARGET static vf add_f(vf a, vf b) noexcept
+  {
+    return _mm256_add_ps(a, b);
+  }
+  OSSIA_KERNEL_TARGET static vf sub_f(vf a, vf b) noexcept
+  {
+    return _mm256_sub_ps(a, b);
+  }
+  OSSIA_KERNEL_TARGET static vf mul_f(vf a, vf b) noexcept
+  {
+    return _mm256_mul_ps(a, b);
+  }
+  OSSIA_KERNEL_TARGET static vf div_f(vf a, vf b) noexcept
+  {
+    return _mm256_div_ps(a, b);
+  }
+  OSSIA_KERNEL_TARGET static vf fma_f(vf a, vf b, vf c) noexcept
+  {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+  OSSIA_KERNEL_TARGET static vf min_f(vf a, vf b) noexcept
+  {
+    return _mm256_min_ps(a, b);
+  }
+  OSSIA_KERNEL_TARGET static vf max_f(vf a, vf b) noexcept
+  {
+    return _mm256_max_ps(a, b);
+  }
+
+  OSSIA_KERNEL_TARGET static vi cvtt_f(vf v) noexcept { return _mm256_cvttps_epi32(v); }
+  OSSIA_KERNEL_TARGET static void store_i32(int32_t* p, vi v) noexcept
+  {
+    _mm256_storeu_si256((__m256i*)p, v);
+  }
+  OSSIA_KERNEL_TARGET static void store_i16(int16_t* p, vi a, vi b) noexcept
+  {
+    // packs works on each 128-bit lane: a0-3 b0-3 a4-7 b4-7
+    const __m256i packed = _mm256_packs_epi32(a, b);
+    _mm256_storeu_si256(
+        (__m256i*)p, _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+  }
+  OSSIA_KERNEL_TARGET static vf load_i32_as_f(const int32_t* p) noexcept
+  {
+    return _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)p));
+  }
+  OSSIA_KERNEL_TARGET static vf load_i16_as_f(const int16_t* p) noexcept
+  {
+    return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)p)));
+  }
+
+  OSSIA_KERNEL_TARGET static void interleave2(float* out, vf a, vf b) noexcept
+  {
+    // unpack works on each 128-bit lane
+    const vf lo = _mm256_unpacklo_ps(a, b);
+    const vf hi = _mm256_unpackhi_ps(a, b);
+    _mm256_storeu_ps(out, _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+  }
+  OSSIA_KERNEL_TARGET static void deinterleave2(const float* in, vf& a, vf& b) noexcept
+  {
+    const vf x = _mm256_loadu_ps(in);
+    const vf y = _mm256_loadu_ps(in + 8);
+    const vf lo = _mm256_permute2f128_ps(x, y, 0x20);
+    const vf hi = _mm256_permute2f128_ps(x, y, 0x31);
+    a = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+    b = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+  }
+};
+
+#include <ossia/dataflow/audio_kernels_impl.hpp>
+#undef OSSIA_KERNEL_TARGET
+}
+#endif
+
+#if defined(OSSIA_KERNELS_NEON)
+namespace kernels_neon
+{
+#define OSSIA_KERNEL_TARGET
+struct simd
+{
+  using vd = float64x2_t;
+  using vf = float32x4_t;
+  using vi = int32x4_t;
+  static constexpr std::size_t dw = 2;
+  static constexpr std::size_t fw = 4;
+
+  static vd load_d(const double* p) noexcept { return vld1q_f64(p); }
+  static void store_d(double* p, vd v) noexcept { vst1q_f64(p, v); }
+  static vd set1_d(double v) noexcept { return vdupq_n_f64(v); }
+  static vd add_d(vd a, vd b) noexcept { return vaddq_f64(a, b); }
+  static vd mul_d(vd a, vd b) noexcept { return vmulq_f64(a, b); }
+  static vd fma_d(vd a, vd b, vd c) noexcept { return vfmaq_f64(c, a, b); }
+  static vd load_f_as_d(const float* p) noexcept { return vcvt_f64_f32(vld1_f32(p)); }
+  static void store_d_as_f(float* p, vd v) noexcept { vst1_f32(p, vcvt_f32_f64(v)); }
+
+  static vf load_f(const float* p) noexcept { return vld1q_f32(p); }
+  static void store_f(float* p, vf v) noexcept { vst1q_f32(p, v); }
+  static vf set1_f(float v) noexcept { return vdupq_n_f32(v); }
+  static vf add_f(vf a, vf b) noexcept { return vaddq_f32(a, b); }
+  static vf sub_f(vf a, vf b) noexcept { return vsubq_f32(a, b); }
+  static vf mul_f(vf a, vf b) noexcept { return vmulq_f32(a, b); }
+  static vf div_f(vf a, vf b) noexcept { return vdivq_f32(a, b); }
+  static vf fma_f(vf a, vf b, vf c) noexcept { return vfmaq_f32(c, a, b); }
+  static vf min_f(vf a, vf b) noexcept { return vminq_f32(a, b); }
+  static vf max_f(vf a, vf b) noexcept { return vmaxq_f32(a, b); }
+
+  static vi cvtt_f(vf v) noexcept { return vcvtq_s32_f32(v); }
+  static void store_i32(int32_t* p, vi v) noexcept { vst1q_s32(p, v); }
+  static void store_i16(int16_t* p, vi a, vi b) noexcept
+  {
+    vst1q_s16(p, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+  }
+  static vf load_i32_as_f(const int32_t* p) noexcept { return vcvtq_f32_s32(vld1q_s32(p)); }
+  static vf load_i16_as_f(const int16_t* p) noexcept
+  {
+    return vcvtq_f32_s32(vmovl_s16(vld1_s16(p)));
+  }
+
+  static void interleave2(float* out, vf a, vf b) noexcept
+  {
+    vst2q_f32(out, float32x4x2_t{{a, b}});
+  }
+  static void deinterleave2(const float* in, vf& a, vf& b) noexcept
+  {
+    const float32x4x2_t v = vld2q_f32(in);
+    a = v.val[0];
+    b = v.val[1];
+  }
+};
+
+#include <ossia/dataflow/audio_kernels_impl.hpp>
+#undef OSSIA_KERNEL_TARGET
+}
+#endif
+
+namespace
+{
+const audio_kernel_table scalar_kernels
+    = kernels_scalar::make_table(simd_isa::scalar, "scalar");
+#if defined(OSSIA_KERNELS_SSE2)
+const audio_kernel_table sse2_kernels = kernels_sse2::make_table(simd_isa::sse2, "sse2");
+#endif
+#if defined(OSSIA_KERNELS_AVX2)
+const audio_kernel_table avx2_kernels = kernels_avx2::make_table(simd_isa::avx2, "avx2");
+#endif
+#if defined(OSSIA_KERNELS_NEON)
+const audio_kernel_table neon_kernels = kernels_neon::make_table(simd_isa::neon, "neon");
+#endif
+
+bool cpu_has_avx2() noexcept
+{
+#if defined(OSSIA_KERNELS_AVX2)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+  return false;
+#endif
+}
+}
+
+const audio_kernel_table* audio_kernels_for(simd_isa isa) noexcept
+{
+  switch(isa)
+  {
+    case simd_isa::scalar:
+      return &scalar_kernels;
+#if defined(OSSIA_KERNELS_SSE2)
+    case simd_isa::sse2:
+      return &sse2_kernels;
+#endif
+#if defined(OSSIA_KERNELS_AVX2)
+    case simd_isa::avx2: {
+      static const bool has_avx2 = cpu_has_avx2();
+      return has_avx2 ? &avx2_kernels : nullptr;
+    }
+#endif
+#if defined(OSSIA_KERNELS_NEON)
+    case simd_isa::neon:
+      return &neon_kernels;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+const audio_kernel_table& audio_kernels() noexcept
+{
+  static const audio_kernel_table& best = [] () -> const audio_kernel_table& {
+    for(auto isa : {simd_isa::avx2, simd_isa::neon, simd_isa::sse2})
+      if(auto k = audio_kernels_for(isa))
+        return *k;
+    return scalar_kernels;
+  }();
+  return best;
+}
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ossia
+{
+enum class simd_isa : uint8_t
+{
+  scalar,
+  sse2,
+  avx2,
+  neon
+};
+
+/**
+ * @brief Inner loops of the audio graph and of the audio backends.
+ *
+ * One table exists per instruction set supported by the build;
+ * audio_kernels() returns the best one for the running CPU.
+ * The graph works on dsp_sample channels (double, or float with
+ * OSSIA_AUDIO_FLOAT) while the audio backends exchange float buffers:
+ * the *_float kernels convert between both. Callers working on dsp_sample
+ * should go through the audio_mix / audio_mix_gain / audio_copy_gain
+ * overloads below, which pick the kernel matching the sample types.
+ *
+ * Unless noted, the buffers must not overlap and can have any alignment.
+ */
+struct audio_kernel_table
+{
+  simd_isa isa{};
+  const char* name{};
+
+  //! dst[i] += src[i]
+  void (*mix)(const double* src, double* dst, std::size_t n) noexcept {};
+
+  //! dst[i] += gain * src[i]
+  void (*mix_gain)(const double* src, double* dst, std::size_t n, double gain) noexcept {};
+
+  //! dst[i] = gain * src[i]. src and dst can be the same buffer.
+  void (*copy_gain)(const double* src, double* dst, std::size_t n, double gain) noexcept {};
+
+  //! dst[i] += src[i]
+  void (*mix_from_float)(const float* src, double* dst, std::size_t n) noexcept {};
+
+  //! dst[i] += float(gain * src[i])
+  void (*mix_to_float)(const double* src, float* dst, std::size_t n, double gain) noexcept {};
+
+  //! Single precision mix, mix_gain and copy_gain
+  void (*mix_f)(const float* src, float* dst, std::size_t n) noexcept {};
+  void (*mix_gain_f)(const float* src, float* dst, std::size_t n, float gain) noexcept {};
+  void (*copy_gain_f)(const float* src, float* dst, std::size_t n, float gain) noexcept {};
+
+  //! out[i * channels + c] = in[c][i]
+  void (*interleave)(
+      const float* const* in, float* out, std::size_t channels, std::size_t n) noexcept {};
+
+  //! out[c][i] = in[i * channels + c]
+  void (*deinterleave)(
+      const float* in, float* const* out, std::size_t channels, std::size_t n) noexcept {};
+
+  //! Same conversions as float_to_sample, saturated to the range of the format.
+  void (*float_to_s16)(const float* in, int16_t* out, std::size_t n) noexcept {};
+  void (*float_to_s24)(const float* in, int32_t* out, std::size_t n) noexcept {};
+  void (*float_to_s32)(const float* in, int32_t* out, std::size_t n) noexcept {};
+
+  //! Same conversions as sample_to_float.
+  void (*s16_to_float)(const int16_t* in, float* out, std::size_t n) noexcept {};
+  void (*s32_to_float)(const int32_t* in, float* out, std::size_t n) noexcept {};
+};
+
+//! The kernels for the best instruction set supported by the CPU.
+OSSIA_EXPORT
+const audio_kernel_table& audio_kernels() noexcept;
+
+//! The kernels for a given instruction set,
+//! or nullptr if the build or the CPU does not support it.
+OSSIA_EXPORT
+const audio_kernel_table* audio_kernels_for(simd_isa isa) noexcept;
+
+//! dst[i] += src[i]
+inline void audio_mix(
+    const audio_kernel_table& k, const double* src, double* dst, std::size_t n) noexcept
+{
+  k.mix(src, dst, n);
+}
+inline void audio_mix(
+    const audio_kernel_table& k, const float* src, float* dst, std::size_t n) noexcept
+{
+  k.mix_f(src, dst, n);
+}
+inline void audio_mix(
+    const audio_kernel_table& k, const float* src, double* dst, std::size_t n) noexcept
+{
+  k.mix_from_float(src, dst, n);
+}
+
+//! dst[i] += gain * src[i]
+inline void audio_mix_gain(
+    const audio_kernel_table& k, const double* src, double* dst, std::size_t n,
+    double gain) noexcept
+{
+  k.mix_gain(src, dst, n, gain);
+}
+inline void audio_mix_gain(
+    const audio_kernel_table& k, const float* src, float* dst, std::size_t n,
+    double gain) noexcept
+{
+  k.mix_gain_f(src, dst, n, float(gain));
+}
+inline void audio_mix_gain(
+    const audio_kernel_table& k, const double* src, float* dst, std::size_t n,
+    double gain) noexcept
+{
+  k.mix_to_float(src, dst, n, gain);
+}
+
+//! dst[i] = gain * src[i]. src and dst can be the same buffer.
+inline void audio_copy_gain(
+    const audio_kernel_table& k, const double* src, double* dst, std::size_t n,
+    double gain) noexcept
+{
+  k.copy_gain(src, dst, n, gain);
+}
+inline void audio_copy_gain(
+    const audio_kernel_table& k, const float* src, float* dst, std::size_t n,
+    double gain) noexcept
+{
+  k.copy_gain_f(src, dst, n, float(gain));
+}
+}
@@ -0,0 +1,277 @@
+// Body of the audio kernels, included once per instruction set by
+// audio_kernels.cpp: no include guard on purpose.
+//
+// The including namespace provides:
+// - OSSIA_KERNEL_TARGET, the attributes of the functions using the
+//   instruction set;
+// - a `simd` struct with the vector types and operations:
+//   `vd` holds `dw` doubles, `vf` holds `fw` floats and `vi` fw int32.
+
+// Same scales as float_to_sample
+static constexpr float s24_scale = float(std::numeric_limits<int32_t>::max() / 256.);
+// Largest float below 2^31
+static constexpr float s32_max = 2147483520.f;
+
+OSSIA_KERNEL_TARGET
+static inline int16_t to_s16(float x) noexcept
+{
+  x = x * 32767.5f - 0.5f;
+  x = x < -32768.f ? -32768.f : x > 32767.f ? 32767.f : x;
+  return int16_t(x);
+}
+
+OSSIA_KERNEL_TARGET
+static inline int32_t to_s24(float x) noexcept
+{
+  x = x * s24_scale;
+  x = x < -8388608.f ? -8388608.f : x > 8388607.f ? 8388607.f : x;
+  return int32_t(x);
+}
+
+OSSIA_KERNEL_TARGET
+static inline int32_t to_s32(float x) noexcept
+{
+  x = x * 2147483648.f;
+  x = x < -2147483648.f ? -2147483648.f : x > s32_max ? s32_max : x;
+  return int32_t(x);
+}
+
+OSSIA_KERNEL_TARGET
+static inline simd::vi clamp_cvtt(simd::vf x, simd::vf lo, simd::vf hi) noexcept
+{
+  return simd::cvtt_f(simd::min_f(simd::max_f(x, lo), hi));
+}
+
+OSSIA_KERNEL_TARGET
+static void mix(const double* src, double* dst, std::size_t n) noexcept
+{
+  std::size_t i = 0;
+  for(; i + simd::dw <= n; i += simd::dw)
+    simd::store_d(dst + i, simd::add_d(simd::load_d(dst + i), simd::load_d(src + i)));
+  for(; i < n; i++)
+    dst[i] += src[i];
+}
+
+OSSIA_KERNEL_TARGET
+static void mix_gain(const double* src, double* dst, std::size_t n, double gain) noexcept
+{
+  const auto g = simd::set1_d(gain);
+  std::size_t i = 0;
+  for(; i + simd::dw <= n; i += simd::dw)
+    simd::store_d(dst + i, simd::fma_d(simd::load_d(src + i), g, simd::load_d(dst + i)));
+  for(; i < n; i++)
+    dst[i] += gain * src[i];
+}
+
+OSSIA_KERNEL_TARGET
+static void copy_gain(const double* src, double* dst, std::size_t n, double gain) noexcept
+{
+  const auto g = simd::set1_d(gain);
+  std::size_t i = 0;
+  for(; i + simd::dw <= n; i += simd::dw)
+    simd::store_d(dst + i, simd::mul_d(simd::load_d(src + i), g));
+  for(; i < n; i++)
+    dst[i] = gain * src[i];
+}
+
+OSSIA_KERNEL_TARGET
+static void mix_from_float(const float* src, double* dst, std::size_t n) noexcept
+{
+  std::size_t i = 0;
+  for(; i + simd::dw <= n; i += simd::dw)
+    simd::store_d(
+        dst + i, simd::add_d(simd::load_d(dst + i), simd::load_f_as_d(src + i)));
+  for(; i < n; i++)
+    dst[i] += double(src[i]);
+}
+
+OSSIA_KERNEL_TARGET
+static void mix_to_float(const double* src, float* dst, std::size_t n, double gain) noexcept
+{
+  const auto g = simd::set1_d(gain);
+  std::size_t i = 0;
+  for(; i + simd::dw <= n; i += simd::dw)
+    simd::store_d_as_f(
+        dst + i, simd::add_d(
+                     simd::load_f_as_d(dst + i), simd::mul_d(simd::load_d(src + i), g)));
+  for(; i < n; i++)
+    dst[i] = float(double(dst[i]) + src[i] * gain);
+}
+
+OSSIA_KERNEL_TARGET
+static void mix_f(const float* src, float* dst, std::size_t n) noexcept
+{
+  std::size_t i = 0;
+  for(; i + simd::fw <= n; i += simd::fw)
+    simd::store_f(dst + i, simd::add_f(simd::load_f(dst + i), simd::load_f(src + i)));
+  for(; i < n; i++)
+    dst[i] += src[i];
+}
+
+OSSIA_KERNEL_TARGET
+static void mix_gain_f(const float* src, float* dst, std::size_t n, float gain) noexcept
+{
+  const auto g = simd::set1_f(gain);
+  std::size_t i = 0;
+  for(; i + simd::fw <= n; i += simd::fw)
+    simd::store_f(dst + i, simd::fma_f(simd::load_f(src + i), g, simd::load_f(dst + i)));
+  for(; i < n; i++)
+    dst[i] += gain * src[i];
+}
+
+OSSIA_KERNEL_TARGET
+static void copy_gain_f(const float* src, float* dst, std::size_t n, float gain) noexcept
+{
+  const auto g = simd::set1_f(gain);
+  std::size_t i = 0;
+  for(; i + simd::fw <= n; i += simd::fw)
+    simd::store_f(dst + i, simd::mul_f(simd::load_f(src + i), g));
+  for(; i < n; i++)
+    dst[i] = gain * src[i];
+}
+
+OSSIA_KERNEL_TARGET
+static void interleave(
+    const float* const* in, float* out, std::size_t channels, std::size_t n) noexcept
+{
+  std::size_t i = 0;
+  if(channels == 2)
+  {
+    const float* l = in[0];
+    const float* r = in[1];
+    for(; i + simd::fw <= n; i += simd::fw)
+      simd::interleave2(out + 2 * i, simd::load_f(l + i), simd::load_f(r + i));
+  }
+
+  for(std::size_t c = 0; c < channels; c++)
+  {
+    const float* chan = in[c];
+    for(std::size_t k = i; k < n; k++)
+      out[k * channels + c] = chan[k];
+  }
+}
+
+OSSIA_KERNEL_TARGET
+static void deinterleave(
+    const float* in, float* const* out, std::size_t channels, std::size_t n) noexcept
+{
+  std::size_t i = 0;
+  if(channels == 2)
+  {
+    float* l = out[0];
+    float* r = out[1];
+    for(; i + simd::fw <= n; i += simd::fw)
+    {
+      simd::vf a, b;
+      simd::deinterleave2(in + 2 * i, a, b);
+      simd::store_f(l + i, a);
+      simd::store_f(r + i, b);
+    }
+  }
+
+  for(std::size_t c = 0; c < channels; c++)
+  {
+    float* chan = out[c];
+    for(std::size_t k = i; k < n; k++)
+      chan[k] = in[k * channels + c];
+  }
+}
+
+OSSIA_KERNEL_TARGET
+static void float_to_s16(const float* in, int16_t* out, std::size_t n) noexcept
+{
+  const auto scale = simd::set1_f(32767.5f);
+  const auto offset = simd::set1_f(0.5f);
+  const auto lo = simd::set1_f(-32768.f);
+  const auto hi = simd::set1_f(32767.f);
+
+  std::size_t i = 0;
+  for(; i + 2 * simd::fw <= n; i += 2 * simd::fw)
+  {
+    auto a = simd::sub_f(simd::mul_f(simd::load_f(in + i), scale), offset);
+    auto b = simd::sub_f(simd::mul_f(simd::load_f(in + i + simd::fw), scale), offset);
+    simd::store_i16(out + i, clamp_cvtt(a, lo, hi), clamp_cvtt(b, lo, hi));
+  }
+  for(; i < n; i++)
+    out[i] = to_s16(in[i]);
+}
+
+OSSIA_KERNEL_TARGET
+static void float_to_s24(const float* in, int32_t* out, std::size_t n) noexcept
+{
+  const auto scale = simd::set1_f(s24_scale);
+  const auto lo = simd::set1_f(-8388608.f);
+  const auto hi = simd::set1_f(8388607.f);
+  std::size_t i = 0;
+  for(; i + simd::fw <= n; i += simd::fw)
+  {
+    auto x = simd::mul_f(simd::load_f(in + i), scale);
+    simd::store_i32(out + i, clamp_cvtt(x, lo, hi));
+  }
+  for(; i < n; i++)
+    out[i] = to_s24(in[i]);
+}
+
+OSSIA_KERNEL_TARGET
+static void float_to_s32(const float* in, int32_t* out, std::size_t n) noexcept
+{
+  const auto scale = simd::set1_f(2147483648.f);
+  const auto lo = simd::set1_f(-2147483648.f);
+  const auto hi = simd::set1_f(s32_max);
+  std::size_t i = 0;
+  for(; i + simd::fw <= n; i += simd::fw)
+  {
+    auto x = simd::mul_f(simd::load_f(in + i), scale);
+    simd::store_i32(out + i, clamp_cvtt(x, lo, hi));
+  }
+  for(; i < n; i++)
+    out[i] = to_s32(in[i]);
+}
+
+OSSIA_KERNEL_TARGET
+static void s16_to_float(const int16_t* in, float* out, std::size_t n) noexcept
+{
+  const auto offset = simd::set1_f(0.5f);
+  const auto scale = simd::set1_f(32767.5f);
+  std::size_t i = 0;
+  for(; i + simd::fw <= n; i += simd::fw)
+    simd::store_f(
+        out + i, simd::div_f(simd::add_f(simd::load_i16_as_f(in + i), offset), scale));
+  for(; i < n; i++)
+    out[i] = (in[i] + .5f) / 32767.5f;
+}
+
+OSSIA_KERNEL_TARGET
+static void s32_to_float(const int32_t* in, float* out, std::size_t n) noexcept
+{
+  // Division by 2^31: exact as a multiplication
+  const auto scale = simd::set1_f(1.f / 2147483648.f);
+  std::size_t i = 0;
+  for(; i + simd::fw <= n; i += simd::fw)
+    simd::store_f(out + i, simd::mul_f(simd::load_i32_as_f(in + i), scale));
+  for(; i < n; i++)
+    out[i] = in[i] * (1.f / 2147483648.f);
+}
+
+static constexpr audio_kernel_table make_table(simd_isa isa, const char* name) noexcept
+{
+  audio_kernel_table t;
+  t.isa = isa;
+  t.name = name;
+  t.mix = mix;
+  t.mix_gain = mix_gain;
+  t.copy_gain = copy_gain;
+  t.mix_from_float = mix_from_float;
+  t.mix_to_float = mix_to_float;
+  t.mix_f = mix_f;
+  t.mix_gain_f = mix_gain_f;
+  t.copy_gain_f = copy_gain_f;
+  t.interleave = interleave;
+  t.deinterleave = deinterleave;
+  t.float_to_s16 = float_to_s16;
+  t.float_to_s24 = float_to_s24;
+  t.float_to_s32 = float_to_s32;
+  t.s16_to_float = s16_to_float;
+  t.s32_to_float = s32_to_float;
+  return t;
+}
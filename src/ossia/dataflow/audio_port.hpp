@@ -16,13 +16,31 @@ void ensure_vector_sizes(const audio_vector& src_vec, audio_vector& sink_vec);
 OSSIA_EXPORT
 void mix(const audio_vector& src_vec, audio_vector& sink_vec);
 
+struct audio_port;
+
+//! Same as above, with the new channels allocated in the arena of the port
+OSSIA_EXPORT
+void ensure_vector_sizes(const audio_vector& src_vec, audio_port& sink);
+
+OSSIA_EXPORT
+void mix(const audio_vector& src_vec, audio_port& sink);
+
 struct OSSIA_EXPORT audio_buffer_pool : object_pool<audio_channel>
 {
   audio_buffer_pool();
   ~audio_buffer_pool();
   static audio_buffer_pool& instance() noexcept;
 
-  static void set_channels(audio_vector& samples, std::size_t channels);
+  /**
+   * @brief Resizes `samples` to `channels` channels.
+   *
+   * Without an arena in `alloc`, channels come from and go back to the pool.
+   * Otherwise new channels use `alloc`, and channels allocated in an arena
+   * are dropped instead of being pooled, so that their arena can be rewound.
+   */
+  static void set_channels(
+      audio_vector& samples, std::size_t channels,
+      const audio_channel::allocator_type& alloc = {});
 };
 
 using pan_weight = ossia::small_vector<double, 2>;
@@ -31,18 +49,39 @@ struct audio_port
 {
   static const constexpr int which = 0;
 
+  //! Tag for a port whose channels are allocated in an arena of its own
+  struct with_arena_t
+  {
+    explicit with_arena_t() = default;
+  };
+  static constexpr with_arena_t with_arena{};
+
+  //! A port whose channels are allocated on the heap
   audio_port() noexcept { set_channels(2); }
 
+  /**
+   * @brief A port whose channels are allocated in its own audio_arena.
+   *
+   * Used by the audio inlets and outlets, which are resized at every tick.
+   * Copies of the port, as well as temporaries, do not get an arena.
+   */
+  explicit audio_port(with_arena_t) noexcept
+      : m_allocator{audio_arena::create()}
+  {
+    set_channels(2);
+  }
+
   audio_port(const audio_port& other) noexcept { *this = other; }
 
   audio_port(audio_port&& other) noexcept
-      : m_samples{std::move(other.m_samples)}
+      : m_allocator{std::move(other.m_allocator)}
+      , m_samples{std::move(other.m_samples)}
   {
   }
 
   audio_port& operator=(const audio_port& other) noexcept
   {
-    audio_buffer_pool::set_channels(m_samples, other.channels());
+    set_channels(other.channels());
     for(std::size_t c = 0; c < other.channels(); c++)
     {
       channel(c) = other.channel(c);
@@ -53,6 +92,7 @@ struct audio_port
   audio_port& operator=(audio_port&& other) noexcept
   {
     m_samples = std::move(other.m_samples);
+    m_allocator.swap(other.m_allocator);
     other.set_channels(2);
 
     return *this;
@@ -71,15 +111,21 @@ struct audio_port
 
   void set_channels(std::size_t channels)
   {
-    return audio_buffer_pool::set_channels(m_samples, channels);
+    return audio_buffer_pool::set_channels(m_samples, channels, m_allocator);
+  }
+
+  //! Allocator of the channels of this port
+  [[nodiscard]] const audio_channel::allocator_type& get_allocator() const noexcept
+  {
+    return m_allocator;
   }
 
-  operator ossia::mutable_audio_span<double>() noexcept
+  operator ossia::mutable_audio_span<dsp_sample>() noexcept
   {
     return {m_samples.begin(), m_samples.end()};
   }
 
-  operator ossia::audio_span<double>() const noexcept
+  operator ossia::audio_span<dsp_sample>() const noexcept
   {
     return {m_samples.begin(), m_samples.end()};
   }
@@ -106,6 +152,7 @@ struct audio_port
 
 private:
   friend void ensure_vector_sizes(const audio_vector& src_vec, audio_vector& sink_vec);
+  audio_channel::allocator_type m_allocator;
   audio_vector m_samples;
 };
 
@@ -1,3 +1,4 @@
+#include <ossia/dataflow/audio_kernels.hpp>
 #include <ossia/dataflow/data_copy.hpp>
 #include <ossia/dataflow/value_port.hpp>
 #include <ossia/detail/algorithms.hpp>
@@ -125,12 +126,16 @@ void process_control_value(
   process_control_value(v, source_domain, sink_domain); // TODO does that make sense
 }
 
-void ensure_vector_sizes(const audio_vector& src_vec, audio_vector& sink_vec)
+namespace
+{
+void ensure_vector_sizes(
+    const audio_vector& src_vec, audio_vector& sink_vec,
+    const audio_channel::allocator_type& alloc)
 {
   const auto src_chans = src_vec.size();
   const auto sink_chans = sink_vec.size();
   if(sink_chans < src_chans)
-    audio_buffer_pool::set_channels(sink_vec, src_chans);
+    audio_buffer_pool::set_channels(sink_vec, src_chans, alloc);
 
   for(std::size_t chan = 0; chan < src_chans; chan++)
   {
@@ -140,12 +145,14 @@ void ensure_vector_sizes(const audio_vector& src_vec, audio_vector& sink_vec)
   }
 }
 
-void mix(const audio_vector& src_vec, audio_vector& sink_vec)
+void mix(
+    const audio_vector& src_vec, audio_vector& sink_vec,
+    const audio_channel::allocator_type& alloc)
 {
   if(BOOST_UNLIKELY(src_vec.size() != 0 && sink_vec.size() == 0))
   {
     const auto channels = src_vec.size();
-    audio_buffer_pool::set_channels(sink_vec, channels);
+    audio_buffer_pool::set_channels(sink_vec, channels, alloc);
     for(std::size_t c = 0; c < channels; c++)
     {
       sink_vec[c] = src_vec[c];
@@ -154,6 +161,7 @@ void mix(const audio_vector& src_vec, audio_vector& sink_vec)
   }
   else if(BOOST_LIKELY(src_vec.size() == sink_vec.size()))
   {
+    const auto& k = audio_kernels();
     for(std::size_t chan = 0, src_chans = src_vec.size(); chan < src_chans; chan++)
     {
       auto& src = src_vec[chan];
@@ -171,32 +179,48 @@ void mix(const audio_vector& src_vec, audio_vector& sink_vec)
           sink.resize(N);
         }
 
-        auto src_p = src.data();
-        auto sink_p = sink.data();
-        for(std::size_t i = 0; i < N; i++)
-          sink_p[i] += src_p[i];
+        audio_mix(k, src.data(), sink.data(), N);
       }
     }
   }
   else
   {
-    ensure_vector_sizes(src_vec, sink_vec);
+    ensure_vector_sizes(src_vec, sink_vec, alloc);
     // Just copy the channels without much thoughts
+    const auto& k = audio_kernels();
     for(std::size_t chan = 0, src_chans = src_vec.size(); chan < src_chans; chan++)
     {
       auto& src = src_vec[chan];
-      auto& sink = sink_vec[chan];
-      const std::size_t N = src.size();
-      auto src_p = src.data();
-      auto sink_p = sink.data();
-
-      for(std::size_t i = 0; i < N; i++)
-        sink_p[i] += src_p[i];
+      audio_mix(k, src.data(), sink_vec[chan].data(), src.size());
     }
   }
 }
 
-void audio_buffer_pool::set_channels(audio_vector& samples, std::size_t channels)
+}
+
+void ensure_vector_sizes(const audio_vector& src_vec, audio_vector& sink_vec)
+{
+  ensure_vector_sizes(src_vec, sink_vec, {});
+}
+
+void ensure_vector_sizes(const audio_vector& src_vec, audio_port& sink)
+{
+  ensure_vector_sizes(src_vec, sink.get(), sink.get_allocator());
+}
+
+void mix(const audio_vector& src_vec, audio_vector& sink_vec)
+{
+  mix(src_vec, sink_vec, {});
+}
+
+void mix(const audio_vector& src_vec, audio_port& sink)
+{
+  mix(src_vec, sink.get(), sink.get_allocator());
+}
+
+void audio_buffer_pool::set_channels(
+    audio_vector& samples, std::size_t channels,
+    const audio_channel::allocator_type& alloc)
 {
   if(samples.size() == channels)
     return;
@@ -204,16 +228,25 @@ void audio_buffer_pool::set_channels(audio_vector& samples, std::size_t channels
   auto& pool = audio_buffer_pool::instance();
   while(samples.size() > channels)
   {
-    auto chan = std::move(samples.back());
-    chan.clear();
-    pool.release(std::move(chan));
+    auto& chan = samples.back();
+    if(!chan.get_stored_allocator().arena())
+    {
+      chan.clear();
+      pool.release(std::move(chan));
+    }
     samples.pop_back();
   }
 
   samples.reserve(channels);
-  while(samples.size() < channels)
+  if(alloc.arena())
   {
-    samples.push_back(pool.acquire());
+    while(samples.size() < channels)
+      samples.emplace_back(alloc);
+  }
+  else
+  {
+    while(samples.size() < channels)
+      samples.push_back(pool.acquire());
   }
 }
 
@@ -227,16 +260,16 @@ void value_port::write_value(const value& v, int64_t timestamp)
       });
       if(it != data.end())
       {
-        it->value = v;
+        pool.assign(it->value, v);
       }
       else
       {
-        data.emplace_back(v);
+        data.emplace_back(pool.copy(v), timestamp);
       }
       break;
     }
     case data_mix_method::mix_append: {
-      this->data.emplace_back(v);
+      this->data.emplace_back(pool.copy(v), timestamp);
       break;
     }
     case data_mix_method::mix_merge: {
@@ -256,16 +289,17 @@ void value_port::write_value(value&& v, int64_t timestamp)
       });
       if(it != data.end())
       {
+        pool.recycle(it->value);
         it->value = std::move(v);
       }
       else
       {
-        data.emplace_back(std::move(v));
+        data.emplace_back(std::move(v), timestamp);
       }
       break;
     }
     case data_mix_method::mix_append: {
-      this->data.emplace_back(std::move(v));
+      this->data.emplace_back(std::move(v), timestamp);
       break;
     }
     case data_mix_method::mix_merge: {
@@ -297,9 +331,9 @@ void value_port::add_local_value(const ossia::typed_value& other)
   }
   else
   {
-    auto v = other.value;
+    auto v = pool.copy(other.value);
     filter_value(v, other.index, index, other.type, type);
-    write_value(v, other.timestamp);
+    write_value(std::move(v), other.timestamp);
   }
 }
 
@@ -312,8 +346,9 @@ void value_port::add_global_values(
   {
     if(other.get_domain() && this->domain)
     {
-      for(ossia::value v : vec)
+      for(const ossia::value& val : vec)
       {
+        auto v = pool.copy(val);
         map_value(v, index, other.get_domain(), this->domain);
         write_value(std::move(v), 0); // TODO put correct timestamps here
       }
@@ -330,8 +365,9 @@ void value_port::add_global_values(
   {
     if(other.get_domain() && this->domain)
     {
-      for(ossia::value v : vec)
+      for(const ossia::value& val : vec)
       {
+        auto v = pool.copy(val);
         filter_value(v, {}, index, source_type, type);
         map_value(v, index, other.get_domain(), this->domain);
         write_value(std::move(v), 0);
@@ -339,10 +375,11 @@ void value_port::add_global_values(
     }
     else
     {
-      for(ossia::value v : vec)
+      for(const ossia::value& val : vec)
       {
+        auto v = pool.copy(val);
         filter_value(v, {}, index, source_type, type);
-        write_value(v, 0);
+        write_value(std::move(v), 0);
       }
     }
   }
@@ -388,22 +425,22 @@ void value_port::add_port_values(const value_port& other)
           });
           if(it != data.end())
           {
-            it->value = v.value;
+            pool.assign(it->value, v.value);
             process_control_value(it->value, other, *this);
           }
           else
           {
-            data.emplace_back(v);
+            data.emplace_back(pool.copy(v.value), v.timestamp);
             process_control_value(data.back().value, other, *this);
           }
         }
         break;
       }
       case data_mix_method::mix_append: {
-        auto it = data.insert(data.end(), other.data.begin(), other.data.end());
-        for(const auto end = data.end(); it != end; ++it)
+        for(const auto& v : other.data)
         {
-          process_control_value(it->value, other, *this);
+          data.emplace_back(pool.copy(v.value), v.timestamp);
+          process_control_value(data.back().value, other, *this);
         }
         break;
       }
@@ -425,17 +462,18 @@ void value_port::add_port_values(const value_port& other)
           });
           if(it != data.end())
           {
-            it->value = v.value;
+            pool.assign(it->value, v.value);
           }
           else
           {
-            data.emplace_back(v);
+            data.emplace_back(pool.copy(v.value), v.timestamp);
           }
         }
         break;
       }
       case data_mix_method::mix_append: {
-        data.insert(data.end(), other.data.begin(), other.data.end());
+        for(const auto& v : other.data)
+          data.emplace_back(pool.copy(v.value), v.timestamp);
         break;
       }
       case data_mix_method::mix_merge: {
@@ -448,11 +486,16 @@ void value_port::add_port_values(const value_port& other)
 
 void value_port::set_data(const value_vector<ossia::timed_value>& vec)
 {
-  data = vec;
+  clear();
+  data.reserve(vec.size());
+  for(const auto& v : vec)
+    data.emplace_back(pool.copy(v.value), v.timestamp);
 }
 
 void value_port::clear()
 {
+  for(auto& v : data)
+    pool.recycle(v.value);
   data.clear();
 }
 
@@ -130,7 +130,7 @@ struct copy_data
   void operator()(const audio_port& out, audio_port& in)
   {
     // Called in init_node_visitor::copy, when copying from a node to another
-    mix(out.get(), in.get());
+    mix(out.get(), in);
   }
 
   /// MIDI ///
@@ -199,7 +199,7 @@ struct copy_data_pos
   {
     if(pos < out.samples.size())
     {
-      mix(out.samples[pos], in.get());
+      mix(out.samples[pos], in);
     }
   }
 
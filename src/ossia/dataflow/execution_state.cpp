@@ -20,8 +20,333 @@
 #include <ossia/protocols/midi/midi_device.hpp>
 #include <ossia/protocols/midi/midi_protocol.hpp>
 
+#if defined(OSSIA_PARALLEL)
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#endif
+
 namespace ossia
 {
+#if defined(OSSIA_PARALLEL)
+namespace
+{
+//! Something written to the execution state by a node running in parallel
+template <typename Param, typename T>
+struct parallel_write
+{
+  using param_type = Param;
+
+  std::atomic<parallel_write*> next{};
+  Param* param{};
+  int order{};
+  int seq{};
+  bool replace{};
+  T data{};
+
+  static bool less(const parallel_write* lhs, const parallel_write* rhs) noexcept
+  {
+    return std::tie(lhs->order, lhs->seq) < std::tie(rhs->order, rhs->seq);
+  }
+};
+
+/**
+ * Copy of the channels of an audio port.
+ *
+ * Its buffers are kept from one tick to the next, as well as the channels
+ * of wider ports written before: once the largest port has been seen,
+ * copying a port into it does not allocate.
+ */
+struct parallel_audio_data
+{
+  ossia::audio_vector samples;
+  ossia::audio_vector spare;
+
+  parallel_audio_data& operator=(const ossia::audio_port& port)
+  {
+    const std::size_t channels = port.channels();
+    while(samples.size() > channels)
+    {
+      spare.push_back(std::move(samples.back()));
+      samples.pop_back();
+    }
+    while(samples.size() < channels)
+    {
+      if(spare.empty())
+      {
+        samples.emplace_back();
+      }
+      else
+      {
+        samples.push_back(std::move(spare.back()));
+        spare.pop_back();
+      }
+    }
+
+    for(std::size_t c = 0; c < channels; c++)
+      samples[c].assign(port.channel(c).begin(), port.channel(c).end());
+    return *this;
+  }
+};
+
+using parallel_value_write = parallel_write<ossia::net::parameter_base, ossia::typed_value>;
+using parallel_audio_write = parallel_write<ossia::audio_parameter, parallel_audio_data>;
+using parallel_midi_write
+    = parallel_write<ossia::net::parameter_base, value_vector<libremidi::message>>;
+
+//! Writes of a single thread. Addresses are stable, and entries are reused across ticks.
+template <typename Write>
+struct parallel_write_arena
+{
+  std::deque<Write> writes;
+  std::size_t used{};
+
+  Write& allocate()
+  {
+    if(used == writes.size())
+      writes.emplace_back();
+    Write& w = writes[used++];
+    w.next.store(nullptr, std::memory_order_relaxed);
+    return w;
+  }
+
+  void clear() noexcept { used = 0; }
+};
+
+/**
+ * Lock-free multimap from parameters to the writes made to them during a tick,
+ * so that nodes can read the local state while other nodes write to it.
+ *
+ * Slots are only claimed while the graph runs, and released all at once
+ * when the writes are merged. When the table is full, writes go to an
+ * overflow list and the table is grown before the next tick.
+ */
+template <typename Write>
+class parallel_write_index
+{
+public:
+  using param_type = typename Write::param_type;
+
+  explicit parallel_write_index(std::size_t capacity) { allocate(capacity); }
+
+  void push(Write& w) noexcept
+  {
+    const std::size_t start = hash(w.param);
+    for(std::size_t i = 0; i <= m_mask; i++)
+    {
+      auto& slot = m_slots[(start + i) & m_mask];
+      param_type* key = slot.key.load(std::memory_order_acquire);
+      if(!key)
+      {
+        if(slot.key.compare_exchange_strong(
+               key, w.param, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+          m_claimed.fetch_add(1, std::memory_order_relaxed);
+          key = w.param;
+        }
+      }
+
+      if(key == w.param)
+      {
+        push_front(slot.head, w);
+        return;
+      }
+    }
+
+    m_overflowed.store(true, std::memory_order_relaxed);
+    push_front(m_overflow, w);
+  }
+
+  template <typename F>
+  void for_each(const param_type* p, F&& f) const noexcept
+  {
+    const std::size_t start = hash(p);
+    for(std::size_t i = 0; i <= m_mask; i++)
+    {
+      auto& slot = m_slots[(start + i) & m_mask];
+      const param_type* key = slot.key.load(std::memory_order_acquire);
+      if(!key)
+        break;
+      if(key == p)
+      {
+        for(auto w = slot.head.load(std::memory_order_acquire); w;
+            w = w->next.load(std::memory_order_relaxed))
+          f(*w);
+        break;
+      }
+    }
+
+    if(m_overflowed.load(std::memory_order_acquire))
+    {
+      for(auto w = m_overflow.load(std::memory_order_acquire); w;
+          w = w->next.load(std::memory_order_relaxed))
+        if(w->param == p)
+          f(*w);
+    }
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_claimed.load(std::memory_order_relaxed) == 0
+           && !m_overflowed.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] bool contains(const param_type* p) const noexcept
+  {
+    bool found = false;
+    for_each(p, [&](const Write&) { found = true; });
+    return found;
+  }
+
+  //! Not thread-safe: called between two executions of the graph
+  void clear()
+  {
+    const std::size_t claimed = m_claimed.load(std::memory_order_relaxed);
+    if(m_overflowed.load(std::memory_order_relaxed) || 2 * claimed > m_mask + 1)
+    {
+      allocate(std::max(2 * (m_mask + 1), 4 * claimed));
+    }
+    else if(claimed > 0)
+    {
+      for(std::size_t i = 0; i <= m_mask; i++)
+      {
+        m_slots[i].key.store(nullptr, std::memory_order_relaxed);
+        m_slots[i].head.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    m_claimed.store(0, std::memory_order_relaxed);
+    m_overflow.store(nullptr, std::memory_order_relaxed);
+    m_overflowed.store(false, std::memory_order_relaxed);
+  }
+
+private:
+  struct slot
+  {
+    std::atomic<param_type*> key{};
+    std::atomic<Write*> head{};
+  };
+
+  static void push_front(std::atomic<Write*>& head, Write& w) noexcept
+  {
+    Write* cur = head.load(std::memory_order_relaxed);
+    do
+    {
+      w.next.store(cur, std::memory_order_relaxed);
+    } while(!head.compare_exchange_weak(
+        cur, &w, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  std::size_t hash(const param_type* p) const noexcept
+  {
+    const auto h = uint64_t(reinterpret_cast<uintptr_t>(p)) * 0x9E3779B97F4A7C15ull;
+    return std::size_t(h >> 32) & m_mask;
+  }
+
+  void allocate(std::size_t capacity)
+  {
+    std::size_t n = 16;
+    while(n < capacity)
+      n *= 2;
+    m_slots = std::make_unique<slot[]>(n);
+    m_mask = n - 1;
+  }
+
+  std::unique_ptr<slot[]> m_slots;
+  std::size_t m_mask{};
+  std::atomic_size_t m_claimed{};
+  std::atomic<Write*> m_overflow{};
+  std::atomic_bool m_overflowed{};
+};
+
+struct parallel_worker
+{
+  std::thread::id thread;
+  parallel_write_arena<parallel_value_write> values;
+  parallel_write_arena<parallel_audio_write> audio;
+  parallel_write_arena<parallel_midi_write> midi;
+
+  // Scratch buffers for reading the local state
+  std::vector<const parallel_value_write*> value_reads;
+  std::vector<const parallel_audio_write*> audio_reads;
+  std::vector<const parallel_midi_write*> midi_reads;
+  std::vector<const ossia::typed_value*> merged_values;
+};
+
+std::atomic_uint64_t g_parallel_state_id{};
+}
+
+struct execution_state::parallel_state
+{
+  const uint64_t id = ++g_parallel_state_id;
+
+  parallel_write_index<parallel_value_write> values{256};
+  parallel_write_index<parallel_audio_write> audio{64};
+  parallel_write_index<parallel_midi_write> midi{64};
+
+  std::mutex workers_mutex;
+  std::vector<std::unique_ptr<parallel_worker>> workers;
+
+  std::vector<parallel_value_write*> merge_values;
+  std::vector<parallel_audio_write*> merge_audio;
+  std::vector<parallel_midi_write*> merge_midi;
+
+  parallel_worker& find_worker()
+  {
+    const auto tid = std::this_thread::get_id();
+    std::lock_guard _{workers_mutex};
+    for(auto& w : workers)
+      if(w->thread == tid)
+        return *w;
+
+    auto& w = workers.emplace_back(std::make_unique<parallel_worker>());
+    w->thread = tid;
+    return *w;
+  }
+
+  void clear()
+  {
+    for(auto& w : workers)
+    {
+      w->values.clear();
+      w->audio.clear();
+      w->midi.clear();
+    }
+    values.clear();
+    audio.clear();
+    midi.clear();
+  }
+};
+
+namespace
+{
+//! Set for the duration of a node by execution_state::begin_parallel_node
+struct parallel_writer
+{
+  execution_state* state{};
+  parallel_worker* worker{};
+  uint64_t state_id{};
+  int order{};
+  int seq{};
+};
+
+thread_local parallel_writer g_parallel_writer;
+
+// Writes made to a parameter so far, in execution order
+template <typename Write>
+bool sorted_reads(
+    const parallel_write_index<Write>& index, const typename Write::param_type* p,
+    std::vector<const Write*>& out)
+{
+  out.clear();
+  index.for_each(p, [&](const Write& w) { out.push_back(&w); });
+  std::sort(out.begin(), out.end(), Write::less);
+  return !out.empty();
+}
+}
+#endif
+
 struct local_pull_visitor
 {
   execution_state& st;
@@ -30,6 +355,36 @@ struct local_pull_visitor
   {
     OSSIA_EXEC_STATE_LOCK_READ(st);
     auto it = st.m_valueState.find(addr);
+#if defined(OSSIA_PARALLEL)
+    if(!st.m_parallel->values.empty())
+    {
+      auto& w = worker();
+      if(sorted_reads(st.m_parallel->values, addr, w.value_reads))
+      {
+        // Apply the writes of the parallel nodes as insert() would have done
+        auto& merged = w.merged_values;
+        merged.clear();
+        if(it != st.m_valueState.end())
+          for(auto& v : it->second)
+            merged.push_back(&v.first);
+
+        for(auto write : w.value_reads)
+        {
+          auto same = write->replace ? ossia::find_if(merged, [=](auto v) {
+            return v->timestamp == write->data.timestamp;
+          }) : merged.end();
+          if(same != merged.end())
+            *same = &write->data;
+          else
+            merged.push_back(&write->data);
+        }
+
+        for(auto v : merged)
+          val.add_local_value(*v);
+        return true;
+      }
+    }
+#endif
     if(it != st.m_valueState.end() && !it->second.empty())
     {
       copy_data{}(it->second, val);
@@ -41,25 +396,52 @@ struct local_pull_visitor
   bool operator()(audio_port& val) const
   {
     OSSIA_EXEC_STATE_LOCK_READ(st);
-    auto it = st.m_audioState.find(static_cast<ossia::audio_parameter*>(addr));
+    bool found = false;
+    auto param = static_cast<ossia::audio_parameter*>(addr);
+    auto it = st.m_audioState.find(param);
     if(it != st.m_audioState.end() && !it->second.empty())
     {
       copy_data{}(it->second, val);
-      return true;
+      found = true;
     }
-    return false;
+#if defined(OSSIA_PARALLEL)
+    if(!st.m_parallel->audio.empty())
+    {
+      auto& w = worker();
+      if(sorted_reads(st.m_parallel->audio, param, w.audio_reads))
+      {
+        for(auto write : w.audio_reads)
+          mix(write->data.samples, val);
+        found = true;
+      }
+    }
+#endif
+    return found;
   }
 
   bool operator()(midi_port& val) const
   {
     OSSIA_EXEC_STATE_LOCK_READ(st);
+    bool found = false;
     auto it = st.m_midiState.find(addr);
     if(it != st.m_midiState.end() && !it->second.empty())
     {
       copy_data{}(it->second, val);
-      return true;
+      found = true;
     }
-    return false;
+#if defined(OSSIA_PARALLEL)
+    if(!st.m_parallel->midi.empty())
+    {
+      auto& w = worker();
+      if(sorted_reads(st.m_parallel->midi, addr, w.midi_reads))
+      {
+        for(auto write : w.midi_reads)
+          copy_data{}(write->data, val);
+        found = true;
+      }
+    }
+#endif
+    return found;
   }
 
   [[noreturn]] bool operator()(geometry_port& val) const
@@ -69,6 +451,16 @@ struct local_pull_visitor
   }
 
   bool operator()() const { return false; }
+
+#if defined(OSSIA_PARALLEL)
+  // Scratch buffers of the calling thread
+  parallel_worker& worker() const
+  {
+    if(auto& writer = g_parallel_writer; writer.state == &st)
+      return *writer.worker;
+    return st.m_parallel->find_worker();
+  }
+#endif
 };
 
 struct global_pull_visitor
@@ -209,6 +601,9 @@ void execution_state::clear_devices()
 }
 
 execution_state::execution_state()
+#if defined(OSSIA_PARALLEL)
+    : m_parallel{std::make_unique<parallel_state>()}
+#endif
 {
   m_valueState.reserve(100);
   m_audioState.reserve(8);
@@ -294,9 +689,10 @@ void execution_state::get_new_values()
 
   for(auto& mq : m_valueQueues)
   {
-    ossia::received_value recv;
-    while(mq.try_dequeue(recv))
-      m_receivedValues[recv.address].push_back(recv.value);
+    mq.set_coalesce(coalesce_received_values);
+    mq.drain([this](ossia::received_value&& recv) {
+      m_receivedValues[recv.address].push_back(std::move(recv.value));
+    });
   }
 
   for(auto it = m_receivedMidi.begin(), end = m_receivedMidi.end(); it != end; ++it)
@@ -306,8 +702,55 @@ void execution_state::get_new_values()
   }
 }
 
+void execution_state::acquire_parameter_slots(const ossia::destination_t& address)
+{
+  if(auto addr = address.target<ossia::net::parameter_base*>())
+  {
+    m_parameterSlots.acquire(*addr);
+  }
+  else if(auto p = address.target<ossia::traversal::path>())
+  {
+    std::vector<ossia::net::node_base*> roots{};
+
+    for(auto n : m_devices_exec)
+      roots.push_back(&n->get_root_node());
+
+    ossia::traversal::apply(*p, roots);
+    for(auto n : roots)
+      if(auto param = n->get_parameter())
+        m_parameterSlots.acquire(param);
+  }
+  else
+  {
+    return;
+  }
+
+  m_valueState.reserve_slots();
+}
+
+void execution_state::release_parameter_slots(const ossia::destination_t& address)
+{
+  if(auto addr = address.target<ossia::net::parameter_base*>())
+  {
+    m_parameterSlots.release(*addr);
+  }
+  else if(auto p = address.target<ossia::traversal::path>())
+  {
+    std::vector<ossia::net::node_base*> roots{};
+
+    for(auto n : m_devices_exec)
+      roots.push_back(&n->get_root_node());
+
+    ossia::traversal::apply(*p, roots);
+    for(auto n : roots)
+      if(auto param = n->get_parameter())
+        m_parameterSlots.release(param);
+  }
+}
+
 void execution_state::register_port(const inlet& port)
 {
+  acquire_parameter_slots(port.address);
   if(auto vp = port.target<ossia::value_port>())
   {
     if(vp->is_event)
@@ -353,11 +796,12 @@ void execution_state::register_port(const inlet& port)
 
 void execution_state::register_port(const outlet& port)
 {
-  // nothing to do
+  acquire_parameter_slots(port.address);
 }
 
 void execution_state::unregister_port(const inlet& port)
 {
+  release_parameter_slots(port.address);
   if(auto vp = port.target<ossia::value_port>())
   {
     if(vp->is_event)
@@ -403,7 +847,7 @@ void execution_state::unregister_port(const inlet& port)
 
 void execution_state::unregister_port(const outlet& port)
 {
-  // nothing to do
+  release_parameter_slots(port.address);
 }
 
 void execution_state::apply_device_changes()
@@ -482,6 +926,9 @@ void execution_state::apply_device_changes()
 }
 void execution_state::begin_tick()
 {
+  for(auto dev : m_devices_exec)
+    dev->get_protocol().begin_tick();
+
   clear_local_state();
   get_new_values();
   apply_device_changes();
@@ -505,9 +952,16 @@ void execution_state::reset()
   // TODO unregister everything ?
   clear_local_state();
   clear_devices();
+#if defined(OSSIA_PARALLEL)
+  m_parallel->clear();
+#endif
   m_valueQueues.clear();
   m_receivedValues.clear();
   m_receivedMidi.clear();
+  m_valueState.clear();
+  m_audioState.clear();
+  m_midiState.clear();
+  m_parameterSlots.clear();
 }
 
 ossia::message to_state_element(ossia::net::parameter_base& p, ossia::typed_value&& v)
@@ -558,6 +1012,12 @@ void execution_state::commit_common()
       elt.second.clear();
     }
   }
+
+  m_audioState.reset_written();
+  m_midiState.reset_written();
+
+  for(auto dev : m_devices_exec)
+    dev->get_protocol().flush_output();
 }
 
 void execution_state::advance_tick(std::size_t t)
@@ -590,6 +1050,8 @@ void execution_state::advance_tick(std::size_t t)
 
 void execution_state::commit_merged()
 {
+  merge_parallel_state();
+
   // int i = 0;
   for(auto it = m_valueState.begin(), end = m_valueState.end(); it != end; ++it)
   {
@@ -618,11 +1080,14 @@ void execution_state::commit_merged()
   }
   // std::cout << "NUM MESSAGES: " << i << std::endl;
 
+  m_valueState.reset_written();
   commit_common();
 }
 
 void execution_state::commit()
 {
+  merge_parallel_state();
+
   state_flatten_visitor<ossia::flat_vec_state, false, true> vis{m_commitOrderedState};
   for(auto it = m_valueState.begin(), end = m_valueState.end(); it != end; ++it)
   {
@@ -651,11 +1116,14 @@ void execution_state::commit()
     vec.clear();
   }
 
+  m_valueState.reset_written();
   commit_common();
 }
 
 void execution_state::commit_priorized()
 {
+  merge_parallel_state();
+
   // Here we use the priority of each node
   ossia::flat_map<
       std::tuple<ossia::net::priority, int64_t, int>, std::vector<ossia::state_element>>
@@ -694,11 +1162,14 @@ void execution_state::commit_priorized()
     vec.second.clear();
   }
 
+  m_valueState.reset_written();
   commit_common();
 }
 
 void execution_state::commit_ordered()
 {
+  merge_parallel_state();
+
   // TODO same for midi
   // m_flatMessagesCache.reserve(m_valueState.size());
   for(auto it = m_valueState.begin(), end = m_valueState.end(); it != end; ++it)
@@ -731,6 +1202,7 @@ void execution_state::commit_ordered()
     vec.second.clear();
   }
 
+  m_valueState.reset_written();
   commit_common();
 }
 
@@ -847,8 +1319,120 @@ def_case:
   return ossia::typed_value{std::move(v), val.index, val.type};
 }
 
+#if defined(OSSIA_PARALLEL)
+void execution_state::begin_parallel_node(int order) noexcept
+{
+  auto& writer = g_parallel_writer;
+  if(writer.state_id != m_parallel->id)
+  {
+    writer.worker = &m_parallel->find_worker();
+    writer.state_id = m_parallel->id;
+  }
+  writer.state = this;
+  writer.order = order;
+  writer.seq = 0;
+}
+
+void execution_state::end_parallel_node() noexcept
+{
+  g_parallel_writer.state = nullptr;
+}
+
+template <typename Write>
+static void parallel_insert(
+    parallel_write_arena<Write>& arena, parallel_write_index<Write>& index,
+    typename Write::param_type& param, parallel_writer& writer, auto&& data,
+    bool replace = false)
+{
+  Write& w = arena.allocate();
+  w.param = &param;
+  w.order = writer.order;
+  w.seq = writer.seq++;
+  w.replace = replace;
+  w.data = std::forward<decltype(data)>(data);
+  index.push(w);
+}
+
+static parallel_writer* current_parallel_writer(const execution_state& st) noexcept
+{
+  auto& writer = g_parallel_writer;
+  return writer.state == &st ? &writer : nullptr;
+}
+
+void execution_state::merge_parallel_state()
+{
+  auto& p = *m_parallel;
+  if(p.values.empty() && p.audio.empty() && p.midi.empty())
+    return;
+
+  // Sort everything in the order of a serial execution of the graph
+  auto gather = [&](auto& merged, auto member) {
+    merged.clear();
+    for(auto& w : p.workers)
+    {
+      auto& arena = (*w).*member;
+      for(std::size_t i = 0; i < arena.used; i++)
+        merged.push_back(&arena.writes[i]);
+      arena.clear();
+    }
+    std::sort(merged.begin(), merged.end(), [](auto lhs, auto rhs) {
+      return std::remove_pointer_t<decltype(lhs)>::less(lhs, rhs);
+    });
+  };
+
+  gather(p.merge_values, &parallel_worker::values);
+  for(auto w : p.merge_values)
+  {
+    auto& st = m_valueState[w->param];
+    auto it = w->replace ? ossia::find_if(st, [=](const std::pair<typed_value, int>& v) {
+      return v.first.timestamp == w->data.timestamp;
+    }) : st.end();
+    if(it != st.end())
+      it->first = std::move(w->data);
+    else
+      st.emplace_back(std::move(w->data), m_msgIndex);
+    m_msgIndex++;
+  }
+
+  gather(p.merge_audio, &parallel_worker::audio);
+  for(auto w : p.merge_audio)
+    mix(w->data.samples, m_audioState[w->param]);
+
+  // The messages are not cleared: the next copies reuse their storage
+  gather(p.merge_midi, &parallel_worker::midi);
+  for(auto w : p.merge_midi)
+  {
+    auto& vec = m_midiState[w->param];
+    vec.insert(vec.end(), w->data.begin(), w->data.end());
+  }
+
+  p.values.clear();
+  p.audio.clear();
+  p.midi.clear();
+}
+#else
+void execution_state::begin_parallel_node(int) noexcept { }
+void execution_state::end_parallel_node() noexcept { }
+void execution_state::merge_parallel_state() { }
+#endif
+
 void execution_state::insert(ossia::net::parameter_base& param, const value_port& val)
 {
+#if defined(OSSIA_PARALLEL)
+  if(auto writer = current_parallel_writer(*this))
+  {
+    auto& arena = writer->worker->values;
+    const bool replace = val.mix_method == ossia::data_mix_method::mix_replace;
+    if(replace || val.mix_method == ossia::data_mix_method::mix_append)
+    {
+      for(const ossia::timed_value& v : val.get_data())
+        parallel_insert(
+            arena, m_parallel->values, param, *writer, map_value_to_param(param, v, val),
+            replace);
+    }
+    return;
+  }
+#endif
   OSSIA_EXEC_STATE_LOCK_WRITE(*this);
   int idx = m_msgIndex;
   auto& st = m_valueState[&param];
@@ -892,6 +1476,21 @@ void execution_state::insert(ossia::net::parameter_base& param, const value_port
 
 void execution_state::insert(ossia::net::parameter_base& param, value_port&& val)
 {
+#if defined(OSSIA_PARALLEL)
+  if(auto writer = current_parallel_writer(*this))
+  {
+    auto& arena = writer->worker->values;
+    const bool replace = val.mix_method == ossia::data_mix_method::mix_replace;
+    if(replace || val.mix_method == ossia::data_mix_method::mix_append)
+    {
+      for(ossia::timed_value& v : val.get_data())
+        parallel_insert(
+            arena, m_parallel->values, param, *writer,
+            map_value_to_param(param, std::move(v), val), replace);
+    }
+    return;
+  }
+#endif
   OSSIA_EXEC_STATE_LOCK_WRITE(*this);
   int idx = m_msgIndex;
   auto& st = m_valueState[&param];
@@ -930,25 +1529,55 @@ void execution_state::insert(ossia::net::parameter_base& param, value_port&& val
 
 void execution_state::insert(ossia::net::parameter_base& param, const typed_value& v)
 {
+#if defined(OSSIA_PARALLEL)
+  if(auto writer = current_parallel_writer(*this))
+  {
+    parallel_insert(writer->worker->values, m_parallel->values, param, *writer, v);
+    return;
+  }
+#endif
   OSSIA_EXEC_STATE_LOCK_WRITE(*this);
   m_valueState[&param].emplace_back(v, m_msgIndex++);
 }
 void execution_state::insert(ossia::net::parameter_base& param, typed_value&& v)
 {
+#if defined(OSSIA_PARALLEL)
+  if(auto writer = current_parallel_writer(*this))
+  {
+    parallel_insert(
+        writer->worker->values, m_parallel->values, param, *writer, std::move(v));
+    return;
+  }
+#endif
   OSSIA_EXEC_STATE_LOCK_WRITE(*this);
   m_valueState[&param].emplace_back(std::move(v), m_msgIndex++);
 }
 
 void execution_state::insert(ossia::audio_parameter& param, const audio_port& v)
 {
+#if defined(OSSIA_PARALLEL)
+  if(auto writer = current_parallel_writer(*this))
+  {
+    parallel_insert(writer->worker->audio, m_parallel->audio, param, *writer, v);
+    return;
+  }
+#endif
   OSSIA_EXEC_STATE_LOCK_WRITE(*this);
-  mix(v.get(), m_audioState[&param].get());
+  mix(v.get(), m_audioState[&param]);
 }
 
 void execution_state::insert(ossia::net::parameter_base& param, const midi_port& v)
 {
   if(!v.messages.empty())
   {
+#if defined(OSSIA_PARALLEL)
+    if(auto writer = current_parallel_writer(*this))
+    {
+      parallel_insert(
+          writer->worker->midi, m_parallel->midi, param, *writer, v.messages);
+      return;
+    }
+#endif
     OSSIA_EXEC_STATE_LOCK_WRITE(*this);
     auto& vec = m_midiState[&param];
     vec.insert(vec.end(), v.messages.begin(), v.messages.end());
@@ -966,10 +1595,9 @@ struct state_exec_visitor
 
   void operator()(const ossia::message& msg)
   {
-    OSSIA_EXEC_STATE_LOCK_WRITE(e);
-    e.m_valueState[&msg.dest.address()].emplace_back(
-        ossia::typed_value{msg.message_value, msg.dest.index, msg.dest.unit},
-        e.m_msgIndex++);
+    e.insert(
+        msg.dest.address(),
+        ossia::typed_value{msg.message_value, msg.dest.index, msg.dest.unit});
   }
 
   template <std::size_t N>
@@ -984,46 +1612,29 @@ struct state_exec_visitor
 
 void execution_state::insert(const ossia::state& v)
 {
-  OSSIA_EXEC_STATE_LOCK_WRITE(*this);
   for(auto& msg : v)
   {
     ossia::apply(state_exec_visitor{*this}, msg);
   }
 }
 
-static bool is_in(
-    net::parameter_base& other,
-    const ossia::fast_hash_map<
-        ossia::net::parameter_base*, value_vector<std::pair<typed_value, int>>>&
-        container)
+template <typename Param, typename T>
+static bool
+is_in(net::parameter_base& other, const ossia::parameter_slot_map<Param, T>& container)
 {
-  auto it = container.find(&other);
-  if(it == container.end())
-    return false;
-  return !it->second.empty();
-}
-static bool is_in(
-    net::parameter_base& other,
-    const ossia::fast_hash_map<
-        ossia::net::parameter_base*, value_vector<libremidi::message>>& container)
-{
-  auto it = container.find(&other);
-  if(it == container.end())
-    return false;
-  return !it->second.empty();
-}
-static bool is_in(
-    net::parameter_base& other,
-    const ossia::fast_hash_map<ossia::audio_parameter*, audio_port>& container)
-{
-  // TODO dangerous
-  auto it = container.find(static_cast<ossia::audio_parameter*>(&other));
+  // TODO dangerous for audio parameters
+  auto it = container.find(static_cast<Param*>(&other));
   if(it == container.end())
     return false;
   return !it->second.empty();
 }
 bool execution_state::in_local_scope(net::parameter_base& other) const
 {
+#if defined(OSSIA_PARALLEL)
+  if(m_parallel->values.contains(&other) || m_parallel->midi.contains(&other)
+     || m_parallel->audio.contains(static_cast<ossia::audio_parameter*>(&other)))
+    return true;
+#endif
   OSSIA_EXEC_STATE_LOCK_READ(*this);
   return (
       is_in(other, m_valueState) || is_in(other, m_audioState)
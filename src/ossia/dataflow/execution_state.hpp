@@ -1,5 +1,6 @@
 #pragma once
 #include <ossia/dataflow/dataflow_fwd.hpp>
+#include <ossia/dataflow/parameter_slots.hpp>
 #include <ossia/dataflow/value_vector.hpp>
 #include <ossia/detail/audio_spin_mutex.hpp>
 #include <ossia/detail/flat_map.hpp>
@@ -17,6 +18,7 @@
 #endif
 
 #include <cstdint>
+#include <memory>
 #if SIZE_MAX == 0xFFFFFFFF // 32-bit
 #include <ossia/dataflow/audio_port.hpp>
 #include <ossia/dataflow/midi_port.hpp>
@@ -129,6 +131,21 @@ struct OSSIA_EXPORT execution_state : public Nano::Observer
   void insert(ossia::net::parameter_base& dest, const midi_port& v);
   void insert(const ossia::state& v);
 
+  /**
+   * Called by the parallel graph executors around the execution of a node.
+   *
+   * With OSSIA_PARALLEL, the insert() calls made by the node are then
+   * stored without locking in buffers owned by the worker thread.
+   * `order` is the position of the node in the static execution order:
+   * merge_parallel_state() uses it to merge the buffers in the same
+   * order as a serial execution would have produced.
+   */
+  void begin_parallel_node(int order) noexcept;
+  void end_parallel_node() noexcept;
+
+  //! Moves what was inserted by parallel nodes in the value / audio / midi states
+  void merge_parallel_state();
+
   bool in_local_scope(ossia::net::parameter_base& other) const;
 
   int sampleRate{44100};
@@ -139,25 +156,37 @@ struct OSSIA_EXPORT execution_state : public Nano::Observer
   double start_date{}; // in ns, for vst
   double cur_date{};
 
+  //! Event inlets only get the latest value received by a parameter since the last tick
+  bool coalesce_received_values{};
+
   // private:// disabled due to tests, but for some reason can't make friend
   // work
   // using value_state_impl = ossia::flat_multimap<int64_t,
   // std::pair<ossia::value, int>>;
-  ossia::fast_hash_map<
-      ossia::net::parameter_base*, value_vector<std::pair<typed_value, int>>>
-      m_valueState;
-  ossia::fast_hash_map<ossia::audio_parameter*, audio_port> m_audioState;
-  ossia::fast_hash_map<ossia::net::parameter_base*, value_vector<libremidi::message>>
-      m_midiState;
+  ossia::parameter_slots m_parameterSlots;
+  ossia::parameter_slot_map<
+      ossia::net::parameter_base, value_vector<std::pair<typed_value, int>>>
+      m_valueState{m_parameterSlots};
+  ossia::parameter_slot_map<ossia::audio_parameter, audio_port> m_audioState{
+      m_parameterSlots};
+  ossia::parameter_slot_map<ossia::net::parameter_base, value_vector<libremidi::message>>
+      m_midiState{m_parameterSlots};
 
   mutable ossia::audio_spin_mutex mutex;
 
 private:
+#if defined(OSSIA_PARALLEL)
+  struct parallel_state;
+  std::unique_ptr<parallel_state> m_parallel;
+#endif
+
   void get_new_values();
   void clear_local_state();
 
   void register_parameter(ossia::net::parameter_base& p);
   void unregister_parameter(ossia::net::parameter_base& p);
+  void acquire_parameter_slots(const ossia::destination_t& address);
+  void release_parameter_slots(const ossia::destination_t& address);
   void register_midi_parameter(net::midi::midi_protocol& p);
   void unregister_midi_parameter(net::midi::midi_protocol& p);
   ossia::small_vector<ossia::net::device_base*, 4> m_devices_edit;
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <ossia/dataflow/audio_kernels.hpp>
 #include <ossia/dataflow/nodes/media.hpp>
 #include <ossia/detail/math.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 
@@ -85,16 +87,69 @@ constexpr float float_to_sample<float, 32>(float sample) noexcept
 #define OSSIA_RESTRICT __restrict__
 #endif
 
+namespace detail
+{
+// Same as float_to_sample for each sample, with the SIMD kernels when possible
+template <typename SampleFormat, int N>
+inline void convert_samples(
+    const audio_kernel_table& k, const float* in, SampleFormat* out, std::size_t n)
+{
+  if constexpr(std::is_same_v<SampleFormat, int16_t> && N == 16)
+    k.float_to_s16(in, out, n);
+  else if constexpr(std::is_same_v<SampleFormat, int32_t> && N == 24)
+    k.float_to_s24(in, out, n);
+  else if constexpr(std::is_same_v<SampleFormat, int32_t> && N == 32)
+    k.float_to_s32(in, out, n);
+  else if constexpr(std::is_same_v<SampleFormat, float>)
+    std::copy_n(in, n, out);
+  else
+    for(std::size_t i = 0; i < n; i++)
+      out[i] = float_to_sample<SampleFormat, N>(in[i]);
+}
+
+// Size of the stack buffers used to interleave and convert in chunks
+static constexpr int chunk_samples = 1024;
+static constexpr int max_chunk_channels = 64;
+}
+
 template <typename SampleFormat, int N>
 inline void interleave(
     const float* const* OSSIA_RESTRICT in, SampleFormat* OSSIA_RESTRICT out,
     int channels, int bs)
 {
-  for(int c = 0; c < channels; c++)
+  if(channels <= 0)
+    return;
+
+  const auto& k = audio_kernels();
+  if constexpr(std::is_same_v<SampleFormat, float>)
+  {
+    k.interleave(in, out, channels, bs);
+  }
+  else if(channels <= detail::max_chunk_channels)
   {
-    auto* in_channel = in[c];
-    for(int k = 0; k < bs; k++)
-      out[k * channels + c] = float_to_sample<SampleFormat, N>(in_channel[k]);
+    // Interleave a chunk of frames as float on the stack, then convert it
+    alignas(32) float tmp[detail::chunk_samples];
+    const float* chunk_in[detail::max_chunk_channels];
+    const int frames = detail::chunk_samples / channels;
+    for(int pos = 0; pos < bs; pos += frames)
+    {
+      const int count = std::min(frames, bs - pos);
+      for(int c = 0; c < channels; c++)
+        chunk_in[c] = in[c] + pos;
+
+      k.interleave(chunk_in, tmp, channels, count);
+      detail::convert_samples<SampleFormat, N>(
+          k, tmp, out + pos * channels, count * channels);
+    }
+  }
+  else
+  {
+    for(int c = 0; c < channels; c++)
+    {
+      auto* in_channel = in[c];
+      for(int i = 0; i < bs; i++)
+        out[i * channels + c] = float_to_sample<SampleFormat, N>(in_channel[i]);
+    }
   }
 }
 
@@ -103,14 +158,8 @@ inline void convert(
     const float* const* OSSIA_RESTRICT in, SampleFormat* OSSIA_RESTRICT out,
     int channels, int bs)
 {
+  const auto& k = audio_kernels();
   for(int c = 0; c < channels; c++)
-  {
-    auto* in_channel = in[c];
-    auto* out_channel = out + c * bs;
-    for(int k = 0; k < bs; k++)
-    {
-      out_channel[k] = float_to_sample<SampleFormat, N>(in_channel[k]);
-    }
-  }
+    detail::convert_samples<SampleFormat, N>(k, in[c], out + c * bs, bs);
 }
 }
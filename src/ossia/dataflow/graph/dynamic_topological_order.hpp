@@ -0,0 +1,285 @@
+#pragma once
+#include <ossia/detail/small_vector.hpp>
+
+#include <boost/graph/adjacency_list.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace ossia
+{
+/**
+ * @brief Topological order maintained across graph edits.
+ *
+ * Implements the dynamic topological sort of Pearce & Kelly,
+ * "A Dynamic Topological Sort Algorithm for Directed Acyclic Graphs" (2006):
+ * inserting an edge only reorders the vertices located between its two
+ * ends in the current order; removing edges or vertices never breaks it.
+ *
+ * Vertices are indices, renumbered on removal like a vecS boost graph.
+ * An edge (before, after) means that `before` must execute before `after`.
+ * If an edit would create a cycle, the order becomes invalid
+ * and must be rebuilt from a full sort with reset().
+ */
+class dynamic_topological_order
+{
+public:
+  using vertex = std::size_t;
+
+  [[nodiscard]] bool valid() const noexcept { return m_valid; }
+  void invalidate() noexcept { m_valid = false; }
+
+  [[nodiscard]] std::size_t num_vertices() const noexcept { return m_order.size(); }
+  [[nodiscard]] std::size_t num_edges() const noexcept { return m_num_edges; }
+
+  //! Vertices, in execution order
+  [[nodiscard]] const std::vector<vertex>& order() const noexcept { return m_order; }
+
+  void clear()
+  {
+    m_succ.clear();
+    m_pred.clear();
+    m_ord.clear();
+    m_order.clear();
+    m_visited.clear();
+    m_num_edges = 0;
+    m_valid = true;
+  }
+
+  /**
+   * Rebuilds from the result of a full topological sort.
+   * The edges of `g` go from the vertex which executes after
+   * to the vertex which executes before, as in ossia::graph_t.
+   */
+  template <typename Graph, typename Order>
+  void reset(const Graph& g, const Order& topo_order)
+  {
+    clear();
+    const std::size_t N = boost::num_vertices(g);
+    m_succ.resize(N);
+    m_pred.resize(N);
+    m_ord.resize(N);
+    m_order.reserve(N);
+
+    for(auto v : topo_order)
+    {
+      m_ord[v] = m_order.size();
+      m_order.push_back(v);
+    }
+
+    for(auto [it, end] = boost::edges(g); it != end; ++it)
+    {
+      const vertex after = boost::source(*it, g);
+      const vertex before = boost::target(*it, g);
+      m_succ[before].push_back(after);
+      m_pred[after].push_back(before);
+      m_num_edges++;
+    }
+
+    m_valid = (m_order.size() == N);
+  }
+
+  //! The new vertex has index num_vertices() and executes last
+  void add_vertex()
+  {
+    const vertex v = m_order.size();
+    m_succ.emplace_back();
+    m_pred.emplace_back();
+    m_ord.push_back(v);
+    m_order.push_back(v);
+  }
+
+  void remove_vertex(vertex v)
+  {
+    if(!m_valid || v >= m_order.size())
+    {
+      m_valid = false;
+      return;
+    }
+
+    for(vertex s : m_succ[v])
+      remove_one(m_pred[s], v);
+    for(vertex p : m_pred[v])
+      remove_one(m_succ[p], v);
+    m_num_edges -= m_succ[v].size() + m_pred[v].size();
+
+    m_succ.erase(m_succ.begin() + v);
+    m_pred.erase(m_pred.begin() + v);
+
+    // Renumber the vertices after v
+    auto renumber = [v](vertex& w) {
+      if(w > v)
+        --w;
+    };
+    for(auto& adj : m_succ)
+      std::for_each(adj.begin(), adj.end(), renumber);
+    for(auto& adj : m_pred)
+      std::for_each(adj.begin(), adj.end(), renumber);
+
+    m_order.erase(m_order.begin() + m_ord[v]);
+    std::for_each(m_order.begin(), m_order.end(), renumber);
+
+    m_ord.resize(m_order.size());
+    for(std::size_t i = 0; i < m_order.size(); i++)
+      m_ord[m_order[i]] = i;
+  }
+
+  void add_edge(vertex before, vertex after)
+  {
+    if(!m_valid || before >= m_order.size() || after >= m_order.size())
+    {
+      m_valid = false;
+      return;
+    }
+
+    m_succ[before].push_back(after);
+    m_pred[after].push_back(before);
+    m_num_edges++;
+
+    const std::size_t lb = m_ord[after];
+    const std::size_t ub = m_ord[before];
+    if(ub < lb)
+      return;
+    if(before == after)
+    {
+      m_valid = false;
+      return;
+    }
+
+    // Affected region: the vertices reachable from `after`
+    // and the vertices reaching `before`, between lb and ub in the order.
+    m_visited.resize(m_order.size());
+    m_delta_f.clear();
+    m_delta_b.clear();
+    if(!dfs_forward(after, ub))
+    {
+      m_valid = false;
+      return;
+    }
+    dfs_backward(before, lb);
+
+    reorder();
+
+    for(vertex v : m_delta_f)
+      m_visited[v] = false;
+    for(vertex v : m_delta_b)
+      m_visited[v] = false;
+  }
+
+  void remove_edge(vertex before, vertex after)
+  {
+    if(!m_valid || before >= m_order.size() || after >= m_order.size())
+    {
+      m_valid = false;
+      return;
+    }
+
+    if(remove_one(m_succ[before], after) && remove_one(m_pred[after], before))
+      m_num_edges--;
+    else
+      m_valid = false;
+  }
+
+private:
+  using adjacency = ossia::small_vector<vertex, 4>;
+
+  static bool remove_one(adjacency& adj, vertex v)
+  {
+    auto it = std::find(adj.begin(), adj.end(), v);
+    if(it == adj.end())
+      return false;
+    adj.erase(it);
+    return true;
+  }
+
+  // Returns false if a cycle is found
+  bool dfs_forward(vertex start, std::size_t ub)
+  {
+    m_stack.clear();
+    m_stack.push_back(start);
+    m_visited[start] = true;
+    while(!m_stack.empty())
+    {
+      const vertex v = m_stack.back();
+      m_stack.pop_back();
+      m_delta_f.push_back(v);
+      for(vertex w : m_succ[v])
+      {
+        if(m_ord[w] == ub)
+          return false;
+        if(!m_visited[w] && m_ord[w] < ub)
+        {
+          m_visited[w] = true;
+          m_stack.push_back(w);
+        }
+      }
+    }
+    return true;
+  }
+
+  void dfs_backward(vertex start, std::size_t lb)
+  {
+    m_stack.clear();
+    m_stack.push_back(start);
+    m_visited[start] = true;
+    while(!m_stack.empty())
+    {
+      const vertex v = m_stack.back();
+      m_stack.pop_back();
+      m_delta_b.push_back(v);
+      for(vertex w : m_pred[v])
+      {
+        if(!m_visited[w] && lb < m_ord[w])
+        {
+          m_visited[w] = true;
+          m_stack.push_back(w);
+        }
+      }
+    }
+  }
+
+  void reorder()
+  {
+    auto by_order = [this](vertex a, vertex b) { return m_ord[a] < m_ord[b]; };
+    std::sort(m_delta_b.begin(), m_delta_b.end(), by_order);
+    std::sort(m_delta_f.begin(), m_delta_f.end(), by_order);
+
+    // The backward set goes first, then the forward set,
+    // in the slots that were occupied by both.
+    m_slots.clear();
+    for(vertex v : m_delta_b)
+      m_slots.push_back(m_ord[v]);
+    for(vertex v : m_delta_f)
+      m_slots.push_back(m_ord[v]);
+    std::sort(m_slots.begin(), m_slots.end());
+
+    std::size_t i = 0;
+    for(vertex v : m_delta_b)
+    {
+      m_ord[v] = m_slots[i];
+      m_order[m_slots[i]] = v;
+      i++;
+    }
+    for(vertex v : m_delta_f)
+    {
+      m_ord[v] = m_slots[i];
+      m_order[m_slots[i]] = v;
+      i++;
+    }
+  }
+
+  std::vector<adjacency> m_succ;
+  std::vector<adjacency> m_pred;
+  std::vector<std::size_t> m_ord;
+  std::vector<vertex> m_order;
+  std::size_t m_num_edges{};
+  bool m_valid{true};
+
+  // Scratch buffers for add_edge. m_visited is all false between calls.
+  std::vector<bool> m_visited;
+  std::vector<vertex> m_stack;
+  std::vector<vertex> m_delta_f;
+  std::vector<vertex> m_delta_b;
+  std::vector<std::size_t> m_slots;
+};
+}
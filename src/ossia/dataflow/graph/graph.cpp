@@ -118,7 +118,7 @@ make_graph_impl(const ossia::graph_setup_options& opt)
     }
     else // if(sched == ossia::graph_setup_options::StaticTC)
     {
-      using graph_type = graph_static<tc_update<fast_tc>, exec_t>;
+      using graph_type = graph_static<tc_update<incremental_tc>, exec_t>;
 
       auto g = std::make_shared<graph_type>();
       g->tick_fun.set_logger(opt.log);
@@ -151,43 +151,58 @@ make_graph_par_impl(const ossia::graph_setup_options& opt)
 #if defined(OSSIA_PARALLEL)
 
   auto sched = opt.scheduling;
+  auto setup = [&](auto t) -> std::shared_ptr<ossia::graph_interface> {
+    using executor_t = typename decltype(t)::type;
+    if(sched == ossia::graph_setup_options::StaticBFS)
+    {
+      using graph_type = graph_static<
+          custom_parallel_update<bfs_update, executor_t>, custom_parallel_exec>;
 
-  if(sched == ossia::graph_setup_options::StaticBFS)
-  {
-    using graph_type
-        = graph_static<custom_parallel_update<bfs_update>, custom_parallel_exec>;
+      auto g = std::make_shared<graph_type>();
 
-    auto g = std::make_shared<graph_type>();
+      g->update_fun.logger = opt.log;
+      g->update_fun.perf_map = opt.bench;
+      g->update_fun.set_num_threads(opt.parallel_threads);
+      g->update_fun.set_worker_options(opt.parallel_workers);
 
-    g->update_fun.logger = opt.log;
-    g->update_fun.perf_map = opt.bench;
+      return g;
+    }
+    else if(sched == ossia::graph_setup_options::StaticTC)
+    {
+      using graph_type = graph_static<
+          custom_parallel_update<tc_update<incremental_tc>, executor_t>,
+          custom_parallel_exec>;
 
-    return g;
-  }
-  else if(sched == ossia::graph_setup_options::StaticTC)
-  {
-    using graph_type
-        = graph_static<custom_parallel_update<tc_update<fast_tc>>, custom_parallel_exec>;
+      auto g = std::make_shared<graph_type>();
 
-    auto g = std::make_shared<graph_type>();
+      g->update_fun.logger = opt.log;
+      g->update_fun.perf_map = opt.bench;
+      g->update_fun.set_num_threads(opt.parallel_threads);
+      g->update_fun.set_worker_options(opt.parallel_workers);
 
-    g->update_fun.logger = opt.log;
-    g->update_fun.perf_map = opt.bench;
+      return g;
+    }
+    else if(sched == ossia::graph_setup_options::StaticFixed)
+    {
+      using graph_type = graph_static<
+          custom_parallel_update<simple_update, executor_t>, custom_parallel_exec>;
 
-    return g;
-  }
-  else if(sched == ossia::graph_setup_options::StaticFixed)
-  {
-    using graph_type
-        = graph_static<custom_parallel_update<simple_update>, custom_parallel_exec>;
+      auto g = std::make_shared<graph_type>();
 
-    auto g = std::make_shared<graph_type>();
+      g->update_fun.logger = opt.log;
+      g->update_fun.perf_map = opt.bench;
+      g->update_fun.set_num_threads(opt.parallel_threads);
+      g->update_fun.set_worker_options(opt.parallel_workers);
 
-    g->update_fun.logger = opt.log;
-    g->update_fun.perf_map = opt.bench;
+      return g;
+    }
+    return {};
+  };
 
-    return g;
-  }
+  if(opt.parallel_executor == ossia::graph_setup_options::WorkStealing)
+    return setup(wrap_type<ossia::work_stealing_executor>{});
+  else
+    return setup(wrap_type<ossia::executor>{});
 #endif
   return {};
 }
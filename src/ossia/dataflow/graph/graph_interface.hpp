@@ -9,6 +9,8 @@
 
 #include <smallfun.hpp>
 
+#include <vector>
+
 namespace spdlog
 {
 class logger;
@@ -60,6 +62,26 @@ public:
       node_ptr pin_node);
 };
 
+struct parallel_worker_options
+{
+  //! How idle workers wait for the next tick
+  enum
+  {
+    Park,
+    SpinThenPark,
+    Spin
+  } wake{};
+
+  //! Time spent spinning before parking, for SpinThenPark
+  int spin_us{50};
+
+  //! CPU core of each worker thread; workers past the end are not pinned
+  std::vector<int> cpu_affinity{};
+
+  //! SCHED_FIFO priority of the workers; 0 keeps the default scheduling
+  int realtime_priority{};
+};
+
 struct graph_setup_options
 {
   enum
@@ -84,6 +106,14 @@ struct graph_setup_options
   } merge{};
 
   bool parallel{};
+  enum
+  {
+    SharedQueue,
+    WorkStealing
+  } parallel_executor{};
+  int parallel_threads{8};
+  parallel_worker_options parallel_workers{};
+
   std::shared_ptr<ossia::logger_type> log{};
   std::shared_ptr<bench_map> bench{};
 };
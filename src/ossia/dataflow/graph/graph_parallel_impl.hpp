@@ -1,5 +1,7 @@
 #pragma once
+#include <ossia/dataflow/graph/graph_interface.hpp>
 #include <ossia/dataflow/graph_node.hpp>
+#include <ossia/detail/audio_spin_mutex.hpp>
 #include <ossia/detail/fmt.hpp>
 #include <ossia/detail/lockfree_queue.hpp>
 #include <ossia/detail/thread.hpp>
@@ -8,8 +10,12 @@
 
 #include <blockingconcurrentqueue.h>
 #include <concurrentqueue.h>
+#include <lightweightsemaphore.h>
 #include <smallfun.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <thread>
 #include <vector>
 #define DISABLE_DONE_TASKS
@@ -20,10 +26,44 @@
 //#define memory_order_release memory_order_seq_cst
 namespace ossia
 {
-using task_function = smallfun::function<void(ossia::graph_node&), sizeof(void*) * 4>;
+//! Called with a node and its position in the execution order of the graph
+using task_function
+    = smallfun::function<void(ossia::graph_node&, int), sizeof(void*) * 4>;
+
+inline void
+setup_worker_thread(std::thread& t, int index, const parallel_worker_options& opt)
+{
+  if(index < int(opt.cpu_affinity.size()))
+    ossia::set_thread_pinned(t, opt.cpu_affinity[index]);
+  if(opt.realtime_priority > 0)
+    ossia::set_thread_realtime(t, opt.realtime_priority);
+}
+
+//! Tracks when a worker last had something to do, for spin-then-park
+struct worker_idle_state
+{
+  using clock = std::chrono::steady_clock;
+  clock::time_point last_work = clock::now();
+
+  void on_work() noexcept { last_work = clock::now(); }
+
+  bool should_spin(const parallel_worker_options& opt) const noexcept
+  {
+    switch(opt.wake)
+    {
+      case parallel_worker_options::Spin:
+        return true;
+      case parallel_worker_options::SpinThenPark:
+        return clock::now() - last_work < std::chrono::microseconds(opt.spin_us);
+      default:
+        return false;
+    }
+  }
+};
 
 class taskflow;
 class executor;
+class work_stealing_executor;
 class task
 {
 public:
@@ -77,6 +117,7 @@ public:
 private:
   friend class taskflow;
   friend class executor;
+  friend class work_stealing_executor;
 
   int m_taskId{};
   int m_dependencies{0};
@@ -107,6 +148,7 @@ public:
 
 private:
   friend class executor;
+  friend class work_stealing_executor;
 
   std::vector<task> m_tasks;
 };
@@ -114,35 +156,28 @@ private:
 class executor
 {
 public:
-  executor()
+  explicit executor(int num_threads = 8) { start_threads(num_threads); }
+
+  ~executor() { stop_threads(); }
+
+  void set_task_executor(task_function f) { m_func = std::move(f); }
+
+  void set_num_threads(int num_threads)
   {
-    m_running = true;
-    for(auto& t : m_threads)
-    {
-      t = std::thread{[this] {
-        while(m_running)
-        {
-          task* t{};
-          if(m_tasks.wait_dequeue_timed(t, 100))
-          {
-            execute(*t);
-          }
-        }
-      }};
-    }
+    if(num_threads == int(m_threads.size()))
+      return;
+    stop_threads();
+    start_threads(num_threads);
   }
 
-  ~executor()
+  void set_worker_options(const parallel_worker_options& opt)
   {
-    m_running = false;
-    for(auto& t : m_threads)
-    {
-      t.join();
-    }
+    const int num_threads = m_threads.size();
+    stop_threads();
+    m_options = opt;
+    start_threads(num_threads);
   }
 
-  void set_task_executor(task_function f) { m_func = std::move(f); }
-
   void run(taskflow& tf)
   {
     m_tf = &tf;
@@ -219,6 +254,50 @@ public:
   }
 
 private:
+  void start_threads(int num_threads)
+  {
+    m_running = true;
+    m_threads.resize(std::max(num_threads, 0));
+    for(int i = 0; i < int(m_threads.size()); i++)
+    {
+      m_threads[i] = std::thread{[this] {
+        worker_idle_state idle;
+        while(m_running)
+        {
+          task* t{};
+          if(idle.should_spin(m_options))
+          {
+            if(m_tasks.try_dequeue(t))
+            {
+              execute(*t);
+              idle.on_work();
+            }
+            else
+            {
+              ossia::cpu_pause();
+            }
+          }
+          else if(m_tasks.wait_dequeue_timed(t, 100))
+          {
+            execute(*t);
+            idle.on_work();
+          }
+        }
+      }};
+      setup_worker_thread(m_threads[i], i, m_options);
+    }
+  }
+
+  void stop_threads()
+  {
+    m_running = false;
+    for(auto& t : m_threads)
+    {
+      t.join();
+    }
+    m_threads.clear();
+  }
+
   void process_done(ossia::task& task)
   {
     if(task.m_executed.exchange(true))
@@ -292,7 +371,7 @@ private:
 #if defined(CHECK_EXEC_COUNTS)
       assert(m_checkVec[task.m_taskId] == 1);
 #endif
-      m_func(*task.m_node);
+      m_func(*task.m_node, task.m_taskId);
 
 #if defined(CHECK_EXEC_COUNTS)
       assert(m_checkVec[task.m_taskId] == 1);
@@ -313,10 +392,11 @@ private:
   }
 
   task_function m_func;
+  parallel_worker_options m_options;
 
   std::atomic_bool m_running{};
 
-  std::array<std::thread, 8> m_threads;
+  std::vector<std::thread> m_threads;
   taskflow* m_tf{};
   std::atomic_size_t m_doneTasks = 0;
   std::size_t m_toDoTasks = 0;
@@ -327,6 +407,358 @@ private:
   std::array<std::atomic_int, 5000> m_checkVec;
 #endif
 };
+
+/**
+ * @brief Bounded single-owner deque for work stealing.
+ *
+ * Chase-Lev algorithm, with the memory orderings of
+ * Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models".
+ * Only the owner thread may push() and pop(), any thread may steal().
+ * The capacity is set once per run, when no thread accesses the deque:
+ * every task is pushed at most once per run so it never overflows.
+ */
+class work_stealing_deque
+{
+public:
+  void reset(std::size_t capacity)
+  {
+    if(capacity > m_capacity)
+    {
+      std::size_t cap = 1;
+      while(cap < capacity)
+        cap *= 2;
+      m_buffer = std::make_unique<std::atomic<task*>[]>(cap);
+      m_capacity = cap;
+    }
+    m_top.store(0, std::memory_order_relaxed);
+    m_bottom.store(0, std::memory_order_relaxed);
+  }
+
+  void push(task* t) noexcept
+  {
+    const int64_t b = m_bottom.load(std::memory_order_relaxed);
+    assert(b - m_top.load(std::memory_order_relaxed) < int64_t(m_capacity));
+    m_buffer[b & (m_capacity - 1)].store(t, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(b + 1, std::memory_order_relaxed);
+  }
+
+  task* pop() noexcept
+  {
+    const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = m_top.load(std::memory_order_relaxed);
+    if(t <= b)
+    {
+      task* x = m_buffer[b & (m_capacity - 1)].load(std::memory_order_relaxed);
+      if(t == b)
+      {
+        // Last element: race against the thieves
+        if(!m_top.compare_exchange_strong(
+               t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+          x = nullptr;
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+      }
+      return x;
+    }
+    else
+    {
+      m_bottom.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+  }
+
+  task* steal() noexcept
+  {
+    int64_t t = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = m_bottom.load(std::memory_order_acquire);
+    if(t < b)
+    {
+      task* x = m_buffer[t & (m_capacity - 1)].load(std::memory_order_relaxed);
+      if(!m_top.compare_exchange_strong(
+             t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+      return x;
+    }
+    return nullptr;
+  }
+
+private:
+  alignas(64) std::atomic<int64_t> m_top{};
+  alignas(64) std::atomic<int64_t> m_bottom{};
+  std::unique_ptr<std::atomic<task*>[]> m_buffer;
+  std::size_t m_capacity{};
+};
+
+/**
+ * @brief Work-stealing alternative to ossia::executor.
+ *
+ * Each worker (and the thread calling run()) owns a deque.
+ * When a task completes, the first successor it makes ready is executed
+ * directly by the same thread, the other ones are pushed on its deque
+ * where idle workers can steal them.
+ */
+class work_stealing_executor
+{
+public:
+  explicit work_stealing_executor(int num_threads = 8)
+  {
+    start_threads(num_threads);
+  }
+
+  ~work_stealing_executor() { stop_threads(); }
+
+  void set_task_executor(task_function f) { m_func = std::move(f); }
+
+  void set_num_threads(int num_threads)
+  {
+    if(num_threads == int(m_threads.size()))
+      return;
+    stop_threads();
+    start_threads(num_threads);
+  }
+
+  void set_worker_options(const parallel_worker_options& opt)
+  {
+    const int num_threads = m_threads.size();
+    stop_threads();
+    m_options = opt;
+    start_threads(num_threads);
+  }
+
+  void run(taskflow& tf)
+  {
+    m_tf = &tf;
+    if(tf.m_tasks.empty())
+    {
+      return;
+    }
+
+    // No worker touches the deques at this point, see the end of run()
+    const std::size_t N = tf.m_tasks.size();
+    for(auto& dq : m_deques)
+      dq->reset(N);
+
+    m_toDoTasks = N;
+    m_doneTasks.store(0, std::memory_order_relaxed);
+
+    for(auto& task : tf.m_tasks)
+    {
+      task.m_remaining_dependencies.store(
+          task.m_dependencies, std::memory_order_relaxed);
+      task.m_executed.store(false, std::memory_order_relaxed);
+    }
+
+    // Spread the initial tasks over all the deques
+    ossia::small_pod_vector<ossia::task*, 8> toCleanup;
+    std::size_t k = 0;
+    for(auto& task : tf.m_tasks)
+    {
+      if(task.m_dependencies == 0)
+      {
+        if(task.m_node->enabled())
+        {
+          m_deques[k % m_deques.size()]->push(&task);
+          k++;
+        }
+        else
+        {
+          toCleanup.push_back(&task);
+        }
+      }
+    }
+
+    const int self = m_threads.size();
+    for(auto task : toCleanup)
+    {
+      if(auto next = process_done(*task, self))
+        m_deques[self]->push(next);
+    }
+
+    // Store then load, as the workers do when they park: this needs seq_cst,
+    // else a worker parking now could miss this run and sleep through it.
+    m_active.store(true, std::memory_order_seq_cst);
+    if(const int parked = m_parked.load(std::memory_order_seq_cst); parked > 0)
+      m_wake.signal(parked);
+
+    while(m_doneTasks.load(std::memory_order_acquire) != m_toDoTasks)
+    {
+      if(auto t = find_task(self))
+        execute_chain(t, self);
+      else
+        std::this_thread::yield();
+    }
+
+    // Wait for the workers to leave the deques before the next run.
+    // Store then load on both sides (see the workers): this needs seq_cst,
+    // else a worker entering now and this thread could both miss each other.
+    m_active.store(false, std::memory_order_seq_cst);
+    while(m_inFlight.load(std::memory_order_seq_cst) != 0)
+      std::this_thread::yield();
+  }
+
+private:
+  void start_threads(int num_threads)
+  {
+    num_threads = std::max(num_threads, 0);
+    m_running = true;
+
+    // One deque per worker, plus one for the thread calling run()
+    m_deques.clear();
+    for(int i = 0; i < num_threads + 1; i++)
+      m_deques.push_back(std::make_unique<work_stealing_deque>());
+
+    m_threads.resize(num_threads);
+    for(int i = 0; i < num_threads; i++)
+    {
+      m_threads[i] = std::thread{[this, i] {
+        worker_idle_state idle;
+        while(m_running)
+        {
+          if(!m_active.load(std::memory_order_acquire))
+          {
+            if(idle.should_spin(m_options))
+            {
+              ossia::cpu_pause();
+            }
+            else
+            {
+              m_parked.fetch_add(1, std::memory_order_seq_cst);
+              if(!m_active.load(std::memory_order_seq_cst) && m_running)
+                m_wake.wait();
+              m_parked.fetch_sub(1, std::memory_order_relaxed);
+            }
+            continue;
+          }
+
+          m_inFlight.fetch_add(1, std::memory_order_seq_cst);
+          while(m_active.load(std::memory_order_seq_cst))
+          {
+            if(auto t = find_task(i))
+              execute_chain(t, i);
+            else
+              std::this_thread::yield();
+          }
+          m_inFlight.fetch_sub(1, std::memory_order_acq_rel);
+          idle.on_work();
+        }
+      }};
+      setup_worker_thread(m_threads[i], i, m_options);
+    }
+  }
+
+  void stop_threads()
+  {
+    m_running = false;
+    m_wake.signal(m_threads.size());
+    for(auto& t : m_threads)
+    {
+      t.join();
+    }
+    m_threads.clear();
+  }
+
+  task* find_task(int self) noexcept
+  {
+    if(auto t = m_deques[self]->pop())
+      return t;
+
+    const int n = m_deques.size();
+    for(int k = 1; k < n; k++)
+    {
+      if(auto t = m_deques[(self + k) % n]->steal())
+        return t;
+    }
+    return nullptr;
+  }
+
+  void execute_chain(task* t, int self)
+  {
+    while(t)
+    {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      try
+      {
+        assert(!t->m_executed);
+        m_func(*t->m_node, t->m_taskId);
+      }
+      catch(...)
+      {
+        fmt::print(stderr, "error !\n");
+      }
+      std::atomic_thread_fence(std::memory_order_release);
+
+      t = process_done(*t, self);
+    }
+  }
+
+  // Returns the first successor made ready by this task, if any:
+  // it is run by the same thread instead of going through the deque.
+  task* process_done(ossia::task& task, int self)
+  {
+    if(task.m_executed.exchange(true))
+      return nullptr;
+
+    ossia::task* next{};
+    ossia::small_pod_vector<ossia::task*, 8> toCleanup;
+    for(int taskId : task.m_precedes)
+    {
+      auto& nextTask = m_tf->m_tasks[taskId];
+      assert(!nextTask.m_executed);
+
+      std::atomic_int& remaining = nextTask.m_remaining_dependencies;
+      const int rem = remaining.fetch_sub(1, std::memory_order_acq_rel) - 1;
+      assert(rem >= 0);
+      if(rem == 0)
+      {
+        if(nextTask.m_node->enabled())
+        {
+          if(!next)
+            next = &nextTask;
+          else
+            m_deques[self]->push(&nextTask);
+        }
+        else
+        {
+          toCleanup.push_back(&nextTask);
+        }
+      }
+    }
+
+    for(auto clean : toCleanup)
+    {
+      if(auto t = process_done(*clean, self))
+      {
+        if(!next)
+          next = t;
+        else
+          m_deques[self]->push(t);
+      }
+    }
+
+    m_doneTasks.fetch_add(1, std::memory_order_release);
+    return next;
+  }
+
+  task_function m_func;
+  parallel_worker_options m_options;
+
+  std::atomic_bool m_running{};
+  std::atomic_bool m_active{};
+  std::atomic_int m_inFlight{};
+
+  //! Workers waiting on m_wake, or about to
+  std::atomic_int m_parked{};
+  moodycamel::LightweightSemaphore m_wake;
+
+  std::vector<std::thread> m_threads;
+  std::vector<std::unique_ptr<work_stealing_deque>> m_deques;
+  taskflow* m_tf{};
+  std::atomic_size_t m_doneTasks = 0;
+  std::size_t m_toDoTasks = 0;
+};
 }
 
 #include <ossia/dataflow/graph/graph_static.hpp>
@@ -334,7 +766,7 @@ private:
 namespace ossia
 {
 struct custom_parallel_exec;
-template <typename Impl>
+template <typename Impl, typename Executor = ossia::executor>
 struct custom_parallel_update
 {
 public:
@@ -405,6 +837,12 @@ public:
     update_graph(g.m_nodes, g.m_all_nodes, impl.m_sub_graph);
   }
 
+  void set_num_threads(int num_threads) { executor.set_num_threads(num_threads); }
+  void set_worker_options(const parallel_worker_options& opt)
+  {
+    executor.set_worker_options(opt);
+  }
+
 private:
   friend struct custom_parallel_exec;
 
@@ -412,7 +850,7 @@ private:
   execution_state* cur_state{};
 
   ossia::taskflow flow_graph;
-  ossia::executor executor;
+  Executor executor;
   ossia::fast_hash_map<graph_node*, ossia::task*> flow_nodes;
 };
 
@@ -423,18 +861,23 @@ struct custom_parallel_exec
   {
   }
 
-  template <typename Graph_T, typename Impl>
+  template <typename Graph_T, typename Impl, typename Executor>
   void operator()(
-      Graph_T& g, custom_parallel_update<Impl>& self, ossia::execution_state& e,
+      Graph_T& g, custom_parallel_update<Impl, Executor>& self,
+      ossia::execution_state& e,
       const std::vector<ossia::graph_node*>&)
   {
     self.cur_state = &e;
     self.executor.run(self.flow_graph);
+    e.merge_parallel_state();
   }
 };
 
 using custom_parallel_tc_graph
-    = graph_static<custom_parallel_update<tc_update<fast_tc>>, custom_parallel_exec>;
+    = graph_static<custom_parallel_update<tc_update<incremental_tc>>, custom_parallel_exec>;
+using work_stealing_tc_graph = graph_static<
+    custom_parallel_update<tc_update<incremental_tc>, work_stealing_executor>,
+    custom_parallel_exec>;
 }
 
 //#undef memory_order_relaxed
@@ -2,6 +2,7 @@
 #include <ossia/dataflow/bench_map.hpp>
 #include <ossia/dataflow/graph/graph_interface.hpp>
 #include <ossia/dataflow/graph/graph_utils.hpp>
+#include <ossia/dataflow/graph/incremental_transitive_closure.hpp>
 #include <ossia/dataflow/graph/node_executors.hpp>
 #include <ossia/dataflow/graph/transitive_closure.hpp>
 #include <ossia/detail/flat_map.hpp>
@@ -36,7 +37,7 @@ public:
   }
   ~graph_static() override { clear(); }
 
-  void sort_all_nodes(const graph_t& gr)
+  bool sort_all_nodes(const graph_t& gr)
   {
     try
     {
@@ -50,36 +51,38 @@ public:
       custom_topological_sort(
           gr, std::back_inserter(m_topo_order_cache), m_color_map_cache, m_stack_cache);
 
-      // First put the ones without any I/O (most likely states)
-      for(auto vtx : m_topo_order_cache)
-      {
-        auto node = gr[vtx].get();
-        assert(node);
-        if(node->root_inputs().empty() && node->root_outputs().empty())
-        {
-          m_all_nodes.push_back(node);
-        }
-      }
-      // Then the others
-      for(auto vtx : m_topo_order_cache)
-      {
-        auto node = gr[vtx].get();
-        assert(node);
-
-        if(!(node->root_inputs().empty() && node->root_outputs().empty()))
-        {
-          m_all_nodes.push_back(node);
-        }
-      }
+      fill_all_nodes(gr);
+      return true;
     }
     catch(...)
     {
       std::cout << "Error: graph isn't a DAG: ";
       print_graph(gr, std::cout);
       std::cout << std::endl;
+      return false;
     }
   }
 
+  //! Uses the incrementally maintained order, and only sorts
+  //! the whole graph if it is out of sync with gr.
+  void sort_all_nodes(const graph_t& gr, dynamic_topological_order& order)
+  {
+    if(!order.valid() || order.num_vertices() != boost::num_vertices(gr)
+       || order.num_edges() != boost::num_edges(gr))
+    {
+      if(sort_all_nodes(gr))
+        order.reset(gr, m_topo_order_cache);
+      else
+        order.invalidate();
+      return;
+    }
+
+    m_all_nodes.clear();
+    m_all_nodes.reserve(m_nodes.size());
+    m_topo_order_cache.assign(order.order().begin(), order.order().end());
+    fill_all_nodes(gr);
+  }
+
   void state(execution_state& e) override
   {
     try
@@ -88,6 +91,7 @@ public:
       {
         update_fun(*this, e.exec_devices());
         m_enabled_cache.clear();
+        m_edits.clear();
         m_dirty = false;
       }
 
@@ -143,6 +147,31 @@ protected:
   }
 
 private:
+  void fill_all_nodes(const graph_t& gr)
+  {
+    // First put the ones without any I/O (most likely states)
+    for(auto vtx : m_topo_order_cache)
+    {
+      auto node = gr[vtx].get();
+      assert(node);
+      if(node->root_inputs().empty() && node->root_outputs().empty())
+      {
+        m_all_nodes.push_back(node);
+      }
+    }
+    // Then the others
+    for(auto vtx : m_topo_order_cache)
+    {
+      auto node = gr[vtx].get();
+      assert(node);
+
+      if(!(node->root_inputs().empty() && node->root_outputs().empty()))
+      {
+        m_all_nodes.push_back(node);
+      }
+    }
+  }
+
   node_flat_set m_enabled_cache;
   node_flat_set m_disabled_cache;
   std::vector<graph_vertex_t> m_topo_order_cache;
@@ -162,7 +191,7 @@ struct simple_update
   template <typename Graph_T, typename DevicesT>
   void operator()(Graph_T& g, const DevicesT& devices)
   {
-    g.sort_all_nodes(g.m_graph);
+    g.sort_all_nodes(g.m_graph, g.m_topo_order);
   }
 };
 
@@ -187,7 +216,8 @@ public:
     // m_color.reserve(N);
     m_sub_graph = m_graph;
 
-    g.sort_all_nodes(m_graph);
+    g.sort_all_nodes(m_graph, g.m_topo_order);
+    m_sub_order = g.m_topo_order;
     // m_active_nodes is in topo order
 
     for(std::size_t i = 0; i < N; i++)
@@ -214,6 +244,7 @@ public:
               ossia::dependency_connection{}, ossia::outlet_ptr{}, ossia::inlet_ptr{},
               src_it->first, sink_it->first);
           boost::add_edge(sink_it->second, src_it->second, edge, m_sub_graph);
+          m_sub_order.add_edge(src_it->second, sink_it->second);
 
 #if defined(OSSIA_GRAPH_DEBUG)
           auto all_nodes_old = std::move(m_all_nodes);
@@ -230,6 +261,7 @@ public:
               ossia::dependency_connection{}, ossia::outlet_ptr{}, ossia::inlet_ptr{},
               src_it->first, sink_it->first);
           boost::add_edge(sink_it->second, src_it->second, edge, m_sub_graph);
+          m_sub_order.add_edge(src_it->second, sink_it->second);
 
 #if defined(OSSIA_GRAPH_DEBUG)
           auto all_nodes_old = std::move(m_all_nodes);
@@ -241,7 +273,7 @@ public:
       }
     }
 
-    g.sort_all_nodes(m_sub_graph);
+    g.sort_all_nodes(m_sub_graph, m_sub_order);
   }
 
   bool find_path(graph_vertex_t source, graph_vertex_t sink, graph_t& graph)
@@ -271,6 +303,7 @@ public:
     return ok;
   }
   graph_t m_sub_graph;
+  dynamic_topological_order m_sub_order;
 
 private:
   boost::circular_buffer<graph_vertex_t> m_queue;
@@ -296,24 +329,32 @@ public:
   {
     m_sub_graph = g.m_graph;
 
-    g.sort_all_nodes(m_sub_graph);
+    g.sort_all_nodes(m_sub_graph, g.m_topo_order);
+    m_sub_order = g.m_topo_order;
 
-    impl.update(m_sub_graph);
+    if constexpr(requires { impl.update(g.m_graph, g.m_topo_order, g.m_edits); })
+      impl.update(g.m_graph, g.m_topo_order, g.m_edits);
+    else
+      impl.update(m_sub_graph);
 
-    tc_add_addresses(g, g.m_graph, m_sub_graph, g.m_nodes, g.m_all_nodes, impl, devices);
+    tc_add_addresses(
+        g, g.m_graph, m_sub_graph, m_sub_order, g.m_nodes, g.m_all_nodes, impl,
+        devices);
 
-    g.sort_all_nodes(m_sub_graph);
+    g.sort_all_nodes(m_sub_graph, m_sub_order);
   }
 
   graph_t m_sub_graph;
+  dynamic_topological_order m_sub_order;
 
 private:
   template <
       typename BaseGraph, typename TCGraph, typename NodeMap, typename AllNodes,
       typename TC, typename Devices>
   static void tc_add_addresses(
-      auto& impl, BaseGraph& m_graph, TCGraph& m_sub_graph, NodeMap& m_nodes,
-      AllNodes& m_all_nodes, TC& tc, Devices& devices)
+      auto& impl, BaseGraph& m_graph, TCGraph& m_sub_graph,
+      dynamic_topological_order& m_sub_order, NodeMap& m_nodes, AllNodes& m_all_nodes,
+      TC& tc, Devices& devices)
   {
     // m_active_nodes is in topo order
 
@@ -359,7 +400,11 @@ private:
               ossia::dependency_connection{}, ossia::outlet_ptr{}, ossia::inlet_ptr{},
               src_it->first, sink_it->first);
           boost::add_edge(sink_it->second, src_it->second, edge, m_sub_graph);
-          tc.update(m_sub_graph);
+          m_sub_order.add_edge(src_it->second, sink_it->second);
+          if constexpr(requires { tc.add_edge(sink_it->second, src_it->second); })
+            tc.add_edge(sink_it->second, src_it->second);
+          else
+            tc.update(m_sub_graph);
 
 #if defined(OSSIA_GRAPH_DEBUG)
           print_graph(transitive_closure, std::cout);
@@ -377,7 +422,11 @@ private:
               ossia::dependency_connection{}, ossia::outlet_ptr{}, ossia::inlet_ptr{},
               src_it->first, sink_it->first);
           boost::add_edge(sink_it->second, src_it->second, edge, m_sub_graph);
-          tc.update(m_sub_graph);
+          m_sub_order.add_edge(src_it->second, sink_it->second);
+          if constexpr(requires { tc.add_edge(sink_it->second, src_it->second); })
+            tc.add_edge(sink_it->second, src_it->second);
+          else
+            tc.update(m_sub_graph);
 
 #if defined(OSSIA_GRAPH_DEBUG)
           auto all_nodes_old = std::move(m_all_nodes);
@@ -451,8 +500,117 @@ private:
   transitive_closure_t m_transitive_closure;
 };
 
-using tc_graph = graph_static<tc_update<fast_tc>, static_exec>;
+/**
+ * @brief Transitive closure kept up to date across graph edits.
+ *
+ * The closure of the base graph is updated from graph_base::m_edits:
+ * inserted edges are propagated to the vertices reaching their source,
+ * removed edges cause the rows of the vertices which reached their source
+ * to be recomputed in topological order. The dependency edges added by
+ * tc_update are then inserted in a copy of it.
+ */
+struct incremental_tc
+{
+public:
+  [[nodiscard]] bool has_edge(int source_vtx, int sink_vtx) const
+  {
+    return m_transitive_closure.reachable(source_vtx, sink_vtx);
+  }
+
+  void update(const graph_t& sub_graph) { m_transitive_closure.rebuild(sub_graph); }
+
+  void update(
+      const graph_t& base_graph, const dynamic_topological_order& order,
+      const std::vector<graph_edit>& edits)
+  {
+    update_base(base_graph, order, edits);
+    m_transitive_closure = m_base;
+  }
+
+  void add_edge(graph_vertex_t source_vtx, graph_vertex_t sink_vtx)
+  {
+    m_transitive_closure.insert_edge(source_vtx, sink_vtx);
+  }
+
+private:
+  void update_base(
+      const graph_t& g, const dynamic_topological_order& order,
+      const std::vector<graph_edit>& edits)
+  {
+    const std::size_t N = boost::num_vertices(g);
+    const bool ordered = order.valid() && order.num_vertices() == N;
+
+    std::size_t added_vertices = 0;
+    bool full = !m_initialized || !ordered;
+    for(const auto& e : edits)
+    {
+      if(e.kind == graph_edit::RemoveVertex || e.kind == graph_edit::Reset)
+        full = true;
+      else if(e.kind == graph_edit::AddVertex)
+        added_vertices++;
+    }
+    const std::size_t old_size = m_base.size();
+    if(old_size + added_vertices != N)
+      full = true;
+
+    m_initialized = true;
+    if(full)
+    {
+      if(ordered)
+        m_base.rebuild(g, order.order());
+      else
+        m_base.rebuild(g);
+      return;
+    }
+
+    m_base.resize(N);
+
+    // Removals: the rows of the vertices which could reach the source
+    // of a removed edge are recomputed from the current graph.
+    m_affected.assign(N, false);
+    bool any_removal = false;
+    for(const auto& e : edits)
+    {
+      if(e.kind != graph_edit::RemoveEdge)
+        continue;
+      any_removal = true;
+      m_affected[e.source] = true;
+      if(e.source < old_size)
+      {
+        for(std::size_t x = 0; x < old_size; x++)
+          if(m_base.reachable(x, e.source))
+            m_affected[x] = true;
+      }
+    }
+    if(any_removal)
+      m_base.recompute_rows(g, order.order(), m_affected);
+
+    // Insertions of the edges which are still there
+    for(const auto& e : edits)
+    {
+      if(e.kind == graph_edit::AddEdge && has_edge(g, e.source, e.target))
+        m_base.insert_edge(e.source, e.target);
+    }
+  }
+
+  // boost::edge cannot find the edges of graph_t: its out-edge lists are
+  // small_vectors, which boost's container traits do not know about
+  static bool has_edge(const graph_t& g, std::size_t source, std::size_t target)
+  {
+    for(auto [it, end] = boost::out_edges(source, g); it != end; ++it)
+      if(boost::target(*it, g) == target)
+        return true;
+    return false;
+  }
+
+  incremental_transitive_closure m_base;
+  incremental_transitive_closure m_transitive_closure;
+  std::vector<bool> m_affected;
+  bool m_initialized{};
+};
+
+using tc_graph = graph_static<tc_update<incremental_tc>, static_exec>;
 using bfs_graph = graph_static<bfs_update, static_exec>;
 
-using logged_tc_graph = graph_static<tc_update<fast_tc>, static_exec_logger>;
+using logged_tc_graph = graph_static<tc_update<incremental_tc>, static_exec_logger>;
 }
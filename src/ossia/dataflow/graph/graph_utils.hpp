@@ -5,6 +5,7 @@
 #include <ossia/dataflow/execution_state.hpp>
 #include <ossia/dataflow/for_each_port.hpp>
 #include <ossia/dataflow/graph/breadth_first_search.hpp>
+#include <ossia/dataflow/graph/dynamic_topological_order.hpp>
 #include <ossia/dataflow/graph/graph_interface.hpp>
 #include <ossia/dataflow/graph/graph_ordering.hpp>
 #include <ossia/dataflow/graph/small_graph.hpp>
@@ -655,6 +656,21 @@ struct OSSIA_EXPORT graph_util
   }
 };
 
+//! A structural change of graph_base::m_graph, in boost edge orientation
+struct graph_edit
+{
+  enum : uint8_t
+  {
+    AddVertex,
+    RemoveVertex,
+    AddEdge,
+    RemoveEdge,
+    Reset
+  } kind{};
+  graph_vertex_t source{};
+  graph_vertex_t target{};
+};
+
 struct OSSIA_EXPORT graph_base : graph_interface
 {
   graph_base() noexcept
@@ -710,6 +726,8 @@ struct OSSIA_EXPORT graph_base : graph_interface
     // bench[n.get()];
 
     auto vtx = boost::add_vertex(n, m_graph);
+    m_topo_order.add_vertex();
+    record_edit({graph_edit::AddVertex, vtx, vtx});
     // m_nodes.insert({std::move(n), vtx});
     m_node_list.push_back(n.get());
     m_dirty = true;
@@ -746,6 +764,8 @@ struct OSSIA_EXPORT graph_base : graph_interface
       {
         boost::clear_vertex(it->second, m_graph);
         remove_vertex(it->second, m_graph);
+        m_topo_order.remove_vertex(it->second);
+        record_edit({graph_edit::RemoveVertex, it->second, it->second});
 
         recompute_maps();
       }
@@ -776,6 +796,8 @@ struct OSSIA_EXPORT graph_base : graph_interface
 
       // TODO check that two edges can be added
       boost::add_edge(in_vtx, out_vtx, edge, m_graph);
+      m_topo_order.add_edge(out_vtx, in_vtx);
+      record_edit({graph_edit::AddEdge, in_vtx, out_vtx});
       recompute_maps();
       m_dirty = true;
     }
@@ -797,6 +819,10 @@ struct OSSIA_EXPORT graph_base : graph_interface
         auto edg = boost::edges(m_graph);
         if(std::find(edg.first, edg.second, it->second) != edg.second)
         {
+          const auto src = boost::source(it->second, m_graph);
+          const auto tgt = boost::target(it->second, m_graph);
+          m_topo_order.remove_edge(tgt, src);
+          record_edit({graph_edit::RemoveEdge, src, tgt});
           boost::remove_edge(it->second, m_graph);
           recompute_maps();
         }
@@ -823,6 +849,9 @@ struct OSSIA_EXPORT graph_base : graph_interface
     m_node_list.clear();
     m_edges.clear();
     m_graph.clear();
+    m_topo_order.clear();
+    m_edits.clear();
+    record_edit({graph_edit::Reset});
   }
 
   void mark_dirty() final override
@@ -841,6 +870,25 @@ struct OSSIA_EXPORT graph_base : graph_interface
 
   graph_t m_graph;
 
+  //! Kept in sync with m_graph by the edit functions above
+  dynamic_topological_order m_topo_order;
+
+  //! Edits since the last update, for the incremental algorithms.
+  //! Cleared by the graphs which use it.
+  std::vector<graph_edit> m_edits;
+
   bool m_dirty{};
+
+private:
+  void record_edit(graph_edit e)
+  {
+    // Past this point a full recomputation is cheaper than replaying
+    if(m_edits.size() >= 4096)
+    {
+      m_edits.clear();
+      e = {graph_edit::Reset};
+    }
+    m_edits.push_back(e);
+  }
 };
 }
@@ -0,0 +1,158 @@
+#pragma once
+#include <boost/graph/adjacency_list.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace ossia
+{
+/**
+ * @brief Transitive closure stored as one bitset per vertex.
+ *
+ * Edge insertions are applied incrementally: every vertex reaching the
+ * source of the new edge gets the reachability set of its target.
+ * Rows can also be recomputed selectively from a topological order,
+ * which is what is done for the vertices affected by an edge removal.
+ */
+class incremental_transitive_closure
+{
+public:
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+  [[nodiscard]] bool reachable(std::size_t from, std::size_t to) const noexcept
+  {
+    return (row(from)[to / 64] >> (to % 64)) & 1;
+  }
+
+  void clear()
+  {
+    m_bits.clear();
+    m_size = 0;
+    m_words = 0;
+  }
+
+  //! New vertices do not reach anything
+  void resize(std::size_t n)
+  {
+    const std::size_t words = (n + 63) / 64;
+    if(words != m_words)
+    {
+      std::vector<uint64_t> bits(n * words);
+      const std::size_t common = std::min(words, m_words);
+      for(std::size_t v = 0; v < std::min(n, m_size); v++)
+        std::memcpy(&bits[v * words], &m_bits[v * m_words], common * sizeof(uint64_t));
+      m_bits = std::move(bits);
+      m_words = words;
+    }
+    else
+    {
+      m_bits.resize(n * words);
+    }
+    m_size = n;
+  }
+
+  void insert_edge(std::size_t from, std::size_t to)
+  {
+    if(reachable(from, to))
+      return;
+
+    m_scratch.assign(row(to), row(to) + m_words);
+    m_scratch[to / 64] |= uint64_t(1) << (to % 64);
+
+    const std::size_t from_word = from / 64;
+    const uint64_t from_bit = uint64_t(1) << (from % 64);
+    for(std::size_t x = 0; x < m_size; x++)
+    {
+      uint64_t* r = row(x);
+      if(x == from || (r[from_word] & from_bit))
+      {
+        for(std::size_t w = 0; w < m_words; w++)
+          r[w] |= m_scratch[w];
+      }
+    }
+  }
+
+  /**
+   * Recomputes the rows of the vertices for which mask[v] is set,
+   * from the out-edges of g. exec_order must be a topological order
+   * where the targets of the edges of g come before their sources.
+   */
+  template <typename Graph, typename Order, typename Mask>
+  void recompute_rows(const Graph& g, const Order& exec_order, const Mask& mask)
+  {
+    for(auto v : exec_order)
+    {
+      if(!mask[v])
+        continue;
+
+      uint64_t* r = row(v);
+      std::fill_n(r, m_words, 0);
+      for(auto [it, end] = boost::out_edges(v, g); it != end; ++it)
+      {
+        const std::size_t w = boost::target(*it, g);
+        const uint64_t* rw = row(w);
+        for(std::size_t k = 0; k < m_words; k++)
+          r[k] |= rw[k];
+        r[w / 64] |= uint64_t(1) << (w % 64);
+      }
+    }
+  }
+
+  //! Rebuilds everything from a topological order, see recompute_rows
+  template <typename Graph, typename Order>
+  void rebuild(const Graph& g, const Order& exec_order)
+  {
+    clear();
+    resize(boost::num_vertices(g));
+    struct all_t
+    {
+      bool operator[](std::size_t) const noexcept { return true; }
+    };
+    recompute_rows(g, exec_order, all_t{});
+  }
+
+  //! Rebuilds everything with a search from each vertex; works with cycles
+  template <typename Graph>
+  void rebuild(const Graph& g)
+  {
+    clear();
+    resize(boost::num_vertices(g));
+    std::vector<std::size_t> stack;
+    for(std::size_t v = 0; v < m_size; v++)
+    {
+      uint64_t* r = row(v);
+      stack.clear();
+      stack.push_back(v);
+      while(!stack.empty())
+      {
+        const std::size_t u = stack.back();
+        stack.pop_back();
+        for(auto [it, end] = boost::out_edges(u, g); it != end; ++it)
+        {
+          const std::size_t w = boost::target(*it, g);
+          const uint64_t bit = uint64_t(1) << (w % 64);
+          if(!(r[w / 64] & bit))
+          {
+            r[w / 64] |= bit;
+            stack.push_back(w);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  uint64_t* row(std::size_t v) noexcept { return m_bits.data() + v * m_words; }
+  const uint64_t* row(std::size_t v) const noexcept
+  {
+    return m_bits.data() + v * m_words;
+  }
+
+  std::vector<uint64_t> m_bits;
+  std::vector<uint64_t> m_scratch;
+  std::size_t m_size{};
+  std::size_t m_words{};
+};
+}
@@ -3,13 +3,28 @@
 
 namespace ossia
 {
+//! Marks a node as being executed by a parallel worker, see execution_state::begin_parallel_node
+struct parallel_node_scope
+{
+  execution_state& state;
+  parallel_node_scope(execution_state& st, int order) noexcept
+      : state{st}
+  {
+    state.begin_parallel_node(order);
+  }
+  parallel_node_scope(const parallel_node_scope&) = delete;
+  parallel_node_scope& operator=(const parallel_node_scope&) = delete;
+  ~parallel_node_scope() { state.end_parallel_node(); }
+};
+
 struct node_exec
 {
   execution_state*& g;
 
-  void operator()(graph_node& node)
+  void operator()(graph_node& node, int order)
   try
   {
+    parallel_node_scope scope{*g, order};
     if(node.enabled())
     {
       assert(graph_util::can_execute(node, *g));
@@ -26,9 +41,10 @@ struct node_exec_bench
   execution_state*& g;
   bench_map& perf;
 
-  void operator()(graph_node& node)
+  void operator()(graph_node& node, int order)
   try
   {
+    parallel_node_scope scope{*g, order};
     if(perf.measure)
     {
       if(node.enabled())
@@ -58,9 +74,10 @@ struct node_exec_logger
   execution_state*& g;
   ossia::logger_type& logger;
 
-  void operator()(graph_node& node)
+  void operator()(graph_node& node, int order)
   try
   {
+    parallel_node_scope scope{*g, order};
     if(node.enabled())
     {
       assert(graph_util::can_execute(node, *g));
@@ -82,9 +99,10 @@ struct node_exec_logger_bench
   bench_map& perf;
   ossia::logger_type& logger;
 
-  void operator()(graph_node& node)
+  void operator()(graph_node& node, int order)
   try
   {
+    parallel_node_scope scope{*g, order};
     if(perf.measure)
     {
       if(node.enabled())
@@ -5,15 +5,44 @@
 #include <ossia/dataflow/graph_node.hpp>
 #include <ossia/dataflow/node_process.hpp>
 #include <ossia/dataflow/port.hpp>
+#include <ossia/detail/pod_vector.hpp>
 #include <ossia/editor/automation/curve_value_visitor.hpp>
 #include <ossia/editor/curve/behavior.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 /**
  * \file automation.hpp
  */
 
 namespace ossia::nodes
 {
+/**
+ * \brief Position of an automation at each sample of a tick.
+ *
+ * Sample k of the tick is at position at(k): the last sample of the tick is
+ * at t.position(), which is what a tick-rate automation writes.
+ */
+struct automation_block
+{
+  double start{};
+  double step{};
+
+  automation_block(const ossia::token_request& t, ossia::exec_state_facade e) noexcept
+  {
+    if(t.parent_duration.impl <= 0)
+      return;
+
+    start = t.prev_date.impl / double(t.parent_duration.impl);
+    const double samples = std::abs(t.physical_write_duration(e.modelToSamples()));
+    if(samples > 0.)
+      step = (t.position() - start) / samples;
+  }
+
+  [[nodiscard]] double at(int64_t k) const noexcept { return start + (k + 1) * step; }
+};
+
 /**
  * \brief The ossia::nodes::automation class
  *
@@ -49,6 +78,10 @@ public:
 
   void reset_drive() { m_drive.reset(); }
 
+  //! Write a value every `samples` samples instead of once per tick.
+  //! 0 goes back to one value per tick.
+  void set_control_rate(int64_t samples) noexcept { m_control_rate = samples; }
+
 private:
   void run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept override
   {
@@ -57,15 +90,33 @@ private:
     const auto [tick_start, d] = e.timings(t);
 
     ossia::value_port& vp = *value_out;
-    vp.write_value(
-        ossia::apply(
-            ossia::detail::compute_value_visitor{t.position(), ossia::val_type::FLOAT},
-            m_drive),
-        tick_start);
+    if(m_control_rate <= 0 || d <= m_control_rate)
+    {
+      vp.write_value(
+          ossia::apply(
+              ossia::detail::compute_value_visitor{t.position(), ossia::val_type::FLOAT},
+              m_drive),
+          tick_start);
+      return;
+    }
+
+    // Each value is the one at the end of its sub-block
+    const automation_block block{t, e};
+    for(int64_t k = 0; k < d; k += m_control_rate)
+    {
+      const int64_t end = std::min(k + m_control_rate, d);
+      vp.write_value(
+          ossia::apply(
+              ossia::detail::compute_value_visitor{
+                  block.at(end - 1), ossia::val_type::FLOAT},
+              m_drive),
+          tick_start + k);
+    }
   }
 
   ossia::behavior m_drive;
   ossia::value_outlet value_out;
+  int64_t m_control_rate{};
 };
 
 class float_automation final : public ossia::nonowning_graph_node
@@ -81,25 +132,108 @@ public:
 
   void reset_drive() { m_drive.reset(); }
 
+  //! Write a value every `samples` samples instead of once per tick.
+  //! 0 goes back to one value per tick.
+  void set_control_rate(int64_t samples) noexcept { m_control_rate = samples; }
+
 private:
   void run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept override
   {
     const auto [tick_start, d] = e.timings(t);
 
     ossia::value_port& vp = *value_out;
-    vp.write_value(m_drive.value_at(t.position()), tick_start);
+    if(m_control_rate <= 0 || d <= m_control_rate)
+    {
+      vp.write_value(m_drive.value_at(t.position()), tick_start);
+      return;
+    }
+
+    // The values at the end of the complete sub-blocks, in a single pass
+    const automation_block block{t, e};
+    const int64_t full = d / m_control_rate;
+    m_values.resize(full, boost::container::default_init);
+    m_drive.values_at(
+        block.at(m_control_rate - 1), m_control_rate * block.step, m_values.data(),
+        full);
+
+    for(int64_t i = 0; i < full; i++)
+      vp.write_value(m_values[i], tick_start + i * m_control_rate);
+    if(d % m_control_rate != 0)
+      vp.write_value(m_drive.value_at(block.at(d - 1)), tick_start + full * m_control_rate);
   }
 
   ossia::curve<double, float> m_drive;
   ossia::minmax_float_outlet value_out;
+  ossia::float_vector m_values;
+  int64_t m_control_rate{};
 };
+
+/**
+ * \brief Automation rendered at audio rate.
+ *
+ * Writes the value of its curve at every sample of the tick to a mono audio
+ * port, for modulations which must not step at each buffer.
+ */
+class audio_automation final : public ossia::nonowning_graph_node
+{
+public:
+  audio_automation() { m_outlets.push_back(&audio_out); }
+
+  ~audio_automation() override = default;
+
+  std::string label() const noexcept override { return "automation (audio)"; }
+
+  void set_behavior(ossia::curve<double, float> b) { m_drive = std::move(b); }
+
+  void reset_drive() { m_drive.reset(); }
+
+private:
+  void run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept override
+  {
+    const auto [tick_start, d] = e.timings(t);
+    if(d <= 0)
+      return;
+
+    ossia::audio_port& audio = *audio_out;
+    audio.set_channels(1);
+    auto& c = audio.channel(0);
+    c.resize(tick_start + d);
+
+    const automation_block block{t, e};
+    m_drive.values_at(block.at(0), block.step, c.data() + tick_start, d);
+  }
+
+  ossia::curve<double, float> m_drive;
+  ossia::audio_outlet audio_out;
+};
+
+/**
+ * \brief Process of an automation, float_automation or audio_automation node.
+ */
 class automation_process final : public ossia::node_process
 {
 public:
   using ossia::node_process::node_process;
   void start() override
   {
-    static_cast<ossia::nodes::automation*>(node.get())->reset_drive();
+    auto n = node.get();
+    if(auto a = dynamic_cast<ossia::nodes::automation*>(n))
+      a->reset_drive();
+    else if(auto f = dynamic_cast<ossia::nodes::float_automation*>(n))
+      f->reset_drive();
+    else if(auto au = dynamic_cast<ossia::nodes::audio_automation*>(n))
+      au->reset_drive();
+  }
+
+  //! See automation::set_control_rate.
+  //! Audio-rate automations already write every sample and ignore it.
+  void set_control_rate(int64_t samples) noexcept
+  {
+    auto n = node.get();
+    if(auto a = dynamic_cast<ossia::nodes::automation*>(n))
+      a->set_control_rate(samples);
+    else if(auto f = dynamic_cast<ossia::nodes::float_automation*>(n))
+      f->set_control_rate(samples);
   }
 };
 }
@@ -193,7 +193,7 @@ struct faust_node_utils
 
   template <typename Node>
   static void copy_input(
-      Node& self, int64_t d, int64_t n_in, float* inputs_, float** input_n,
+      Node& self, int64_t d, int64_t n_in, FAUSTFLOAT* inputs_, FAUSTFLOAT** input_n,
       const ossia::audio_port& audio_in)
   {
     // TODO offset !!!
@@ -205,7 +205,7 @@ struct faust_node_utils
         auto num_samples = std::min((int64_t)d, (int64_t)audio_in.channel(i).size());
         for(int64_t j = 0; j < num_samples; j++)
         {
-          input_n[i][j] = (float)audio_in.channel(i)[j];
+          input_n[i][j] = (FAUSTFLOAT)audio_in.channel(i)[j];
         }
 
         if(d > int64_t(audio_in.channel(i).size()))
@@ -227,14 +227,14 @@ struct faust_node_utils
   }
   template <typename Node>
   static void copy_input_mono(
-      Node& self, int64_t d, int64_t i, float* input,
+      Node& self, int64_t d, int64_t i, FAUSTFLOAT* input,
       const ossia::audio_channel& audio_in)
   {
     // TODO offset !!!
     auto num_samples = std::min((int64_t)d, (int64_t)audio_in.size());
     for(int64_t j = 0; j < num_samples; j++)
     {
-      input[j] = (float)audio_in[j];
+      input[j] = (FAUSTFLOAT)audio_in[j];
     }
 
     if(d > int64_t(audio_in.size()))
@@ -247,8 +247,8 @@ struct faust_node_utils
   }
 
   template <typename Node>
-  static void
-  init_output(Node& self, int64_t d, int64_t n_out, float* outputs_, float** output_n)
+  static void init_output(
+      Node& self, int64_t d, int64_t n_out, FAUSTFLOAT* outputs_, FAUSTFLOAT** output_n)
   {
     for(int64_t i = 0; i < n_out; i++)
     {
@@ -262,7 +262,7 @@ struct faust_node_utils
 
   template <typename Node>
   static void copy_output(
-      Node& self, int64_t d, int64_t n_out, float* outputs_, float** output_n,
+      Node& self, int64_t d, int64_t n_out, FAUSTFLOAT* outputs_, FAUSTFLOAT** output_n,
       ossia::audio_port& audio_out)
   {
     audio_out.set_channels(n_out);
@@ -271,7 +271,7 @@ struct faust_node_utils
       audio_out.channel(i).resize(d);
       for(int64_t j = 0; j < d; j++)
       {
-        audio_out.channel(i)[j] = (double)output_n[i][j];
+        audio_out.channel(i)[j] = (ossia::dsp_sample)output_n[i][j];
       }
     }
 
@@ -343,13 +343,13 @@ struct faust_node_utils
     audio_in.set_channels(n_in);
     audio_out.set_channels(n_out);
 
-    if constexpr(std::is_same_v<FAUSTFLOAT, float>)
+    if constexpr(!std::is_same_v<FAUSTFLOAT, ossia::dsp_sample>)
     {
-      float* inputs_ = (float*)alloca(n_in * d * sizeof(float));
-      float* outputs_ = (float*)alloca(n_out * d * sizeof(float));
+      FAUSTFLOAT* inputs_ = (FAUSTFLOAT*)alloca(n_in * d * sizeof(FAUSTFLOAT));
+      FAUSTFLOAT* outputs_ = (FAUSTFLOAT*)alloca(n_out * d * sizeof(FAUSTFLOAT));
 
-      float** input_n = (float**)alloca(sizeof(float*) * n_in);
-      float** output_n = (float**)alloca(sizeof(float*) * n_out);
+      FAUSTFLOAT** input_n = (FAUSTFLOAT**)alloca(sizeof(FAUSTFLOAT*) * n_in);
+      FAUSTFLOAT** output_n = (FAUSTFLOAT**)alloca(sizeof(FAUSTFLOAT*) * n_out);
 
       copy_input(self, d, n_in, inputs_, input_n, audio_in);
       init_output(self, d, n_out, outputs_, output_n);
@@ -358,8 +358,9 @@ struct faust_node_utils
     }
     else
     {
-      double** input_n = (double**)alloca(sizeof(double*) * n_in);
-      double** output_n = (double**)alloca(sizeof(double*) * n_out);
+      // FAUSTFLOAT matches the sample type of the graph: work in place
+      auto input_n = (ossia::dsp_sample**)alloca(sizeof(ossia::dsp_sample*) * n_in);
+      auto output_n = (ossia::dsp_sample**)alloca(sizeof(ossia::dsp_sample*) * n_out);
       for(int i = 0; i < n_in; i++)
       {
         audio_in.channel(i).resize(e.bufferSize());
@@ -437,11 +438,11 @@ struct faust_node_utils
       }
     }
 
-    if constexpr(std::is_same_v<FAUSTFLOAT, float>)
+    if constexpr(!std::is_same_v<FAUSTFLOAT, ossia::dsp_sample>)
     {
-      float* input = (float*)alloca(d * sizeof(float));
-      memset(input, 0, d * sizeof(float));
-      float* output = (float*)alloca(d * sizeof(float));
+      FAUSTFLOAT* input = (FAUSTFLOAT*)alloca(d * sizeof(FAUSTFLOAT));
+      memset(input, 0, d * sizeof(FAUSTFLOAT));
+      FAUSTFLOAT* output = (FAUSTFLOAT*)alloca(d * sizeof(FAUSTFLOAT));
 
       for(int i = 0; i < n_in; i++)
       {
@@ -452,7 +453,7 @@ struct faust_node_utils
         out_chan.resize(e.bufferSize());
 
         copy_input_mono(self, d, n_in, input, in_chan);
-        memset(output, 0, d * sizeof(float));
+        memset(output, 0, d * sizeof(FAUSTFLOAT));
         for(int z = 0; z < d; z++)
         {
           assert(!std::isnan(input[z]));
@@ -482,8 +483,8 @@ struct faust_node_utils
         in_chan.resize(e.bufferSize());
         out_chan.resize(e.bufferSize());
 
-        double* input = in_chan.data() + st;
-        double* output = out_chan.data() + st;
+        ossia::dsp_sample* input = in_chan.data() + st;
+        ossia::dsp_sample* output = out_chan.data() + st;
 
         self.clones[i].fx->compute(d, &input, &output);
       }
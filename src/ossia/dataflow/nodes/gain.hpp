@@ -1,4 +1,5 @@
 #pragma once
+#include <ossia/dataflow/audio_kernels.hpp>
 #include <ossia/dataflow/graph_node.hpp>
 #include <ossia/dataflow/port.hpp>
 
@@ -36,6 +37,7 @@ public:
     const auto channels = in.channels();
     out.set_channels(channels);
 
+    const auto& k = ossia::audio_kernels();
     for(std::size_t i = 0; i < channels; i++)
     {
       auto& in_c = in.channel(i);
@@ -49,16 +51,16 @@ public:
       auto* output = out_c.data();
       if(cur_chan_size < last_pos)
       {
-        for(int64_t j = first_pos; j < cur_chan_size; j++)
-          output[j] = gain * input[j];
+        if(cur_chan_size > first_pos)
+          ossia::audio_copy_gain(
+              k, input + first_pos, output + first_pos, cur_chan_size - first_pos,
+              gain);
 
-        for(int64_t j = cur_chan_size; j < last_pos; j++)
-          output[j] = 0.;
+        std::fill(output + cur_chan_size, output + last_pos, 0.);
       }
       else
       {
-        for(int64_t j = first_pos; j < last_pos; j++)
-          output[j] = gain * input[j];
+        ossia::audio_copy_gain(k, input + first_pos, output + first_pos, N, gain);
       }
     }
   }
@@ -1,5 +1,8 @@
 #pragma once
+#include <ossia/detail/config.hpp>
 
+#include <ossia/dataflow/audio_arena.hpp>
+#include <ossia/detail/pod_vector.hpp>
 #include <ossia/detail/small_vector.hpp>
 #include <ossia/detail/span.hpp>
 
@@ -8,8 +11,19 @@
 
 namespace ossia
 {
-// Used in nodes
-using audio_channel = ossia::pod_vector<double>;
+// Sample type of the audio graph.
+// Single precision halves the memory traffic of the graph and removes the
+// conversions to and from the float buffers of the audio backends.
+#if defined(OSSIA_AUDIO_FLOAT)
+using dsp_sample = float;
+#else
+using dsp_sample = double;
+#endif
+
+// Used in nodes. The channels of an inlet or outlet are allocated from the
+// audio_arena of its port.
+using audio_channel
+    = boost::container::vector<dsp_sample, audio_channel_allocator<dsp_sample>>;
 using audio_vector = ossia::small_vector<audio_channel, 2>;
 
 // Used for audio files
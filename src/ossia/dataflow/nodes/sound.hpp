@@ -194,7 +194,7 @@ struct resampler
   run(T& audio_fetcher, const ossia::token_request& t, ossia::exec_state_facade e,
       double tempo_ratio, std::size_t chan, std::size_t len, int64_t samples_to_read,
       int64_t samples_to_write, int64_t samples_offset,
-      const ossia::mutable_audio_span<double>& ap)
+      const ossia::mutable_audio_span<ossia::dsp_sample>& ap)
   {
     ossia::visit(
         [&](auto& stretcher) {
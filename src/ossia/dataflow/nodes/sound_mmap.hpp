@@ -74,6 +74,8 @@ public:
     m_resampler.transport(to_sample(date, m_handle.sampleRate()));
   }
 
+#if !defined(OSSIA_AUDIO_FLOAT)
+  // The graph runs in double: read through float buffers then widen
   void fetch_audio(
       int64_t start, int64_t samples_to_write, double** audio_array_base) noexcept
   {
@@ -174,6 +176,7 @@ public:
     for(int i = 0; i < channels; i++)
       std::copy_n(audio_array[i], samples_to_write, audio_array_base[i]);
   }
+#endif
 
   void fetch_audio(int64_t start, int64_t samples_to_write, float** audio_array) noexcept
   {
@@ -27,11 +27,13 @@ struct raw_stretcher
   run(T& audio_fetcher, const ossia::token_request& t, const ossia::exec_state_facade e,
       double tempo_ratio, const std::size_t chan, const int64_t len,
       const int64_t samples_to_read, const int64_t samples_to_write,
-      const int64_t samples_offset, const ossia::mutable_audio_span<double>& ap) noexcept
+      const int64_t samples_offset,
+      const ossia::mutable_audio_span<ossia::dsp_sample>& ap) noexcept
   {
     if(t.forward())
     {
-      double** output = (double**)alloca(sizeof(double*) * chan);
+      auto output
+          = (ossia::dsp_sample**)alloca(sizeof(ossia::dsp_sample*) * chan);
       for(std::size_t i = 0; i < chan; i++)
         output[i] = ap[i].data() + samples_offset;
 
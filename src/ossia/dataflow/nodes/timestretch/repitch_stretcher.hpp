@@ -71,7 +71,8 @@ struct repitch_stretcher
   run(T& audio_fetcher, const ossia::token_request& t, ossia::exec_state_facade e,
       double tempo_ratio, const std::size_t chan, const int64_t len,
       int64_t samples_to_read, const int64_t samples_to_write,
-      const int64_t samples_offset, const ossia::mutable_audio_span<double>& ap) noexcept
+      const int64_t samples_offset,
+      const ossia::mutable_audio_span<ossia::dsp_sample>& ap) noexcept
   {
     assert(chan > 0);
 
@@ -131,7 +132,7 @@ struct repitch_stretcher
       auto it = repitchers[i].data.begin();
       for(int j = 0; j < samples_to_write; j++)
       {
-        ap[i][j + samples_offset] = double(*it);
+        ap[i][j + samples_offset] = ossia::dsp_sample(*it);
         ++it;
       }
 
@@ -77,7 +77,8 @@ struct rubberband_stretcher
   run(T& audio_fetcher, const ossia::token_request& t, ossia::exec_state_facade e,
       double tempo_ratio, const std::size_t chan, const std::size_t len,
       int64_t samples_to_read, const int64_t samples_to_write,
-      const int64_t samples_offset, const ossia::mutable_audio_span<double>& ap) noexcept
+      const int64_t samples_offset,
+      const ossia::mutable_audio_span<ossia::dsp_sample>& ap) noexcept
   {
     if(tempo_ratio != m_rubberBand->getTimeRatio())
     {
@@ -114,7 +115,7 @@ struct rubberband_stretcher
       {
         for(int64_t j = 0; j < samples_to_write; j++)
         {
-          ap[i][j + samples_offset] = double(output[i][j]);
+          ap[i][j + samples_offset] = ossia::dsp_sample(output[i][j]);
         }
       }
     }
@@ -0,0 +1,266 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/network/base/parameter.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ossia
+{
+/**
+ * @brief Gives a dense integer slot to each parameter used by an execution state.
+ *
+ * Slots are acquired when ports are registered, and created on first use
+ * for the parameters which are only reached at execution time.
+ * A slot is only given back once every port using it has been unregistered.
+ *
+ * The slot is also cached in the parameter, so that finding it does not
+ * hash the parameter, unless it has slots in several execution states.
+ */
+class parameter_slots
+{
+public:
+  static constexpr int no_slot = -1;
+
+  [[nodiscard]] int find(const ossia::net::parameter_base* p) const noexcept
+  {
+    // The cache may come from another instance, or from a released slot
+    if(const int slot = p->m_slot.load(std::memory_order_relaxed);
+       slot != no_slot && std::size_t(slot) < m_params.size() && m_params[slot] == p)
+      return slot;
+
+    auto it = m_index.find(p);
+    return it != m_index.end() ? it->second : no_slot;
+  }
+
+  int get_or_create(const ossia::net::parameter_base* p)
+  {
+    if(int slot = find(p); slot != no_slot)
+      return slot;
+
+    int slot{};
+    if(!m_free.empty())
+    {
+      slot = m_free.back();
+      m_free.pop_back();
+    }
+    else
+    {
+      slot = m_refcount.size();
+      m_refcount.push_back(0);
+      m_params.push_back(nullptr);
+    }
+    m_index.emplace(p, slot);
+    m_params[slot] = p;
+    p->m_slot.store(slot, std::memory_order_relaxed);
+    return slot;
+  }
+
+  int acquire(const ossia::net::parameter_base* p)
+  {
+    int slot = get_or_create(p);
+    m_refcount[slot]++;
+    return slot;
+  }
+
+  void release(const ossia::net::parameter_base* p)
+  {
+    auto it = m_index.find(p);
+    if(it == m_index.end())
+      return;
+
+    const int slot = it->second;
+    if(--m_refcount[slot] <= 0)
+    {
+      m_refcount[slot] = 0;
+      m_params[slot] = nullptr;
+      m_index.erase(it);
+      m_free.push_back(slot);
+    }
+  }
+
+  //! Upper bound of the slot indices
+  [[nodiscard]] std::size_t size() const noexcept { return m_refcount.size(); }
+
+  void clear()
+  {
+    m_index.clear();
+    m_refcount.clear();
+    m_params.clear();
+    m_free.clear();
+  }
+
+private:
+  ossia::fast_hash_map<const ossia::net::parameter_base*, int> m_index;
+  std::vector<int> m_refcount;
+  std::vector<const ossia::net::parameter_base*> m_params;
+  std::vector<int> m_free;
+};
+
+/**
+ * @brief Per-tick state of the parameters, stored in a flat array indexed by slot.
+ *
+ * Only the parameters written to since the last reset_written() are visible:
+ * iteration goes through the list of written slots, in the order in which they
+ * were first written, and find() ignores the slots which were not written.
+ * The interface mimics the one of a map from parameters to T.
+ */
+template <typename Param, typename T>
+class parameter_slot_map
+{
+public:
+  using value_type = std::pair<Param*, T>;
+
+  explicit parameter_slot_map(parameter_slots& slots) noexcept
+      : m_slots{slots}
+  {
+  }
+
+  template <bool Const>
+  class iterator_impl
+  {
+  public:
+    using map_type
+        = std::conditional_t<Const, const parameter_slot_map, parameter_slot_map>;
+    using reference
+        = std::conditional_t<Const, const value_type&, value_type&>;
+    using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+    iterator_impl(map_type& map, std::size_t pos) noexcept
+        : m_map{&map}
+        , m_pos{pos}
+    {
+    }
+
+    reference operator*() const noexcept
+    {
+      return m_map->m_values[m_map->m_written[m_pos]];
+    }
+    pointer operator->() const noexcept { return &**this; }
+
+    iterator_impl& operator++() noexcept
+    {
+      ++m_pos;
+      return *this;
+    }
+
+    bool operator==(const iterator_impl& other) const noexcept
+    {
+      return m_pos == other.m_pos;
+    }
+    bool operator!=(const iterator_impl& other) const noexcept
+    {
+      return m_pos != other.m_pos;
+    }
+
+  private:
+    friend class parameter_slot_map;
+    map_type* m_map{};
+    std::size_t m_pos{};
+  };
+
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  iterator begin() noexcept { return {*this, 0}; }
+  iterator end() noexcept { return {*this, m_written.size()}; }
+  const_iterator begin() const noexcept { return {*this, 0}; }
+  const_iterator end() const noexcept { return {*this, m_written.size()}; }
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_written.size(); }
+  [[nodiscard]] bool empty() const noexcept { return m_written.empty(); }
+
+  iterator find(const Param* p) noexcept
+  {
+    const int slot = m_slots.find(p);
+    if(slot == parameter_slots::no_slot || !is_written(slot))
+      return end();
+    return {*this, m_position[slot]};
+  }
+
+  const_iterator find(const Param* p) const noexcept
+  {
+    const int slot = m_slots.find(p);
+    if(slot == parameter_slots::no_slot || !is_written(slot))
+      return end();
+    return {*this, m_position[slot]};
+  }
+
+  //! Marks the parameter as written and returns its state
+  T& operator[](Param* p) { return at_slot(m_slots.get_or_create(p), p); }
+
+  T& at_slot(int slot, Param* p)
+  {
+    if(std::size_t(slot) >= m_values.size())
+    {
+      m_values.resize(slot + 1);
+      m_position.resize(slot + 1, no_position);
+    }
+
+    auto& v = m_values[slot];
+    if(!is_written(slot))
+    {
+      m_position[slot] = m_written.size();
+      m_written.push_back(slot);
+    }
+
+    // The slot may have been released and given to another parameter
+    // since it was first written in this tick
+    v.first = p;
+    return v.second;
+  }
+
+  //! Allocates the storage of every known slot
+  void reserve_slots()
+  {
+    const std::size_t n = m_slots.size();
+    if(n > m_values.size())
+    {
+      m_values.resize(n);
+      m_position.resize(n, no_position);
+    }
+  }
+
+  void reserve(std::size_t n)
+  {
+    m_values.reserve(n);
+    m_position.reserve(n);
+    m_written.reserve(n);
+  }
+
+  /**
+   * Forgets which parameters were written. The states are kept
+   * as they are to reuse their memory: they are expected to have been
+   * emptied, which is what the commit functions do.
+   */
+  void reset_written() noexcept
+  {
+    for(int slot : m_written)
+      m_position[slot] = no_position;
+    m_written.clear();
+  }
+
+  //! Releases everything
+  void clear()
+  {
+    m_values.clear();
+    m_position.clear();
+    m_written.clear();
+  }
+
+private:
+  static constexpr uint32_t no_position = UINT32_MAX;
+
+  bool is_written(int slot) const noexcept
+  {
+    return std::size_t(slot) < m_position.size() && m_position[slot] != no_position;
+  }
+
+  parameter_slots& m_slots;
+  std::vector<value_type> m_values;
+  std::vector<uint32_t> m_position;
+  std::vector<int> m_written;
+};
+}
@@ -2,6 +2,7 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
 #include <ossia/audio/audio_parameter.hpp>
+#include <ossia/dataflow/audio_kernels.hpp>
 #include <ossia/dataflow/dataflow.hpp>
 #include <ossia/dataflow/execution_state.hpp>
 #include <ossia/dataflow/port.hpp>
@@ -203,16 +204,11 @@ void process_audio_out_mono(ossia::audio_port& i, ossia::audio_outlet& audio_out
   ossia::audio_port& o = *audio_out;
   const double g = audio_out.gain;
 
-  ensure_vector_sizes(i.get(), audio_out.data.get());
+  ensure_vector_sizes(i.get(), audio_out.data);
 
-  const auto N = i.channel(0).size();
-  const auto i_ptr = i.channel(0).data();
-  const auto o_ptr = o.channel(0).data();
-
-  for(std::size_t sample = 0; sample < N; sample++)
-  {
-    o_ptr[sample] = i_ptr[sample] * g;
-  }
+  audio_copy_gain(
+      audio_kernels(), i.channel(0).data(), o.channel(0).data(), i.channel(0).size(),
+      g);
 }
 
 void process_audio_out_general(ossia::audio_port& i, ossia::audio_outlet& audio_out)
@@ -224,8 +220,9 @@ void process_audio_out_general(ossia::audio_port& i, ossia::audio_outlet& audio_
   while(audio_out.pan.size() < C)
     audio_out.pan.push_back(1.);
 
-  ensure_vector_sizes(i.get(), audio_out.data.get());
+  ensure_vector_sizes(i.get(), audio_out.data);
 
+  const auto& k = audio_kernels();
   for(auto chan = 0U; chan < C; chan++)
   {
     auto N = i.channel(chan).size();
@@ -235,19 +232,9 @@ void process_audio_out_general(ossia::audio_port& i, ossia::audio_outlet& audio_
 
     const auto vol = audio_out.pan[chan] * g;
     if(vol == 1.)
-    {
-      for(std::size_t sample = 0; sample < N; sample++)
-      {
-        o_ptr[sample] = i_ptr[sample];
-      }
-    }
+      std::copy_n(i_ptr, N, o_ptr);
     else
-    {
-      for(std::size_t sample = 0; sample < N; sample++)
-      {
-        o_ptr[sample] = i_ptr[sample] * vol;
-      }
-    }
+      audio_copy_gain(k, i_ptr, o_ptr, N, vol);
   }
 }
 
@@ -259,13 +246,8 @@ void process_audio_out_mono(ossia::audio_outlet& audio_out)
   if(g == 1.)
     return;
 
-  const auto N = o.channel(0).size();
-  const auto o_ptr = o.channel(0).data();
-
-  for(std::size_t sample = 0; sample < N; sample++)
-  {
-    o_ptr[sample] *= g;
-  }
+  auto& chan = o.channel(0);
+  audio_copy_gain(audio_kernels(), chan.data(), chan.data(), chan.size(), g);
 }
 
 void process_audio_out_general(ossia::audio_outlet& audio_out)
@@ -277,19 +259,15 @@ void process_audio_out_general(ossia::audio_outlet& audio_out)
   while(audio_out.pan.size() < C)
     audio_out.pan.push_back(1.);
 
+  const auto& k = audio_kernels();
   for(auto chan = 0U; chan < C; chan++)
   {
-    auto N = o.channel(chan).size();
-
-    auto o_ptr = o.channel(chan).data();
+    auto& samples = o.channel(chan);
 
     const auto vol = audio_out.pan[chan] * g;
     if(vol == 1.)
       continue;
-    for(std::size_t sample = 0; sample < N; sample++)
-    {
-      o_ptr[sample] *= vol;
-    }
+    audio_copy_gain(k, samples.data(), samples.data(), samples.size(), vol);
   }
 }
 
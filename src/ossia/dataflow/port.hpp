@@ -177,7 +177,7 @@ struct OSSIA_EXPORT audio_inlet : public ossia::inlet
     return audio_port::which;
   }
 
-  ossia::audio_port data;
+  ossia::audio_port data{ossia::audio_port::with_arena};
 };
 
 struct OSSIA_EXPORT midi_inlet : public ossia::inlet
@@ -298,7 +298,7 @@ struct OSSIA_EXPORT audio_outlet : public ossia::outlet
   ossia::value_inlet gain_inlet;
   ossia::value_inlet pan_inlet;
 
-  ossia::audio_port data;
+  ossia::audio_port data{ossia::audio_port::with_arena};
   bool has_gain{};
 
 private:
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <ossia/dataflow/audio_kernels.hpp>
 #include <ossia/dataflow/nodes/media.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 
@@ -68,11 +70,52 @@ inline void read_u8(ossia::mutable_audio_span<float>& ap, void* data, int64_t sa
   }
 }
 
+namespace detail
+{
+// Converts chunks of interleaved frames to float on the stack,
+// then deinterleaves them into the channels.
+// Returns false when there are too many channels for the stack buffers.
+template <typename SampleFormat, typename Convert>
+inline bool read_chunked(
+    ossia::mutable_audio_span<float>& ap, const SampleFormat* d, int64_t samples,
+    Convert convert)
+{
+  static constexpr std::size_t chunk_samples = 1024;
+  static constexpr std::size_t max_channels = 64;
+
+  const std::size_t channels = ap.size();
+  if(channels == 0 || channels > max_channels)
+    return false;
+
+  const auto& k = audio_kernels();
+  alignas(32) float tmp[chunk_samples];
+  float* out[max_channels];
+  const int64_t frames = chunk_samples / channels;
+  for(int64_t pos = 0; pos < samples; pos += frames)
+  {
+    const int64_t count = std::min(frames, samples - pos);
+    for(std::size_t c = 0; c < channels; c++)
+      out[c] = ap[c].data() + pos;
+
+    convert(k, d + pos * channels, tmp, count * channels);
+    k.deinterleave(tmp, out, channels, count);
+  }
+  return true;
+}
+}
+
 inline void read_s16(ossia::mutable_audio_span<float>& ap, void* data, int64_t samples)
 {
   const auto channels = ap.size();
   auto d = reinterpret_cast<int16_t*>(data);
 
+  if(detail::read_chunked(
+         ap, d, samples,
+         [](const audio_kernel_table& k, const int16_t* in, float* out, std::size_t n) {
+    k.s16_to_float(in, out, n);
+  }))
+    return;
+
   for(int64_t j = 0; j < samples; j++)
   {
     for(std::size_t i = 0; i < channels; i++)
@@ -108,6 +151,13 @@ inline void read_s32(ossia::mutable_audio_span<float>& ap, void* data, int64_t s
   const auto channels = ap.size();
   auto d = reinterpret_cast<int32_t*>(data);
 
+  if(detail::read_chunked(
+         ap, d, samples,
+         [](const audio_kernel_table& k, const int32_t* in, float* out, std::size_t n) {
+    k.s32_to_float(in, out, n);
+  }))
+    return;
+
   for(int64_t j = 0; j < samples; j++)
   {
     for(std::size_t i = 0; i < channels; i++)
@@ -122,6 +172,15 @@ inline void read_f32(ossia::mutable_audio_span<float>& ap, void* data, int64_t s
   const auto channels = ap.size();
   auto d = reinterpret_cast<float*>(data);
 
+  if(channels > 0 && channels <= 64)
+  {
+    float* out[64];
+    for(std::size_t c = 0; c < channels; c++)
+      out[c] = ap[c].data();
+    audio_kernels().deinterleave(d, out, channels, samples);
+    return;
+  }
+
   for(int64_t j = 0; j < samples; j++)
   {
     for(std::size_t i = 0; i < channels; i++)
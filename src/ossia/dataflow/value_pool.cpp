@@ -0,0 +1,109 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <ossia/dataflow/value_pool.hpp>
+#include <ossia/detail/algorithms.hpp>
+
+namespace ossia
+{
+namespace
+{
+// Capacity of a std::string which does not allocate
+const std::size_t inline_string_capacity = std::string{}.capacity();
+
+bool has_buffer(const ossia::value& v) noexcept
+{
+  const auto t = v.get_type();
+  return t == ossia::val_type::LIST || t == ossia::val_type::STRING;
+}
+
+template <typename T>
+T take_buffer(std::vector<T>& pool, std::size_t size)
+{
+  // The values of a port tend to keep the same sizes from one tick to the
+  // next: the last buffer given back is taken, and only grown if needed.
+  T buffer;
+  if(!pool.empty())
+  {
+    buffer = std::move(pool.back());
+    pool.pop_back();
+  }
+  buffer.reserve(size);
+  return buffer;
+}
+}
+
+std::vector<ossia::value> value_pool::take_list(std::size_t size)
+{
+  return take_buffer(m_lists, size);
+}
+
+std::string value_pool::take_string(std::size_t size)
+{
+  return take_buffer(m_strings, size);
+}
+
+ossia::value value_pool::copy(const ossia::value& v)
+{
+  switch(v.get_type())
+  {
+    case ossia::val_type::LIST: {
+      const auto& src = v.get<std::vector<ossia::value>>();
+      auto list = take_list(src.size());
+      if(ossia::any_of(src, has_buffer))
+      {
+        for(const auto& elt : src)
+          list.push_back(copy(elt));
+      }
+      else
+      {
+        // Flat list: copied in a single pass
+        list.assign(src.begin(), src.end());
+      }
+      return ossia::value{std::move(list)};
+    }
+    case ossia::val_type::STRING: {
+      const auto& src = v.get<std::string>();
+      if(src.size() <= inline_string_capacity)
+        return v;
+
+      auto str = take_string(src.size());
+      str.assign(src);
+      return ossia::value{std::move(str)};
+    }
+    default:
+      return v;
+  }
+}
+
+void value_pool::assign(ossia::value& dst, const ossia::value& src)
+{
+  recycle(dst);
+  dst = copy(src);
+}
+
+void value_pool::recycle(ossia::value& v)
+{
+  switch(v.get_type())
+  {
+    case ossia::val_type::LIST: {
+      auto& list = v.get<std::vector<ossia::value>>();
+      for(auto& elt : list)
+        if(has_buffer(elt))
+          recycle(elt);
+      list.clear();
+      if(list.capacity() > 0 && m_lists.size() < max_pooled)
+        m_lists.push_back(std::move(list));
+      break;
+    }
+    case ossia::val_type::STRING: {
+      auto& str = v.get<std::string>();
+      str.clear();
+      if(str.capacity() > inline_string_capacity && m_strings.size() < max_pooled)
+        m_strings.push_back(std::move(str));
+      break;
+    }
+    default:
+      break;
+  }
+}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+
+#include <ossia/network/value/value.hpp>
+
+#include <string>
+#include <vector>
+
+namespace ossia
+{
+/**
+ * @brief Recycles the heap storage of list and string values.
+ *
+ * Values flowing through the ports of the graph are copied and destroyed
+ * at each tick. A value_pool keeps the buffers of the lists and strings it
+ * is given back, and copies the next values into them: once the pool has
+ * seen a tick, the following ticks with lists and strings of the same
+ * sizes do not allocate.
+ *
+ * Strings short enough to be stored inline are neither pooled nor
+ * allocated. The pool holds at most max_pooled lists and max_pooled
+ * strings.
+ */
+class OSSIA_EXPORT value_pool
+{
+public:
+  static constexpr std::size_t max_pooled = 256;
+
+  //! A copy of v, whose lists and strings use pooled buffers when possible.
+  ossia::value copy(const ossia::value& v);
+
+  //! Replaces dst by a copy of src, recycling the buffers of dst.
+  void assign(ossia::value& dst, const ossia::value& src);
+
+  //! Takes back the buffers of the lists and strings of v.
+  //! v is left with empty lists and strings.
+  void recycle(ossia::value& v);
+
+  //! Number of buffers available for the next copies
+  [[nodiscard]] std::size_t pooled_lists() const noexcept { return m_lists.size(); }
+  [[nodiscard]] std::size_t pooled_strings() const noexcept { return m_strings.size(); }
+
+private:
+  std::vector<ossia::value> take_list(std::size_t size);
+  std::string take_string(std::size_t size);
+
+  std::vector<std::vector<ossia::value>> m_lists;
+  std::vector<std::string> m_strings;
+};
+}
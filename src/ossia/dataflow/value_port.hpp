@@ -1,6 +1,7 @@
 #pragma once
 #include <ossia/dataflow/timed_value.hpp>
 #include <ossia/dataflow/typed_value.hpp>
+#include <ossia/dataflow/value_pool.hpp>
 #include <ossia/dataflow/value_vector.hpp>
 #include <ossia/editor/scenario/time_value.hpp>
 #include <ossia/network/common/complex_type.hpp>
@@ -51,6 +52,9 @@ struct OSSIA_EXPORT value_port
 
 private:
   value_vector<ossia::timed_value> data;
+
+  // Buffers of the lists and strings of the previous ticks
+  ossia::value_pool pool;
 };
 
 struct value_delay_line
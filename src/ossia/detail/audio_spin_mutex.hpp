@@ -38,6 +38,11 @@
 
 namespace ossia
 {
+//! Tells the CPU that the calling thread is spin-waiting
+inline void cpu_pause() noexcept
+{
+  ossia_rwlock_pause();
+}
 
 // Code adapted from Timur Doumler's great article:
 // https://timur.audio/using-locks-in-real-time-audio-processing-safely
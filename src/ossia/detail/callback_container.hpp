@@ -3,9 +3,14 @@
 
 #include <ossia/detail/audio_spin_mutex.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 /**
  * \file callback_container.hpp
@@ -43,34 +48,67 @@ template <typename T>
  *
  * This allows to cleanly stop listening when there are no callbacks.
  *
+ * The callbacks are invoked from an immutable snapshot of the callback list,
+ * which is replaced (read-copy-update) when callbacks are added or removed:
+ * send() only locks to take the current snapshot, so it never waits for a
+ * thread adding callbacks, and adding callbacks never waits for send().
+ * Removing or replacing a callback waits until the calls to send() which
+ * may still be using it are finished, so that the callback can be destroyed
+ * safely. Hence a callback must not remove callbacks from the container
+ * which is invoking it.
  */
 class callback_container
 {
   using mutex = ossia::audio_spin_mutex;
   using lock_guard = std::lock_guard<ossia::audio_spin_mutex>;
+  using write_lock = std::lock_guard<ossia::mutex_t>;
 
 public:
   callback_container() = default;
   callback_container(const callback_container& other)
   {
-    lock_guard lck{other.m_mutx};
+    write_lock lck{other.m_write_mutx};
     m_callbacks = other.m_callbacks;
+    publish(make_snapshot());
   }
   callback_container(callback_container&& other) noexcept
   {
-    lock_guard lck{other.m_mutx};
+    write_lock lck{other.m_write_mutx};
+    // The snapshots stay valid: moving a list does not move its elements
     m_callbacks = std::move(other.m_callbacks);
+    {
+      lock_guard snapshot_lck{other.m_mutx};
+      m_snapshot = std::move(other.m_snapshot);
+    }
+    m_retired = std::move(other.m_retired);
   }
   callback_container& operator=(const callback_container& other)
   {
-    lock_guard lck{other.m_mutx};
+    if(this == &other)
+      return *this;
+
+    write_lock lck{other.m_write_mutx};
+    write_lock self_lck{m_write_mutx};
+    impl old = std::move(m_callbacks);
     m_callbacks = other.m_callbacks;
+    publish(make_snapshot());
+    synchronize();
     return *this;
   }
   callback_container& operator=(callback_container&& other) noexcept
   {
-    lock_guard lck{other.m_mutx};
+    if(this == &other)
+      return *this;
+
+    write_lock lck{other.m_write_mutx};
+    write_lock self_lck{m_write_mutx};
+    impl old = std::move(m_callbacks);
     m_callbacks = std::move(other.m_callbacks);
+    // other's snapshot refers to the callbacks which are now ours
+    other.publish({});
+    other.synchronize();
+    publish(make_snapshot());
+    synchronize();
     return *this;
   }
 
@@ -93,8 +131,9 @@ public:
   {
     if(callback)
     {
-      lock_guard lck{m_mutx};
+      write_lock lck{m_write_mutx};
       auto it = m_callbacks.insert(m_callbacks.begin(), std::move(callback));
+      publish(make_snapshot());
       if(m_callbacks.size() == 1)
         on_first_callback_added();
       return it;
@@ -111,9 +150,11 @@ public:
    */
   void remove_callback(iterator it)
   {
-    lock_guard lck{m_mutx};
+    write_lock lck{m_write_mutx};
     if(m_callbacks.size() == 1)
       on_removing_last_callback();
+    publish(make_snapshot(&*it));
+    synchronize();
     m_callbacks.erase(it);
   }
 
@@ -122,13 +163,19 @@ public:
    */
   void replace_callback(iterator it, T&& cb)
   {
-    lock_guard lck{m_mutx};
-    *m_callbacks.erase(it, it) = std::move(cb);
+    write_lock lck{m_write_mutx};
+    publish(make_snapshot(&*it));
+    synchronize();
+    *it = std::move(cb);
+    publish(make_snapshot());
   }
   void replace_callbacks(impl&& cbs)
   {
-    lock_guard lck{m_mutx};
+    write_lock lck{m_write_mutx};
+    impl old = std::move(m_callbacks);
     m_callbacks = std::move(cbs);
+    publish(make_snapshot());
+    synchronize();
   }
 
   class disabled_callback
@@ -149,11 +196,13 @@ public:
 
   disabled_callback disable_callback(iterator it)
   {
-    lock_guard lck{m_mutx};
+    write_lock lck{m_write_mutx};
     disabled_callback dis{*this};
 
     // TODO should we also call on_removing_last_blah ?
     // I don't think so : it's supposed to be a short operation
+    publish(make_snapshot(&*it));
+    synchronize();
     m_callbacks.erase(it);
     return dis;
   }
@@ -165,7 +214,7 @@ public:
   std::size_t callback_count() const
   {
     lock_guard lck{m_mutx};
-    return m_callbacks.size();
+    return m_snapshot ? m_snapshot->callbacks.size() : 0;
   }
 
   /**
@@ -175,7 +224,7 @@ public:
   bool callbacks_empty() const
   {
     lock_guard lck{m_mutx};
-    return m_callbacks.empty();
+    return !m_snapshot;
   }
 
   /**
@@ -185,11 +234,25 @@ public:
   template <typename... Args>
   void send(Args&&... args)
   {
-    lock_guard lck{m_mutx};
-    for(auto& callback : m_callbacks)
+    snapshot_t* cbs{};
     {
-      if(callback)
-        callback(std::forward<Args>(args)...);
+      lock_guard lck{m_mutx};
+      if(!m_snapshot)
+        return;
+      cbs = m_snapshot.get();
+      cbs->readers.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    struct reader_guard
+    {
+      snapshot_t& s;
+      ~reader_guard() { s.readers.fetch_sub(1, std::memory_order_release); }
+    } guard{*cbs};
+
+    for(T* callback : cbs->callbacks)
+    {
+      if(*callback)
+        (*callback)(args...);
     }
   }
 
@@ -198,9 +261,11 @@ public:
    */
   void callbacks_clear()
   {
-    lock_guard lck{m_mutx};
+    write_lock lck{m_write_mutx};
     if(!m_callbacks.empty())
       on_removing_last_callback();
+    publish({});
+    synchronize();
     m_callbacks.clear();
   }
 
@@ -225,7 +290,60 @@ protected:
   virtual void on_removing_last_callback() { }
 
 private:
-  impl m_callbacks TS_GUARDED_BY(m_mutx);
+  //! The callbacks invoked by send(), and the number of send() using them
+  struct snapshot_t
+  {
+    std::vector<T*> callbacks;
+    std::atomic<int> readers{};
+  };
+
+  std::unique_ptr<snapshot_t>
+  make_snapshot(const T* excluded = nullptr) TS_REQUIRES(m_write_mutx)
+  {
+    if(m_callbacks.empty() || (m_callbacks.size() == 1 && excluded))
+      return {};
+
+    auto cbs = std::make_unique<snapshot_t>();
+    cbs->callbacks.reserve(m_callbacks.size());
+    for(auto& cb : m_callbacks)
+      if(&cb != excluded)
+        cbs->callbacks.push_back(&cb);
+    return cbs;
+  }
+
+  //! Makes cbs the snapshot used by the next calls to send().
+  //! The previous snapshot is freed once no send() uses it anymore.
+  void publish(std::unique_ptr<snapshot_t> cbs) TS_REQUIRES(m_write_mutx)
+  {
+    {
+      lock_guard lck{m_mutx};
+      std::swap(m_snapshot, cbs);
+    }
+
+    if(cbs)
+      m_retired.push_back(std::move(cbs));
+
+    auto unused = [](const auto& s) {
+      return s->readers.load(std::memory_order_acquire) == 0;
+    };
+    m_retired.erase(
+        std::remove_if(m_retired.begin(), m_retired.end(), unused), m_retired.end());
+  }
+
+  //! Waits until no call to send() uses a previous snapshot anymore.
+  void synchronize() TS_REQUIRES(m_write_mutx)
+  {
+    for(auto& s : m_retired)
+      while(s->readers.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+    m_retired.clear();
+  }
+
+  impl m_callbacks TS_GUARDED_BY(m_write_mutx);
+  std::vector<std::unique_ptr<snapshot_t>> m_retired TS_GUARDED_BY(m_write_mutx);
+  mutable ossia::mutex_t m_write_mutx;
+
+  std::unique_ptr<snapshot_t> m_snapshot TS_GUARDED_BY(m_mutx);
   mutable ossia::audio_spin_mutex m_mutx;
 };
 }
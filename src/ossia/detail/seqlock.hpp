@@ -0,0 +1,73 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ossia
+{
+/**
+ * @brief Sequence lock for a small trivially copyable object.
+ *
+ * Readers never block the writer: they copy the object and retry if a
+ * write happened meanwhile. The object is stored in atomic words so that
+ * the copies are not data races.
+ *
+ * store() must not be called by more than one thread at a time:
+ * writers have to be serialized by the caller.
+ */
+template <typename T>
+class seqlock
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  static constexpr std::size_t words
+      = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+public:
+  seqlock() noexcept { store(T{}); }
+  explicit seqlock(const T& v) noexcept { store(v); }
+  seqlock(const seqlock&) = delete;
+  seqlock& operator=(const seqlock&) = delete;
+
+  void store(const T& v) noexcept
+  {
+    uint32_t buf[words]{};
+    std::memcpy(buf, &v, sizeof(T));
+
+    const auto seq = m_seq.load(std::memory_order_relaxed);
+    m_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(std::size_t i = 0; i < words; i++)
+      m_data[i].store(buf[i], std::memory_order_relaxed);
+    m_seq.store(seq + 2, std::memory_order_release);
+  }
+
+  T load() const noexcept
+  {
+    uint32_t buf[words];
+    for(;;)
+    {
+      const auto seq = m_seq.load(std::memory_order_acquire);
+      if(seq & 1) // A write is in progress
+        continue;
+
+      for(std::size_t i = 0; i < words; i++)
+        buf[i] = m_data[i].load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(m_seq.load(std::memory_order_relaxed) == seq)
+        break;
+    }
+
+    T v;
+    std::memcpy(&v, buf, sizeof(T));
+    return v;
+  }
+
+private:
+  std::atomic<uint32_t> m_seq{};
+  std::atomic<uint32_t> m_data[words]{};
+};
+}
@@ -18,6 +18,21 @@ void set_thread_realtime(std::thread& t)
   SetThreadPriority(hdl, THREAD_PRIORITY_TIME_CRITICAL);
 }
 
+void set_thread_realtime(std::thread& t, int priority)
+{
+  auto hdl = t.native_handle();
+
+  SetThreadPriority(
+      hdl, priority >= 90 ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST);
+}
+
+void set_thread_pinned(std::thread& t, int cpu)
+{
+  if(cpu < 0 || cpu >= int(sizeof(DWORD_PTR) * 8))
+    return;
+  SetThreadAffinityMask(t.native_handle(), DWORD_PTR(1) << cpu);
+}
+
 int get_pid()
 {
   return GetCurrentProcessId();
@@ -26,18 +41,36 @@ int get_pid()
 #else
 
 #include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 namespace ossia
 {
 void set_thread_realtime(std::thread& t)
+{
+  set_thread_realtime(t, 99);
+}
+
+void set_thread_realtime(std::thread& t, int priority)
 {
 #if !defined(__EMSCRIPTEN__) && !defined(_WIN32)
   sched_param sch_params;
-  sch_params.sched_priority = 99;
+  sch_params.sched_priority = priority;
   pthread_setschedparam(t.native_handle(), SCHED_FIFO, &sch_params);
 #endif
 }
 
+void set_thread_pinned(std::thread& t, int cpu)
+{
+#if defined(__linux__) && !defined(__ANDROID__)
+  if(cpu < 0 || cpu >= CPU_SETSIZE)
+    return;
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+  pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &cpuset);
+#endif
+}
+
 int get_pid()
 {
   return getpid();
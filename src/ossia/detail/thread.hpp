@@ -9,6 +9,14 @@ namespace ossia
 OSSIA_EXPORT
 void set_thread_realtime(std::thread& t);
 
+//! Sets the thread to SCHED_FIFO with the given priority (1-99)
+OSSIA_EXPORT
+void set_thread_realtime(std::thread& t, int priority);
+
+//! Restricts the thread to the given CPU core
+OSSIA_EXPORT
+void set_thread_pinned(std::thread& t, int cpu);
+
 OSSIA_EXPORT
 std::string get_exe_path();
 
@@ -8,11 +8,16 @@
 #include <ossia/editor/curve/curve_abstract.hpp>
 #include <ossia/editor/curve/curve_segment.hpp>
 #include <ossia/editor/curve/curve_segment/easing.hpp>
+#include <ossia/editor/curve/curve_segment/linear.hpp>
+#include <ossia/editor/curve/curve_segment/power.hpp>
 #include <ossia/network/base/node.hpp>
 #include <ossia/network/base/parameter.hpp>
 #include <ossia/network/value/destination.hpp>
 #include <ossia/network/value/value.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <functional>
 #include <map>
 #include <memory>
@@ -57,6 +62,64 @@ CLANG_BUGGY_STATIC_VARIABLE_TEMPLATE const constexpr ossia::curve_segment_type
 template <typename K, typename V>
 using curve_map = ossia::flat_map<K, V>;
 
+/**
+ * @brief How a segment of a curve is evaluated.
+ *
+ * Segments added as a curve_segment_linear, curve_segment_power or
+ * curve_segment_ease are evaluated inline by the curve; the others go
+ * through their type-erased curve_segment.
+ */
+struct curve_segment_kind
+{
+  enum class type : uint8_t
+  {
+    generic,
+    linear,
+    power,
+    ease
+  } kind{type::generic};
+
+  double power{};
+  double (*easing)(double){};
+
+  template <typename Y>
+  Y operator()(
+      const curve_segment<Y>& segment, double ratio, Y start, Y end) const
+  {
+    switch(kind)
+    {
+      case type::linear:
+        return ossia::easing::ease{}(start, end, ratio);
+      case type::power:
+        return start + std::pow(ratio, power) * (end - start);
+      case type::ease:
+        return ossia::easing::ease{}(start, end, easing(ratio));
+      default:
+        return segment(ratio, start, end);
+    }
+  }
+};
+
+template <typename Y, typename Segment>
+constexpr curve_segment_kind make_curve_segment_kind(const Segment& s) noexcept
+{
+  if constexpr(std::is_same_v<Segment, curve_segment_linear<Y>>)
+    return {curve_segment_kind::type::linear};
+  else if constexpr(std::is_same_v<Segment, typename curve_segment_power<Y>::segment>)
+    return {curve_segment_kind::type::power, s.power};
+  else
+    return {};
+}
+
+template <typename Y, typename Easing>
+constexpr curve_segment_kind
+make_curve_segment_kind(const curve_segment_ease<Y, Easing>&) noexcept
+{
+  return {
+      curve_segment_kind::type::ease, 0.,
+      [](double t) -> double { return Easing{}(t); }};
+}
+
 template <typename X, typename Y>
 /**
  * @brief The curve class
@@ -80,6 +143,7 @@ public:
     m_y0_destination = other.m_y0_destination;
 
     m_points = other.m_points;
+    m_kinds = other.m_kinds;
 
     m_y0_cacheUsed = false;
   }
@@ -91,6 +155,7 @@ public:
     m_y0_destination = std::move(other.m_y0_destination);
 
     m_points = std::move(other.m_points);
+    m_kinds = std::move(other.m_kinds);
 
     m_y0_cacheUsed = false;
   }
@@ -102,6 +167,8 @@ public:
     m_y0_destination = other.m_y0_destination;
 
     m_points = other.m_points;
+    m_kinds = other.m_kinds;
+    m_cursor.store(0, std::memory_order_relaxed);
 
     m_y0_cacheUsed = false;
     return *this;
@@ -113,6 +180,8 @@ public:
     m_y0_destination = std::move(other.m_y0_destination);
 
     m_points = std::move(other.m_points);
+    m_kinds = std::move(other.m_kinds);
+    m_cursor.store(0, std::memory_order_relaxed);
 
     m_y0_cacheUsed = false;
     return *this;
@@ -129,16 +198,35 @@ public:
  \return bool */
   bool add_point(ossia::curve_segment<Y>&& segment, X abscissa, Y value);
 
+  /*! add a segment given as a function object.
+ \details linear, power and easing segments are evaluated without going
+ through curve_segment. */
+  template <typename Segment>
+  bool add_point(Segment&& segment, X abscissa, Y value);
+
   /*! remove a point from the curve
  \param X point abscissa
  \return bool */
   bool remove_point(X abscissa);
 
   /*! get value at an abscissa
+ \details the segment is found by binary search, except when the abscissa
+ is in the segment of the previous call or in the next one, which is the
+ case during playback.
  \param X abscissa.
  \return Y ordinate */
   Y value_at(X abscissa) const;
 
+  /*! get the values at n regularly spaced abscissas
+ \details out[k] = value_at(start + k * step). With a positive step the curve
+ is walked once, one segment after the other, and the kind of each segment
+ is dispatched once per segment instead of once per value.
+ \param X first abscissa.
+ \param X distance between two abscissas.
+ \param T* n outputs */
+  template <typename T>
+  void values_at(X start, X step, T* out, std::size_t n) const;
+
   ossia::curve_type get_type() const override;
 
   /*! get initial point abscissa
@@ -181,11 +269,20 @@ public:
       const ossia::value& value, ossia::destination_index::const_iterator idx);
 
 private:
+  std::size_t find_segment(X abscissa) const noexcept;
+
+  bool insert_point(
+      ossia::curve_segment<Y>&& segment, curve_segment_kind kind, X abscissa, Y value);
+
   mutable X m_x0;
   mutable Y m_y0;
   mutable std::optional<ossia::destination> m_y0_destination;
 
   mutable map_type m_points;
+  // Same order as m_points
+  std::vector<curve_segment_kind> m_kinds;
+  // Index in m_points of the end of the last evaluated segment
+  mutable std::atomic_size_t m_cursor{};
 
   mutable Y m_y0_cache;
 
@@ -198,48 +295,169 @@ inline void curve<X, Y>::reset()
   m_y0_cacheUsed = false;
 }
 
+template <typename X, typename Y>
+inline bool curve<X, Y>::insert_point(
+    ossia::curve_segment<Y>&& segment, curve_segment_kind kind, X abscissa, Y value)
+{
+  auto [it, inserted]
+      = m_points.emplace(abscissa, std::make_pair(value, std::move(segment)));
+  if(inserted)
+    m_kinds.insert(m_kinds.begin() + (it - m_points.begin()), kind);
+
+  return true;
+}
+
 template <typename X, typename Y>
 inline bool
 curve<X, Y>::add_point(ossia::curve_segment<Y>&& segment, X abscissa, Y value)
 {
-  m_points.emplace(abscissa, std::make_pair(value, std::move(segment)));
+  return insert_point(std::move(segment), {}, abscissa, value);
+}
 
-  return true;
+template <typename X, typename Y>
+template <typename Segment>
+inline bool curve<X, Y>::add_point(Segment&& segment, X abscissa, Y value)
+{
+  const auto kind = make_curve_segment_kind<Y>(segment);
+  return insert_point(
+      ossia::curve_segment<Y>{std::forward<Segment>(segment)}, kind, abscissa, value);
 }
 
 template <typename X, typename Y>
 inline bool curve<X, Y>::remove_point(X abscissa)
 {
-  return m_points.erase(abscissa) > 0;
+  auto it = m_points.find(abscissa);
+  if(it == m_points.end())
+    return false;
+
+  m_kinds.erase(m_kinds.begin() + (it - m_points.begin()));
+  m_points.erase(it);
+  m_cursor.store(0, std::memory_order_relaxed);
+  return true;
+}
+
+template <typename X, typename Y>
+inline std::size_t curve<X, Y>::find_segment(X abscissa) const noexcept
+{
+  // The segment ending on the first point at or after the abscissa
+  const std::size_t n = m_points.size();
+  const auto points = m_points.begin();
+  const auto in_segment = [&](std::size_t i) {
+    return (i == 0 || points[i - 1].first < abscissa)
+           && (i == n || abscissa <= points[i].first);
+  };
+
+  std::size_t i = m_cursor.load(std::memory_order_relaxed);
+  if(i > n || !in_segment(i))
+  {
+    if(i < n && in_segment(i + 1))
+      ++i;
+    else
+      i = m_points.lower_bound(abscissa) - points;
+    m_cursor.store(i, std::memory_order_relaxed);
+  }
+  return i;
 }
 
 template <typename X, typename Y>
 inline Y curve<X, Y>::value_at(X abscissa) const
 {
-  X lastAbscissa = get_x0();
-  Y lastValue = get_y0();
+  // Always read y0 so that a destination is fetched on the first call
+  const X x0 = get_x0();
+  const Y y0 = get_y0();
+
+  const std::size_t n = m_points.size();
+  if(n == 0)
+    return y0;
+
+  const auto points = m_points.begin();
+  const std::size_t i = find_segment(abscissa);
+  if(i == n)
+    return points[n - 1].second.first;
+
+  const X prev_x = i == 0 ? x0 : points[i - 1].first;
+  const Y prev_y = i == 0 ? y0 : points[i - 1].second.first;
+  if(!(abscissa > prev_x))
+    return prev_y;
+
+  const auto& [x, point] = points[i];
+  const double ratio
+      = ((double)abscissa - (double)prev_x) / ((double)x - (double)prev_x);
+  return m_kinds[i](point.second, ratio, prev_y, point.first);
+}
+
+template <typename X, typename Y>
+template <typename T>
+inline void curve<X, Y>::values_at(X start, X step, T* out, std::size_t n) const
+{
+  const auto x_at = [=](std::size_t k) -> X { return start + X(k * step); };
 
-  auto end = m_points.end();
-  for(auto it = m_points.begin(); it != end; ++it)
+  const X x0 = get_x0();
+  const Y y0 = get_y0();
+  const std::size_t num_points = m_points.size();
+  if(num_points == 0 || !(step > X{}))
   {
-    if(abscissa > lastAbscissa && abscissa <= it->first)
+    for(std::size_t k = 0; k < n; k++)
+      out[k] = static_cast<T>(value_at(x_at(k)));
+    return;
+  }
+
+  const auto points = m_points.begin();
+  std::size_t k = 0;
+  while(k < n)
+  {
+    const std::size_t i = find_segment(x_at(k));
+    if(i == num_points)
     {
-      lastValue = it->second.second(
-          ((double)abscissa - (double)lastAbscissa)
-              / ((double)it->first - (double)lastAbscissa),
-          lastValue, it->second.first);
-      break;
+      std::fill_n(out + k, n - k, static_cast<T>(points[num_points - 1].second.first));
+      return;
     }
-    else if(abscissa > it->first)
+
+    const X prev_x = i == 0 ? x0 : points[i - 1].first;
+    const Y prev_y = i == 0 ? y0 : points[i - 1].second.first;
+    const auto& [x, point] = points[i];
+
+    // Values in this segment: [k; last[
+    std::size_t last = n;
+    const double count = std::floor(((double)x - (double)start) / (double)step) + 1.;
+    if(count < double(n))
+      last = std::max(k + 1, std::size_t(count));
+    while(last > k + 1 && !(x_at(last - 1) <= x))
+      --last;
+    while(last < n && x_at(last) <= x)
+      ++last;
+
+    for(; k < last && !(x_at(k) > prev_x); k++)
+      out[k] = static_cast<T>(prev_y);
+
+    const double dx = (double)x - (double)prev_x;
+    const auto fill = [&](auto&& f) {
+      for(; k < last; k++)
+        out[k] = static_cast<T>(f(((double)x_at(k) - (double)prev_x) / dx));
+    };
+
+    const Y end = point.first;
+    const curve_segment_kind kind = m_kinds[i];
+    switch(kind.kind)
     {
-      lastAbscissa = it->first;
-      lastValue = it->second.first;
+      case curve_segment_kind::type::linear:
+        fill([=](double r) -> Y { return ossia::easing::ease{}(prev_y, end, r); });
+        break;
+      case curve_segment_kind::type::power:
+        fill([=](double r) -> Y {
+          return prev_y + std::pow(r, kind.power) * (end - prev_y);
+        });
+        break;
+      case curve_segment_kind::type::ease:
+        fill([=](double r) -> Y {
+          return ossia::easing::ease{}(prev_y, end, kind.easing(r));
+        });
+        break;
+      default:
+        fill([&](double r) -> Y { return point.second(r, prev_y, end); });
+        break;
     }
-    else
-      break;
   }
-
-  return lastValue;
 }
 
 template <typename X, typename Y>
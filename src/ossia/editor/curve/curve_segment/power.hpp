@@ -6,11 +6,15 @@ namespace ossia
 template <typename Y>
 struct curve_segment_power
 {
-  auto operator()(double power) const
+  struct segment
   {
-    return [=](double ratio, Y start, Y end) -> Y {
+    double power{};
+    Y operator()(double ratio, Y start, Y end) const
+    {
       return start + std::pow(ratio, power) * (end - start);
-    };
-  }
+    }
+  };
+
+  segment operator()(double power) const { return segment{power}; }
 };
 }
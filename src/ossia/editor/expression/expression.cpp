@@ -70,6 +70,29 @@ struct get_callback_count_visitor
   std::size_t operator()(const ossia::monostate& e) { return 0; }
 };
 
+struct observable_visitor
+{
+  template <typename T>
+  bool operator()(const T& e)
+  {
+    return true;
+  }
+
+  bool operator()(const expression_composition& e)
+  {
+    return ossia::apply_nonnull(*this, e.get_first_operand())
+           && ossia::apply_nonnull(*this, e.get_second_operand());
+  }
+
+  bool operator()(const expression_not& e)
+  {
+    return ossia::apply_nonnull(*this, e.get_expression());
+  }
+
+  bool operator()(const expression_generic& e) { return false; }
+  bool operator()(const ossia::monostate& e) { return false; }
+};
+
 struct different_visitor
 {
   template <typename T, typename U>
@@ -192,6 +215,11 @@ std::size_t callback_count(expression_base& e)
   return ossia::apply_nonnull(get_callback_count_visitor{}, e);
 }
 
+bool is_observable(const expression_base& e)
+{
+  return ossia::apply_nonnull(observable_visitor{}, e);
+}
+
 const expression_base& expression_true()
 {
   static const expression_base e{ossia::in_place_type<expression_bool>, true};
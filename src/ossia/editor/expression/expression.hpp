@@ -106,6 +106,16 @@ OSSIA_EXPORT void remove_callback(expression_base&, expression_callback_iterator
  */
 OSSIA_EXPORT std::size_t callback_count(expression_base&);
 
+/**
+ * @brief is_observable
+ * @return True if the callbacks of the expression are called
+ * every time one of its inputs changes.
+ *
+ * This is the case for all the expressions but generic ones, whose
+ * observation is left to their implementation.
+ */
+OSSIA_EXPORT bool is_observable(const expression_base&);
+
 /**
   \brief expression_true Convenience constant expression always evaluating to
   true.
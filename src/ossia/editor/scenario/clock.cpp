@@ -12,8 +12,29 @@
 #include <cassert>
 #include <iostream>
 
+#if defined(__linux__)
+#include <sys/timerfd.h>
+
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
+#endif
+
 namespace ossia
 {
+#if defined(__linux__)
+namespace
+{
+// std::chrono::steady_clock is CLOCK_MONOTONIC on Linux
+timespec to_timespec(clock_type::time_point t) noexcept
+{
+  using namespace std::chrono;
+  const auto ns = duration_cast<nanoseconds>(t.time_since_epoch()).count();
+  return timespec{time_t(ns / 1'000'000'000), long(ns % 1'000'000'000)};
+}
+}
+#endif
+
 clock::clock(ossia::time_interval& cst, double ratio)
     : m_interval{cst}
     , m_ratio(ratio)
@@ -27,6 +48,7 @@ clock::clock(ossia::time_interval& cst, double ratio)
 clock::~clock()
 {
   stop();
+  close_timer();
 }
 
 void clock::start_and_tick()
@@ -34,6 +56,11 @@ void clock::start_and_tick()
   if(m_running)
     return;
 
+  // the previous thread may still be finishing: it uses the members
+  // reset below
+  if(m_thread.joinable())
+    m_thread.join();
+
   // reset timing information
   m_running = true;
   m_paused = false;
@@ -42,15 +69,15 @@ void clock::start_and_tick()
   // set clock at a tick
   m_date = 0_tv;
   m_lastTime = clock_type::now();
+  m_nextTick = m_lastTime + std::chrono::microseconds(m_granularity.impl);
   m_elapsedTime = 0.;
+  m_stats = {};
+  m_sharedStats.store(m_stats);
 
   // notify the owner
   m_interval.start();
   m_interval.tick_current(0_tv, ossia::token_request{});
 
-  if(m_thread.joinable())
-    m_thread.join();
-
   // launch a new thread to run the clock execution
   m_thread = std::thread(&clock::thread_callback, this);
   set_thread_realtime(m_thread);
@@ -86,6 +113,7 @@ void clock::resume()
 
   // reset the time reference
   m_lastTime = clock_type::now();
+  m_nextTick = m_lastTime + std::chrono::microseconds(m_granularity.impl);
 }
 
 bool clock::tick()
@@ -96,77 +124,49 @@ bool clock::tick()
   if(paused || !running)
     return false;
 
-  int64_t droppedTicks = 0;
-
-  // how many time since the last tick ?
-  int64_t deltaInUs
-      = duration_cast<microseconds>(clock_type::now() - m_lastTime).count();
+  const auto granularity = microseconds(m_granularity.impl);
 
-  // how much ticks it represents ?
-  droppedTicks
-      = ossia::llround(std::floor(double(deltaInUs) / double(m_granularity.impl)));
-
-  const auto tok = ossia::token_request{};
-  // adjust date and elapsed time considering the dropped ticks
-  if(droppedTicks)
+  // The ticks are scheduled on a grid of dates of the monotonic clock:
+  // waiting for an absolute date does not add the time spent in the
+  // previous tick or the wake-up latency to the next one.
+  if(auto now = clock_type::now(); now < m_nextTick)
   {
-    m_date += droppedTicks * m_granularity.impl;
-    m_elapsedTime += droppedTicks * m_granularity.impl;
-
-    // maybe the clock reaches the end ?
-    if(m_duration - m_date < Zero && !m_duration.infinite())
-    {
-      // notify the owner
-      m_interval.tick_offset(time_value{deltaInUs}, 0_tv, tok);
-
-      request_stop();
-
-      return true;
-    }
+    wait_until(m_nextTick);
   }
-
-  // how many time to pause to reach the next tick ?
-  int64_t pauseInUs = m_granularity.impl - m_elapsedTime % m_granularity.impl;
-  // std::cerr << m_granularity << " " << m_ratio << " " << deltaInUs << " "<<
-  // droppedTicks << " "  << granularityInUs << " " << pauseInUs << std::endl;
-  // if too early: wait
-  if(pauseInUs > 0)
+  else if(auto late = now - m_nextTick; late >= granularity)
   {
-    while(pauseInUs > 5000)
-    {
-      // pause the thread logarithmically
-      auto t1 = clock_type::now();
-      std::this_thread::sleep_for(std::chrono::microseconds(pauseInUs / 2));
-      auto t2 = clock_type::now();
-      pauseInUs -= duration_cast<microseconds>(t2 - t1).count();
-    }
+    // skip the ticks we are too late for
+    const int64_t missed = late / granularity;
+    m_nextTick += missed * granularity;
+    m_stats.missed_ticks += missed;
+  }
 
-    {
-      // busy loop
-      auto t1 = clock_type::now();
-      while(duration_cast<microseconds>(clock_type::now() - t1).count()
-            < (pauseInUs + 10))
-        ;
-    }
+  const auto tickTime = clock_type::now();
 
-    deltaInUs = duration_cast<microseconds>(clock_type::now() - m_lastTime).count()
-                - droppedTicks * m_granularity.impl;
-  }
+  const auto lateness = duration_cast<nanoseconds>(tickTime - m_nextTick);
+  m_stats.ticks++;
+  m_stats.last_lateness = lateness;
+  m_stats.total_lateness += lateness;
+  if(lateness > m_stats.max_lateness)
+    m_stats.max_lateness = lateness;
+  m_sharedStats.store(m_stats);
 
-  // std::cerr << deltaInUs << std::endl;
-  // how many time elapsed from the start ?
+  m_nextTick += granularity;
+
+  // how many time elapsed since the last tick ?
+  // the date follows the monotonic clock, whatever the lateness of the ticks
+  const int64_t deltaInUs = duration_cast<microseconds>(tickTime - m_lastTime).count();
+  m_lastTime += microseconds(deltaInUs);
 
   m_date += deltaInUs;
   m_elapsedTime += deltaInUs;
 
-  // note the time now to evaluate how long is the callback processing
-  m_lastTime = clock_type::now();
-
   // test paused and running status after computing the date because there is a
   // sleep before
   if(!paused && running)
   {
     // notify the owner
+    const auto tok = ossia::token_request{};
     m_interval.tick(time_value{deltaInUs}, tok, m_ratio);
 
     // is this the end
@@ -179,6 +179,65 @@ bool clock::tick()
   return true;
 }
 
+void clock::wait_until(clock_type::time_point date)
+{
+  switch(m_waitStrategy.load(std::memory_order_relaxed))
+  {
+#if defined(__linux__)
+    case wait_strategy::NANOSLEEP: {
+      const auto ts = to_timespec(date);
+      while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+        ;
+      return;
+    }
+
+    case wait_strategy::TIMERFD: {
+      if(m_timerfd < 0)
+        m_timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+
+      if(m_timerfd >= 0)
+      {
+        itimerspec spec{};
+        spec.it_value = to_timespec(date);
+        if(timerfd_settime(m_timerfd, TFD_TIMER_ABSTIME, &spec, nullptr) == 0)
+        {
+          uint64_t expirations{};
+          while(::read(m_timerfd, &expirations, sizeof(expirations)) < 0
+                && errno == EINTR)
+            ;
+          return;
+        }
+      }
+
+      logger().error("clock: timerfd unavailable, falling back to hybrid wait");
+      m_waitStrategy = wait_strategy::HYBRID;
+      break;
+    }
+#endif
+
+    default:
+      break;
+  }
+
+  // sleep for most of the time, then busy loop for the last part
+  if(auto sleep_date = date - hybrid_spin_duration; clock_type::now() < sleep_date)
+    std::this_thread::sleep_until(sleep_date);
+
+  while(clock_type::now() < date)
+    ;
+}
+
+void clock::close_timer()
+{
+#if defined(__linux__)
+  if(m_timerfd >= 0)
+  {
+    ::close(m_timerfd);
+    m_timerfd = -1;
+  }
+#endif
+}
+
 time_value clock::get_duration() const
 {
   return m_duration;
@@ -207,6 +266,22 @@ ossia::clock& clock::set_granularity(std::chrono::microseconds granularity)
   return *this;
 }
 
+clock::wait_strategy clock::get_wait_strategy() const
+{
+  return m_waitStrategy;
+}
+
+ossia::clock& clock::set_wait_strategy(wait_strategy s)
+{
+  m_waitStrategy = s;
+  return *this;
+}
+
+clock::tick_statistics clock::get_statistics() const
+{
+  return m_sharedStats.load();
+}
+
 bool clock::running() const
 {
   return m_running;
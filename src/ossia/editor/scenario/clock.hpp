@@ -2,6 +2,7 @@
 
 #include <ossia/detail/config.hpp>
 
+#include <ossia/detail/seqlock.hpp>
 #include <ossia/editor/scenario/time_value.hpp>
 
 #include <atomic>
@@ -27,6 +28,39 @@ public:
   };
   using exec_status_callback = std::function<void(exec_status)>;
 
+  /**
+   * How the clock thread waits for the next tick.
+   *
+   * Ticks are scheduled on absolute dates of the monotonic clock, so that
+   * the time spent in the ticks does not accumulate as drift.
+   * NANOSLEEP and TIMERFD are only available on Linux; elsewhere they
+   * behave as HYBRID.
+   */
+  enum class wait_strategy : uint8_t
+  {
+    HYBRID,    //! Sleep until shortly before the tick, then spin
+    NANOSLEEP, //! clock_nanosleep on CLOCK_MONOTONIC with TIMER_ABSTIME
+    TIMERFD    //! Blocking read on an absolute timerfd
+  };
+
+  //! Lateness of the ticks relative to their scheduled date
+  struct tick_statistics
+  {
+    int64_t ticks{};        //! Number of ticks since the clock started
+    int64_t missed_ticks{}; //! Ticks skipped because the clock was too late
+    std::chrono::nanoseconds last_lateness{};
+    std::chrono::nanoseconds max_lateness{};
+    std::chrono::nanoseconds total_lateness{};
+
+    [[nodiscard]] std::chrono::nanoseconds mean_lateness() const noexcept
+    {
+      return ticks > 0 ? total_lateness / ticks : std::chrono::nanoseconds{};
+    }
+  };
+
+  //! Time spent spinning before each tick with wait_strategy::HYBRID
+  static constexpr std::chrono::microseconds hybrid_spin_duration{1000};
+
   //! Ratio : the number of time units in one millisecond
   clock(ossia::time_interval& cst, double time_ratio = 1000.);
 
@@ -73,6 +107,17 @@ public:
   clock& set_granularity(std::chrono::microseconds);
   clock& set_granularity(std::chrono::milliseconds);
 
+  /*! get the strategy used to wait for the next tick */
+  [[nodiscard]] wait_strategy get_wait_strategy() const;
+
+  /*! set the strategy used to wait for the next tick
+   \details takes effect at the next tick */
+  clock& set_wait_strategy(wait_strategy);
+
+  /*! get the lateness statistics of the ticks since the clock started
+   \details can be called from any thread */
+  [[nodiscard]] tick_statistics get_statistics() const;
+
   /*! get the running status of the clock
    \return bool true if is running */
   [[nodiscard]] bool running() const;
@@ -115,6 +160,15 @@ private:
   /// a time reference used to compute time tick
   clock_type::time_point m_lastTime{};
 
+  /// the scheduled date of the next tick
+  clock_type::time_point m_nextTick{};
+
+  std::atomic<wait_strategy> m_waitStrategy{wait_strategy::HYBRID};
+  int m_timerfd{-1};
+
+  tick_statistics m_stats{};
+  ossia::seqlock<tick_statistics> m_sharedStats;
+
   exec_status_callback m_statusCallback;
 
   /// a time reference used to know elapsed time in a microsecond
@@ -126,5 +180,9 @@ private:
 
   /*! called back by the internal thread */
   void thread_callback();
+
+  /*! waits until the given date with the current wait strategy */
+  void wait_until(clock_type::time_point);
+  void close_timer();
 };
 }
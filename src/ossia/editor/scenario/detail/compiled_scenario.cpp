@@ -0,0 +1,83 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <ossia/editor/scenario/detail/compiled_scenario.hpp>
+#include <ossia/editor/scenario/time_event.hpp>
+#include <ossia/editor/scenario/time_interval.hpp>
+#include <ossia/editor/scenario/time_sync.hpp>
+
+namespace ossia
+{
+void compiled_scenario::clear()
+{
+  m_intervals.clear();
+  m_events.clear();
+  m_adjacency.clear();
+  m_interval_indices.clear();
+  m_event_indices.clear();
+}
+
+compiled_scenario::index compiled_scenario::add_event(time_event* ev)
+{
+  auto [it, inserted] = m_event_indices.try_emplace(ev, index(m_events.size()));
+  if(inserted)
+    m_events.push_back(event{ev});
+  return it->second;
+}
+
+void compiled_scenario::build(
+    const ptr_container<time_sync>& syncs, const ptr_container<time_interval>& intervals)
+{
+  clear();
+
+  m_intervals.reserve(intervals.size());
+  m_interval_indices.reserve(intervals.size());
+  for(const auto& itv : intervals)
+  {
+    m_interval_indices.try_emplace(itv.get(), index(m_intervals.size()));
+    m_intervals.push_back(interval{itv.get()});
+  }
+
+  // Events of the syncs, and of the intervals whose syncs were not added
+  // to the scenario
+  for(const auto& sync : syncs)
+    for(const auto& ev : sync->get_time_events())
+      add_event(ev.get());
+
+  for(auto& itv : m_intervals)
+  {
+    itv.start_event = add_event(&itv.ptr->get_start_event());
+    itv.end_event = add_event(&itv.ptr->get_end_event());
+  }
+
+  // Only the intervals of the scenario are part of the adjacency
+  auto add_range = [this](const auto& itvs, index& begin, index& end) {
+    begin = index(m_adjacency.size());
+    for(const auto& itv : itvs)
+    {
+      if(auto i = index_of(itv.get()); i != invalid)
+        m_adjacency.push_back(i);
+    }
+    end = index(m_adjacency.size());
+  };
+
+  m_adjacency.reserve(2 * m_intervals.size());
+  for(auto& ev : m_events)
+  {
+    add_range(ev.ptr->previous_time_intervals(), ev.previous_begin, ev.previous_end);
+    add_range(ev.ptr->next_time_intervals(), ev.next_begin, ev.next_end);
+  }
+}
+
+compiled_scenario::index
+compiled_scenario::index_of(const time_interval* itv) const noexcept
+{
+  auto it = m_interval_indices.find(itv);
+  return it != m_interval_indices.end() ? it->second : invalid;
+}
+
+compiled_scenario::index compiled_scenario::index_of(const time_event* ev) const noexcept
+{
+  auto it = m_event_indices.find(ev);
+  return it != m_event_indices.end() ? it->second : invalid;
+}
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+
+#include <ossia/detail/ptr_container.hpp>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <ankerl/unordered_dense.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ossia
+{
+class time_event;
+class time_interval;
+class time_sync;
+
+/**
+ * @brief Dense representation of the graph of a scenario.
+ *
+ * The time_events and time_intervals of a scenario are stored in arrays
+ * and refer to each other by index: walking from an event to its
+ * intervals and back during execution does not go through
+ * the shared_ptr containers of time_event.
+ *
+ * It is built by the scenario when it is started, and built again
+ * on the next tick after intervals or syncs are added or removed.
+ */
+class OSSIA_EXPORT compiled_scenario
+{
+public:
+  using index = uint32_t;
+  static constexpr index invalid = std::numeric_limits<index>::max();
+
+  struct interval
+  {
+    time_interval* ptr{};
+    index start_event{invalid};
+    index end_event{invalid};
+  };
+
+  struct event
+  {
+    time_event* ptr{};
+
+    // Ranges in the adjacency array
+    index previous_begin{};
+    index previous_end{};
+    index next_begin{};
+    index next_end{};
+  };
+
+  struct index_range
+  {
+    const index* first{};
+    const index* last{};
+    const index* begin() const noexcept { return first; }
+    const index* end() const noexcept { return last; }
+  };
+
+  void build(const ptr_container<time_sync>& syncs,
+             const ptr_container<time_interval>& intervals);
+  void clear();
+
+  [[nodiscard]] std::size_t interval_count() const noexcept
+  {
+    return m_intervals.size();
+  }
+  [[nodiscard]] std::size_t event_count() const noexcept { return m_events.size(); }
+
+  [[nodiscard]] const interval& get_interval(index i) const noexcept
+  {
+    return m_intervals[i];
+  }
+  [[nodiscard]] const event& get_event(index e) const noexcept { return m_events[e]; }
+
+  //! Index of an interval or event, or invalid if it was not part of the
+  //! scenario when it was built.
+  [[nodiscard]] index index_of(const time_interval* itv) const noexcept;
+  [[nodiscard]] index index_of(const time_event* ev) const noexcept;
+
+  //! Indices of the intervals ending on an event
+  [[nodiscard]] index_range previous_intervals(index e) const noexcept
+  {
+    auto& ev = m_events[e];
+    return {m_adjacency.data() + ev.previous_begin, m_adjacency.data() + ev.previous_end};
+  }
+
+  //! Indices of the intervals starting from an event
+  [[nodiscard]] index_range next_intervals(index e) const noexcept
+  {
+    auto& ev = m_events[e];
+    return {m_adjacency.data() + ev.next_begin, m_adjacency.data() + ev.next_end};
+  }
+
+private:
+  index add_event(time_event* ev);
+
+  std::vector<interval> m_intervals;
+  std::vector<event> m_events;
+  std::vector<index> m_adjacency;
+
+  ankerl::unordered_dense::map<const time_interval*, index> m_interval_indices;
+  ankerl::unordered_dense::map<const time_event*, index> m_event_indices;
+};
+
+/**
+ * @brief Set of intervals of a compiled_scenario, stored as a bitset
+ * of their indices.
+ *
+ * Insertion and removal do not move the other elements, and iteration
+ * follows the order of the intervals in the compiled_scenario.
+ */
+class interval_bitset
+{
+public:
+  using index = compiled_scenario::index;
+
+  void resize(std::size_t n) { m_bits.resize(n); }
+  [[nodiscard]] std::size_t capacity() const noexcept { return m_bits.size(); }
+
+  void insert(index i) noexcept { m_bits.set(i); }
+  void erase(index i) noexcept
+  {
+    if(i < m_bits.size())
+      m_bits.reset(i);
+  }
+  [[nodiscard]] bool contains(index i) const noexcept
+  {
+    return i < m_bits.size() && m_bits.test(i);
+  }
+
+  void clear() noexcept { m_bits.reset(); }
+  [[nodiscard]] bool empty() const noexcept { return m_bits.none(); }
+  [[nodiscard]] std::size_t size() const noexcept { return m_bits.count(); }
+
+  //! Calls f with the index of each interval in the set.
+  //! f may erase the interval it is given.
+  template <typename F>
+  void for_each(F&& f) const
+  {
+    for(auto i = m_bits.find_first(); i != bits::npos; i = m_bits.find_next(i))
+      f(index(i));
+  }
+
+private:
+  using bits = boost::dynamic_bitset<uint64_t>;
+  bits m_bits;
+};
+}
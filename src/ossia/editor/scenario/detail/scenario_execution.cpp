@@ -44,32 +44,68 @@ small_sync_vec scenario::get_roots() const noexcept
 }
 
 void scenario::make_happen(
-    time_event& event, interval_set& started, interval_set& stopped,
+    time_event& event, interval_bitset& started, interval_bitset& stopped,
     ossia::time_value tick_offset, const ossia::token_request& tok)
 {
   event.m_status = time_event::status::HAPPENED;
+  const auto ev = compiled_index(event);
 
   // stop previous TimeIntervals
-  for(const std::shared_ptr<ossia::time_interval>& timeInterval :
-      event.previous_time_intervals())
+  if(ev != compiled_scenario::invalid)
   {
-    timeInterval->stop();
-    mark_end_discontinuous{}(*timeInterval);
-    stopped.erase(timeInterval.get());
+    for(auto i : m_compiled.previous_intervals(ev))
+    {
+      time_interval& timeInterval = *m_compiled.get_interval(i).ptr;
+      timeInterval.stop();
+      mark_end_discontinuous{}(timeInterval);
+      stopped.erase(i);
+    }
+  }
+  else
+  {
+    // The event was added to one of our syncs after the last build:
+    // walk its own intervals, the build is done again on the next tick.
+    m_compiled_dirty = true;
+    for(const auto& itv : event.previous_time_intervals())
+    {
+      time_interval& timeInterval = *itv;
+      timeInterval.stop();
+      mark_end_discontinuous{}(timeInterval);
+      stopped.erase(compiled_index(timeInterval));
+      ossia::remove_one(m_uncompiledRunning, &timeInterval);
+    }
   }
 
   event.tick(0_tv, tick_offset);
 
   // setup next TimeIntervals
-  for(const std::shared_ptr<ossia::time_interval>& timeInterval :
-      event.next_time_intervals())
+  if(ev != compiled_scenario::invalid)
   {
-    timeInterval->set_parent_speed(tok.speed);
-    timeInterval->start();
-    // timeInterval->tick_current(tick_offset, tok);
-    mark_start_discontinuous{}(*timeInterval);
+    for(auto i : m_compiled.next_intervals(ev))
+    {
+      time_interval& timeInterval = *m_compiled.get_interval(i).ptr;
+      timeInterval.set_parent_speed(tok.speed);
+      timeInterval.start();
+      // timeInterval.tick_current(tick_offset, tok);
+      mark_start_discontinuous{}(timeInterval);
 
-    started.insert(timeInterval.get());
+      started.insert(i);
+    }
+  }
+  else
+  {
+    for(const auto& itv : event.next_time_intervals())
+    {
+      time_interval& timeInterval = *itv;
+      timeInterval.set_parent_speed(tok.speed);
+      timeInterval.start();
+      mark_start_discontinuous{}(timeInterval);
+
+      if(auto i = compiled_index(timeInterval); i != compiled_scenario::invalid)
+        started.insert(i);
+      else
+        m_uncompiledRunning.push_back(&timeInterval);
+    }
   }
 
   if(event.m_callback)
@@ -78,7 +114,7 @@ void scenario::make_happen(
   reinterpret_cast<uint8_t&>(event.m_status) |= uint8_t(time_event::status::FINISHED);
 }
 
-void scenario::make_dispose(time_event& event, interval_set& stopped)
+void scenario::make_dispose(time_event& event, interval_bitset& stopped)
 {
   if(event.m_status == time_event::status::HAPPENED)
   {
@@ -90,32 +126,64 @@ void scenario::make_dispose(time_event& event, interval_set& stopped)
 
   event.m_status = time_event::status::DISPOSED;
 
-  // stop previous TimeIntervals
-  for(auto& timeInterval : event.previous_time_intervals())
-  {
-    timeInterval->stop();
-    mark_end_discontinuous{}(*timeInterval);
-    stopped.erase(timeInterval.get());
-  }
-
-  // dispose next TimeIntervals end event if everything is disposed before
-  for(auto& nextTimeInterval : event.next_time_intervals())
+  if(const auto ev = compiled_index(event); ev != compiled_scenario::invalid)
   {
-    bool dispose = true;
+    // stop previous TimeIntervals
+    for(auto i : m_compiled.previous_intervals(ev))
+    {
+      time_interval& timeInterval = *m_compiled.get_interval(i).ptr;
+      timeInterval.stop();
+      mark_end_discontinuous{}(timeInterval);
+      stopped.erase(i);
+    }
 
-    for(auto& previousTimeInterval :
-        nextTimeInterval->get_end_event().previous_time_intervals())
+    // dispose next TimeIntervals end event if everything is disposed before
+    for(auto i : m_compiled.next_intervals(ev))
     {
-      if(previousTimeInterval->get_start_event().get_status()
-         != time_event::status::DISPOSED)
+      const auto& nextTimeInterval = m_compiled.get_interval(i);
+      bool dispose = true;
+
+      for(auto j : m_compiled.previous_intervals(nextTimeInterval.end_event))
       {
-        dispose = false;
-        break;
+        const auto& previousTimeInterval = m_compiled.get_interval(j);
+        if(m_compiled.get_event(previousTimeInterval.start_event).ptr->get_status()
+           != time_event::status::DISPOSED)
+        {
+          dispose = false;
+          break;
+        }
       }
+
+      if(dispose && !nextTimeInterval.ptr->graphal)
+        make_dispose(*m_compiled.get_event(nextTimeInterval.end_event).ptr, stopped);
+    }
+  }
+  else
+  {
+    // Same walk as above through the intervals of the event itself,
+    // see make_happen
+    m_compiled_dirty = true;
+    for(const auto& itv : event.previous_time_intervals())
+    {
+      time_interval& timeInterval = *itv;
+      timeInterval.stop();
+      mark_end_discontinuous{}(timeInterval);
+      stopped.erase(compiled_index(timeInterval));
+      ossia::remove_one(m_uncompiledRunning, &timeInterval);
     }
 
-    if(dispose && !nextTimeInterval->graphal)
-      make_dispose(nextTimeInterval->get_end_event(), stopped);
+    for(const auto& nextTimeInterval : event.next_time_intervals())
+    {
+      auto& end_event = nextTimeInterval->get_end_event();
+      bool dispose = ossia::all_of(
+          end_event.previous_time_intervals(), [](const auto& previousTimeInterval) {
+            return previousTimeInterval->get_start_event().get_status()
+                   == time_event::status::DISPOSED;
+          });
+
+      if(dispose && !nextTimeInterval->graphal)
+        make_dispose(end_event, stopped);
+    }
   }
 
   if(event.m_callback)
@@ -123,6 +191,58 @@ void scenario::make_dispose(time_event& event, interval_set& stopped)
 
   reinterpret_cast<uint8_t&>(event.m_status) |= uint8_t(time_event::status::FINISHED);
 }
+
+void scenario::compile()
+{
+  // The running intervals are kept across the rebuild
+  std::vector<time_interval*> running;
+  running.reserve(m_runningIntervals.size() + m_uncompiledRunning.size());
+  m_runningIntervals.for_each(
+      [&](auto i) { running.push_back(m_compiled.get_interval(i).ptr); });
+  running.insert(running.end(), m_uncompiledRunning.begin(), m_uncompiledRunning.end());
+  m_uncompiledRunning.clear();
+
+  m_compiled.build(m_nodes, m_intervals);
+  m_compiled_dirty = false;
+
+  m_runningIntervals.clear();
+  m_runningIntervals.resize(m_compiled.interval_count());
+  for(auto itv : running)
+  {
+    if(auto i = m_compiled.index_of(itv); i != compiled_scenario::invalid)
+      m_runningIntervals.insert(i);
+  }
+}
+
+compiled_scenario::index scenario::compiled_index(const time_interval& itv) const noexcept
+{
+  return m_compiled.index_of(&itv);
+}
+
+compiled_scenario::index scenario::compiled_index(const time_event& ev) const noexcept
+{
+  return m_compiled.index_of(&ev);
+}
+
+void scenario::start_running(time_interval& itv)
+{
+  if(auto i = compiled_index(itv); i != compiled_scenario::invalid)
+  {
+    m_runningIntervals.insert(i);
+  }
+  else if(!ossia::contains(m_uncompiledRunning, &itv))
+  {
+    m_uncompiledRunning.push_back(&itv);
+    m_compiled_dirty = true;
+  }
+}
+
+void scenario::stop_running(const time_interval& itv)
+{
+  m_runningIntervals.erase(compiled_index(itv));
+  ossia::remove_one(m_uncompiledRunning, &itv);
+}
+
 enum progress_mode
 {
   PROGRESS_MIN,
@@ -239,6 +359,9 @@ void scenario::state_impl(const ossia::token_request& tk)
     time_value tick_ms
         = (prev_last_date == Infinite) ? tk.date : (tk.date - prev_last_date);
 
+    if(m_compiled_dirty)
+      compile();
+
     m_overticks.clear();
     m_endNodes.clear();
     m_retry_syncs.clear();
@@ -247,13 +370,12 @@ void scenario::state_impl(const ossia::token_request& tk)
     m_endNodes.container.reserve(m_nodes.size());
     m_overticks.container.reserve(m_nodes.size());
 
-    for(auto it = m_runningIntervals.begin(); it != m_runningIntervals.end();)
-    {
-      if((*it)->get_end_event().get_status() == time_event::status::HAPPENED)
-        it = m_runningIntervals.erase(it);
-      else
-        ++it;
-    }
+    m_runningIntervals.for_each([this](compiled_scenario::index i) {
+      const auto& itv = m_compiled.get_interval(i);
+      if(m_compiled.get_event(itv.end_event).ptr->get_status()
+         == time_event::status::HAPPENED)
+        m_runningIntervals.erase(i);
+    });
     // First we should find, for each running interval, the actual maximum
     // tick length
     // that they can be ticked. If it is < tick_us, then they won't execute.
@@ -338,7 +460,7 @@ void scenario::state_impl(const ossia::token_request& tk)
         // itv->tick_current(*date, tk);
         // mark_start_discontinuous{}(*itv);
 
-        m_runningIntervals.insert(itv);
+        start_running(*itv);
         auto& start_ev = itv->get_start_event();
         start_ev.set_status(ossia::time_event::status::HAPPENED);
         auto& end_ev = itv->get_end_event();
@@ -362,9 +484,7 @@ void scenario::state_impl(const ossia::token_request& tk)
           itv->stop();
         }
 
-        if(auto running_it = m_runningIntervals.find(itv);
-           running_it != m_runningIntervals.end())
-          m_runningIntervals.erase(running_it);
+        stop_running(*itv);
 
         it = m_itv_to_stop.erase(it);
       }
@@ -377,11 +497,11 @@ void scenario::state_impl(const ossia::token_request& tk)
     // First check timesyncs already past their min
     // for any that may have a quantization setting
 
-    for(time_interval* interval : m_runningIntervals)
-    {
-      if(interval->get_date() >= interval->get_min_duration())
+    m_runningIntervals.for_each([&](compiled_scenario::index i) {
+      time_interval& interval = *m_compiled.get_interval(i).ptr;
+      if(interval.get_date() >= interval.get_min_duration())
       {
-        const auto end_node = &interval->get_end_event().get_time_sync();
+        const auto end_node = &interval.get_end_event().get_time_sync();
         if(end_node->has_sync_rate())
         {
           m_endNodes.insert(end_node);
@@ -389,12 +509,11 @@ void scenario::state_impl(const ossia::token_request& tk)
               *end_node, m_pendingEvents, m_maxReachedEvents, tk.offset, tk);
         }
       }
-    }
+    });
 
-    for(time_interval* interval : m_runningIntervals)
-    {
-      run_interval(*interval, tk, tick_ms, tick_ms, tk.offset);
-    }
+    m_runningIntervals.for_each([&](compiled_scenario::index i) {
+      run_interval(*m_compiled.get_interval(i).ptr, tk, tick_ms, tick_ms, tk.offset);
+    });
 
     // Handle time syncs / events... if they are not finished, intervals in
     // running_interval are in cur_cst
@@ -419,9 +538,18 @@ void scenario::state_impl(const ossia::token_request& tk)
 
           const auto offset = tk.offset + tick_ms - remaining_tick;
           const_cast<overtick&>(it->second).offset = offset;
-          for(const auto& interval : ev.next_time_intervals())
+          if(const auto idx = compiled_index(ev); idx != compiled_scenario::invalid)
+          {
+            for(auto i : m_compiled.next_intervals(idx))
+            {
+              run_interval(
+                  *m_compiled.get_interval(i).ptr, tk, tick_ms, remaining_tick, offset);
+            }
+          }
+          else
           {
-            run_interval(*interval, tk, tick_ms, remaining_tick, offset);
+            for(const auto& itv : ev.next_time_intervals())
+              run_interval(*itv, tk, tick_ms, remaining_tick, offset);
           }
         }
       }
@@ -135,6 +135,9 @@ void scenario::transport_impl(ossia::time_value offset)
     return;
   }
 
+  if(m_compiled_dirty)
+    compile();
+
   // reset internal offset list and state
 
   // a temporary list to order all past events to build the
@@ -145,6 +148,7 @@ void scenario::transport_impl(ossia::time_value offset)
   seen_events.container.reserve(pastEvents.container.size());
 
   m_runningIntervals.clear();
+  m_uncompiledRunning.clear();
 
   // Precompute the default date of every timesync.
   ossia::ptr_map<time_sync*, ossia::time_value> time_map;
@@ -220,7 +224,7 @@ void scenario::transport_impl(ossia::time_value offset)
        && sev.get_status() == time_event::status::HAPPENED)
     {
       cst.transport(intervalOffset);
-      m_runningIntervals.insert(&cst);
+      start_running(cst);
     }
     else
     {
@@ -233,6 +237,9 @@ void scenario::transport_impl(ossia::time_value offset)
 
 void scenario::offset_impl(ossia::time_value offset)
 {
+  if(m_compiled_dirty)
+    compile();
+
   // reset internal offset list and state
 
   // a temporary list to order all past events to build the
@@ -243,6 +250,7 @@ void scenario::offset_impl(ossia::time_value offset)
   seen_events.container.reserve(pastEvents.container.size());
 
   m_runningIntervals.clear();
+  m_uncompiledRunning.clear();
 
   // Precompute the default date of every timesync.
   ossia::ptr_map<time_sync*, ossia::time_value> time_map;
@@ -343,7 +351,7 @@ void scenario::offset_impl(ossia::time_value offset)
         // cst.start();
         cst.offset(offset - start_date);
 
-        m_runningIntervals.insert(&cst);
+        start_running(cst);
       }
     }
   }
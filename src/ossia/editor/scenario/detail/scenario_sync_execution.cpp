@@ -82,7 +82,7 @@ sync_status scenario::trigger_quantified_time_sync(
 
 sync_status scenario::trigger_sync(
     time_sync& sync, small_event_vec& pending, small_event_vec& maxReachedEv,
-    interval_set& started, interval_set& stopped, ossia::time_value tick_offset,
+    interval_bitset& started, interval_bitset& stopped, ossia::time_value tick_offset,
     const ossia::token_request& tk, bool maximalDurationReached)
 {
   if(!sync.m_evaluating)
@@ -107,7 +107,7 @@ sync_status scenario::trigger_sync(
 
       if(sync.trigger_request)
         sync.end_trigger_request();
-      else if(!expressions::evaluate(*sync.m_expression))
+      else if(!sync.evaluate_expression())
         return sync_status::NOT_READY;
     }
 
@@ -174,7 +174,7 @@ int is_timesync_ready(
     time_sync& sync, small_event_vec& pendingEvents, bool& maximalDurationReached);
 sync_status scenario::process_this(
     time_sync& sync, small_event_vec& pendingEvents, small_event_vec& maxReachedEvents,
-    interval_set& started, interval_set& stopped, ossia::time_value tick_offset,
+    interval_bitset& started, interval_bitset& stopped, ossia::time_value tick_offset,
     const ossia::token_request& req)
 {
   // prepare to remember which event changed its status to PENDING
@@ -31,7 +31,7 @@ sync_status scenario::trigger_sync_musical(
 
       if(sync.trigger_request)
         sync.end_trigger_request();
-      else if(!expressions::evaluate(*sync.m_expression))
+      else if(!sync.evaluate_expression())
         return sync_status::NOT_READY;
     }
 
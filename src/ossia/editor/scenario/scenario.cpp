@@ -32,7 +32,6 @@ scenario::scenario()
   m_retry_syncs.container.reserve(8);
   // m_rootNodes.reserve(1024);
 
-  m_runningIntervals.container.reserve(1024);
   m_waitingNodes.container.reserve(1024);
   m_component_visit_cache.container.reserve(1024);
   m_component_visit_stack.reserve(1024);
@@ -48,7 +47,7 @@ scenario::~scenario()
 
 void scenario::start()
 {
-  m_runningIntervals.container.reserve(m_intervals.size());
+  compile();
   m_waitingNodes.container.reserve(m_nodes.size());
   m_pendingEvents.reserve(m_nodes.size() * 2);
   m_maxReachedEvents.reserve(m_nodes.size() * 2);
@@ -93,7 +92,7 @@ void scenario::start()
         startStatus == time_event::status::HAPPENED
         && endStatus == time_event::status::NONE)
     {
-      m_runningIntervals.insert(&cst);
+      start_running(cst);
       cst.start();
       // TODO cst.tick_current();
     }
@@ -109,7 +108,7 @@ void scenario::start()
         startStatus == time_event::status::HAPPENED
         && endStatus == time_event::status::PENDING)
     {
-      m_runningIntervals.insert(&cst);
+      start_running(cst);
       cst.start();
       // const auto tok = ossia::token_request{};
       // cst.tick_current(0_tv, tok);
@@ -153,6 +152,7 @@ void scenario::stop()
   }
 
   m_runningIntervals.clear();
+  m_uncompiledRunning.clear();
   m_itv_to_start.clear();
   m_itv_to_stop.clear();
   m_waitingNodes.clear();
@@ -200,6 +200,7 @@ void scenario::add_time_interval(std::shared_ptr<time_interval> itv)
     if(node->muted())
       itv->mute(true);
     m_intervals.push_back(std::move(itv));
+    m_compiled_dirty = true;
 
     if(end_root)
     {
@@ -224,9 +225,7 @@ void scenario::remove_time_interval(const std::shared_ptr<time_interval>& itv)
       }
       m_rootNodes = get_roots();
     }
-    if(auto it = ossia::find(m_runningIntervals, itv.get());
-       it != m_runningIntervals.end())
-      m_runningIntervals.erase(it);
+    stop_running(*itv);
     if(auto it = ossia::find(m_itv_to_start, itv.get()); it != m_itv_to_start.end())
       m_itv_to_start.erase(it);
     if(auto it = ossia::find(m_itv_to_stop, itv.get()); it != m_itv_to_stop.end())
@@ -235,6 +234,7 @@ void scenario::remove_time_interval(const std::shared_ptr<time_interval>& itv)
     m_itv_end_map.erase(itv.get());
 
     remove_one(m_intervals, itv);
+    m_compiled_dirty = true;
   }
 }
 
@@ -248,6 +248,7 @@ void scenario::add_time_sync(std::shared_ptr<time_sync> timeSync)
     if(node->muted())
       t.mute(true);
     m_nodes.push_back(std::move(timeSync));
+    m_compiled_dirty = true;
 
     if(m_last_date != ossia::Infinite)
     {
@@ -274,6 +275,7 @@ void scenario::remove_time_sync(const std::shared_ptr<time_sync>& timeSync)
     m_retry_syncs.erase(timeSync.get());
 
     remove_one(m_nodes, timeSync);
+    m_compiled_dirty = true;
   }
 }
 
@@ -303,7 +305,7 @@ void scenario::reset_subgraph(
   for(const std::shared_ptr<ossia::time_interval>& itv : itvs)
   {
     itv->stop();
-    m_runningIntervals.erase(itv.get());
+    stop_running(*itv);
     m_itv_end_map.erase(itv.get());
   }
 }
@@ -342,7 +344,7 @@ void scenario::reset_component(ossia::time_sync& n)
 
   auto disable_itv = [&](ossia::time_interval& itv) {
     itv.stop();
-    m_runningIntervals.erase(&itv);
+    stop_running(itv);
     m_itv_end_map.erase(&itv);
   };
 
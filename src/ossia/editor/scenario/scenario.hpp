@@ -8,6 +8,7 @@
 #include <ossia/detail/ptr_container.hpp>
 #include <ossia/detail/ptr_set.hpp>
 #include <ossia/detail/small_vector.hpp>
+#include <ossia/editor/scenario/detail/compiled_scenario.hpp>
 #include <ossia/editor/scenario/time_process.hpp>
 #include <ossia/editor/scenario/time_value.hpp>
 
@@ -19,7 +20,6 @@ namespace ossia
 class time_event;
 class time_interval;
 class time_sync;
-using interval_set = ossia::flat_set<time_interval*>;
 using sync_set = ossia::flat_set<time_sync*>;
 using small_sync_vec = ossia::small_vector<time_sync*, 4>;
 using small_event_vec = std::vector<time_event*>;
@@ -158,7 +158,11 @@ private:
   ptr_container<time_sync> m_nodes; // list of all TimeSyncs of the scenario
                                     // (the first is the start node)
 
-  interval_set m_runningIntervals;
+  compiled_scenario m_compiled;
+  interval_bitset m_runningIntervals;
+  // Running intervals that were not part of the scenario at the last build
+  ossia::small_vector<time_interval*, 2> m_uncompiledRunning;
+  bool m_compiled_dirty{true};
   sync_set m_waitingNodes;
   small_sync_vec m_rootNodes;
   small_event_vec m_pendingEvents;
@@ -182,20 +186,30 @@ private:
   ossia::small_vector<quantized_interval, 2> m_itv_to_start;
   ossia::small_vector<quantized_interval, 2> m_itv_to_stop;
 
-  static void make_happen(
-      time_event& event, interval_set& started, interval_set& stopped,
+  void make_happen(
+      time_event& event, interval_bitset& started, interval_bitset& stopped,
       ossia::time_value tick_offset, const ossia::token_request& tok);
 
-  static void make_dispose(time_event& event, interval_set& stopped);
+  void make_dispose(time_event& event, interval_bitset& stopped);
+
+  //! Builds m_compiled again. Only done when entering state_impl, start,
+  //! offset_impl and transport_impl so that the indices held during a tick
+  //! stay valid.
+  void compile();
+  compiled_scenario::index compiled_index(const time_interval& itv) const noexcept;
+  compiled_scenario::index compiled_index(const time_event& ev) const noexcept;
+
+  void start_running(time_interval& itv);
+  void stop_running(const time_interval& itv);
 
   sync_status process_this(
       time_sync& node, small_event_vec& pendingEvents, small_event_vec& maxReachedEvents,
-      interval_set& started, interval_set& stopped, ossia::time_value tick_offset,
+      interval_bitset& started, interval_bitset& stopped, ossia::time_value tick_offset,
       const token_request& tok);
 
   sync_status trigger_sync(
       time_sync& node, small_event_vec& pending, small_event_vec& maxReachedEv,
-      interval_set& started, interval_set& stopped, ossia::time_value tick_offset,
+      interval_bitset& started, interval_bitset& stopped, ossia::time_value tick_offset,
       const token_request& req, bool maxReached);
 
   sync_status process_this_musical(
@@ -21,6 +21,8 @@ time_sync::time_sync()
     , m_status{status::NOT_DONE}
     , m_start{}
     , m_observe{}
+    , m_incremental{}
+    , m_expression_result{}
     , m_evaluating{}
     , m_muted{}
     , m_autotrigger{}
@@ -64,7 +66,19 @@ const expression& time_sync::get_expression() const noexcept
 time_sync& time_sync::set_expression(expression_ptr exp) noexcept
 {
   assert(exp);
+
+  // The observation moves to the new expression
+  if(m_callback)
+  {
+    expressions::remove_callback(*m_expression, *m_callback);
+    m_callback = std::nullopt;
+  }
+
   m_expression = std::move(exp);
+  m_expression_changed = true;
+
+  if(m_observe)
+    add_observer_callback();
   return *this;
 }
 
@@ -155,8 +169,12 @@ void time_sync::observe_expression(
       {
         std::cerr << "Warning: time_sync can only have one callback\n";
         expressions::remove_callback(*m_expression, *m_callback);
+        m_callback = std::nullopt;
       }
-      m_callback = expressions::add_callback(*m_expression, cb);
+
+      m_observer = std::move(cb);
+      m_expression_changed = true;
+      add_observer_callback();
     }
     else
     {
@@ -170,6 +188,38 @@ void time_sync::observe_expression(
   }
 }
 
+void time_sync::add_observer_callback()
+{
+  if(*m_expression == expressions::expression_true()
+     || *m_expression == expressions::expression_false())
+  {
+    m_incremental = false;
+    return;
+  }
+
+  // The expression is evaluated again only when one of its inputs
+  // notifies a change
+  m_incremental = expressions::is_observable(*m_expression);
+  m_callback = expressions::add_callback(*m_expression, [this](bool b) {
+    m_expression_changed.store(true, std::memory_order_release);
+    if(m_observer)
+      m_observer(b);
+  });
+}
+
+bool time_sync::evaluate_expression()
+{
+  if(!m_observe || !m_incremental)
+    return expressions::evaluate(*m_expression);
+
+  // Cleared before evaluating so that a change happening meanwhile
+  // is not missed
+  if(m_expression_changed.exchange(false, std::memory_order_acquire))
+    m_expression_result = expressions::evaluate(*m_expression);
+
+  return m_expression_result;
+}
+
 void time_sync::reset()
 {
   if(m_expression)
@@ -183,6 +233,7 @@ void time_sync::reset()
   m_trigger_date = Infinite;
   m_status = status::NOT_DONE;
   m_observe = false;
+  m_expression_changed = true;
   m_evaluating = false;
   m_is_being_triggered = false;
 }
@@ -176,6 +176,13 @@ public:
   void observe_expression(bool);
   void observe_expression(bool, ossia::expressions::expression_result_callback cb);
 
+  /*! evaluate the expression of the #time_sync
+   \details while the expression is observed, it is only evaluated again
+   after one of the parameters it refers to has changed; the previous
+   result is returned otherwise.
+   \return bool result of the evaluation */
+  bool evaluate_expression();
+
   //! Resets the internal state. Necessary when restarting an execution.
   void reset();
 
@@ -218,10 +225,14 @@ public:
   [[nodiscard]] bool is_being_triggered() const noexcept { return m_is_being_triggered; }
 
 private:
+  void add_observer_callback();
+
   ossia::expression_ptr m_expression;
   container m_timeEvents;
 
   std::optional<expressions::expression_callback_iterator> m_callback;
+  expressions::expression_result_callback m_observer;
+  std::atomic_bool m_expression_changed{true};
 
   double m_sync_rate = 0.;
 
@@ -230,6 +241,8 @@ private:
   status m_status : 2;
   bool m_start : 1;
   bool m_observe : 1;
+  bool m_incremental : 1;
+  bool m_expression_result : 1;
   bool m_evaluating : 1;
   bool m_muted : 1;
   bool m_autotrigger : 1;
@@ -1,3 +1,5 @@
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/detail/audio_spin_mutex.hpp>
 #include <ossia/detail/logger.hpp>
 #include <ossia/math/math_expression.hpp>
 #include <ossia/math/safe_math.hpp>
@@ -11,6 +13,7 @@
 #include <cmath>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <complex>
@@ -24,10 +27,14 @@
 #include <limits>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <stack>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #pragma GCC visibility pop
@@ -83,16 +90,450 @@ struct perlin<T, 1> : public exprtk::ifunction<T>
   }
 };
 
+// Variable bound to an array in math_expression::values
+struct array_variable
+{
+  std::string name;
+  double value{}; // Current element, when evaluating point by point
+};
+
+// The expression, compiled to evaluate a block of points at once:
+// each array variable is an exprtk vector, and the expression is assigned
+// to an output vector.
+// It is compiled for a capacity: blocks of that size are evaluated in
+// place, smaller ones are copied into the padded scratch arrays.
+struct block_expression
+{
+  block_expression(std::size_t arrays, std::size_t n)
+      : scratch((arrays + 1) * n)
+      , output{exprtk::make_vector_view(scratch.data() + arrays * n, n)}
+      , capacity{n}
+  {
+  }
+
+  double* scratch_input(std::size_t k) noexcept
+  {
+    return scratch.data() + k * capacity;
+  }
+  double* scratch_output() noexcept
+  {
+    return scratch.data() + inputs.size() * capacity;
+  }
+
+  void run(const double* const* in, double* out, std::size_t n)
+  {
+    const auto num_arrays = inputs.size();
+    if(n == capacity)
+    {
+      // A pointwise expression does not write to its inputs
+      for(std::size_t k = 0; k < num_arrays; k++)
+        inputs[k].rebase(const_cast<double*>(in[k]));
+      output.rebase(out);
+      expr.value();
+    }
+    else
+    {
+      for(std::size_t k = 0; k < num_arrays; k++)
+      {
+        std::copy_n(in[k], n, scratch_input(k));
+        inputs[k].rebase(scratch_input(k));
+      }
+      output.rebase(scratch_output());
+      expr.value();
+      std::copy_n(scratch_output(), n, out);
+    }
+  }
+
+  // One array per input, then the output
+  std::vector<double> scratch;
+  std::deque<exprtk::vector_view<double>> inputs;
+  exprtk::vector_view<double> output;
+  exprtk::symbol_table<double> syms;
+  exprtk::expression<double> expr;
+  std::size_t capacity{};
+  bool valid{};
+};
+
+// One compilation of a shared expression. It is evaluated on its own copy
+// of the variables, which an instance loads before each evaluation and
+// stores back after, since the expression can assign them.
+struct compiled_expression
+{
+  rand_gen<double> random;
+  perlin<double, 1> noise1d;
+  std::deque<double> slots;
+  exprtk::symbol_table<double> syms;
+  exprtk::expression<double> expr;
+};
+
+// Expression shared by the math_expression instances with the same text
+// and the same variables.
+// An evaluation takes a compiled copy out of the pool and gives it back
+// after: the lock is only held for this, never during an evaluation.
+// The copies are compiled when the instances are, never during an
+// evaluation: one per instance, up to one per hardware thread.
+struct shared_expression
+{
+  std::vector<std::string> variables;
+  std::string error;
+  bool valid{};
+
+  // Only waits when more threads than there are hardware threads
+  // evaluate the expression at the same time.
+  std::unique_ptr<compiled_expression> acquire()
+  {
+    for(;;)
+    {
+      {
+        std::lock_guard lock{mutex};
+        if(!pool.empty())
+        {
+          auto c = std::move(pool.back());
+          pool.pop_back();
+          return c;
+        }
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  // Does not allocate: the pool never holds more than the copies added
+  void release(std::unique_ptr<compiled_expression> c)
+  {
+    std::lock_guard lock{mutex};
+    pool.push_back(std::move(c));
+  }
+
+  void add_copy(std::unique_ptr<compiled_expression> c)
+  {
+    std::lock_guard lock{mutex};
+    pool.push_back(std::move(c));
+    copies++;
+  }
+
+  // Returns the number of copies to compile for the new instance
+  std::size_t add_user()
+  {
+    static const std::size_t max_copies
+        = std::max(1u, std::thread::hardware_concurrency());
+
+    std::lock_guard lock{mutex};
+    users++;
+    const auto wanted = std::min(users, max_copies);
+    return wanted > copies ? wanted - copies : 0;
+  }
+
+  void remove_user()
+  {
+    std::lock_guard lock{mutex};
+    users--;
+  }
+
+private:
+  ossia::audio_spin_mutex mutex;
+  std::vector<std::unique_ptr<compiled_expression>> pool;
+  std::size_t copies{};
+  std::size_t users{};
+};
+
+// Process-wide cache of the compiled expressions, keyed by the text of the
+// expression and the layout of its variables. The instances keep their
+// expression alive: the cache only references them.
+class expression_cache
+{
+public:
+  static expression_cache& instance()
+  {
+    static expression_cache cache;
+    return cache;
+  }
+
+  template <typename Compile>
+  std::shared_ptr<shared_expression> find(const std::string& key, Compile&& compile)
+  {
+    std::lock_guard lock{m_mutex};
+    auto& entry = m_entries[key];
+    if(auto e = entry.lock())
+    {
+      hits.fetch_add(1, std::memory_order_relaxed);
+      return e;
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+    auto e = compile();
+    entry = e;
+
+    if(m_entries.size() >= m_next_purge)
+    {
+      for(auto it = m_entries.begin(); it != m_entries.end();)
+        it = it->second.expired() ? m_entries.erase(it) : std::next(it);
+      m_next_purge = std::max(std::size_t(64), 2 * m_entries.size());
+    }
+    return e;
+  }
+
+  std::atomic<std::size_t> hits{};
+  std::atomic<std::size_t> misses{};
+
+private:
+  std::mutex m_mutex;
+  std::unordered_map<std::string, std::weak_ptr<shared_expression>> m_entries;
+  std::size_t m_next_purge{64};
+};
+
 struct math_expression::impl
 {
+  // Variable or constant added to the instance
+  struct binding
+  {
+    std::string name;
+    double* value{};
+    bool constant{};
+  };
+
   rand_gen<double> random;
   perlin<double, 1> noise1d;
   exprtk::symbol_table<double> syms;
   exprtk::expression<double> expr;
-  exprtk::parser<double> parser;
+  std::unique_ptr<exprtk::parser<double>> parser_ptr;
   std::string cur_expr_txt;
   std::vector<std::string> variables;
+  std::deque<array_variable> arrays;
+  std::unique_ptr<block_expression> block;
   bool valid{};
+
+  std::vector<binding> bindings;
+  std::vector<std::size_t> array_bindings; // Index of each array in bindings
+  int vectors{};
+  bool constants{};
+  std::shared_ptr<shared_expression> shared;
+
+  ~impl() { release_shared(); }
+
+  exprtk::parser<double>& parser()
+  {
+    // Not needed when the expression is found in the cache
+    if(!parser_ptr)
+      parser_ptr = std::make_unique<exprtk::parser<double>>();
+    return *parser_ptr;
+  }
+
+  // The vectors added with add_vector are bound by reference: an expression
+  // using them cannot be shared.
+  bool shareable() const noexcept { return vectors == 0; }
+
+  std::string cache_key() const
+  {
+    std::string key = cur_expr_txt;
+    key += '\0';
+    for(const auto& b : bindings)
+    {
+      key += b.constant ? 'c' : 'v';
+      key += b.name;
+      // Constants are folded in the compiled expression
+      if(b.constant)
+        key.append(reinterpret_cast<const char*>(b.value), sizeof(double));
+      key += '\0';
+    }
+    key += constants ? 'k' : '-';
+    return key;
+  }
+
+  std::unique_ptr<compiled_expression> compile_copy()
+  {
+    auto c = std::make_unique<compiled_expression>();
+    c->syms.add_function("random", c->random);
+    c->syms.add_function("noise", c->noise1d);
+    for(const auto& b : bindings)
+    {
+      auto& slot = c->slots.emplace_back(*b.value);
+      if(b.constant)
+        c->syms.add_constant(b.name, slot);
+      else
+        c->syms.add_variable(b.name, slot);
+    }
+    if(constants)
+      c->syms.add_constants();
+    c->expr.register_symbol_table(c->syms);
+
+    if(!parser().compile(cur_expr_txt, c->expr))
+      return {};
+    return c;
+  }
+
+  std::shared_ptr<shared_expression> compile_shared()
+  {
+    auto e = std::make_shared<shared_expression>();
+    if(auto c = compile_copy())
+    {
+      e->valid = true;
+      exprtk::collect_variables(cur_expr_txt, e->variables);
+      e->add_copy(std::move(c));
+    }
+    else
+    {
+      e->error = parser().error();
+    }
+    return e;
+  }
+
+  void acquire_shared()
+  {
+    shared = expression_cache::instance().find(
+        cache_key(), [this] { return compile_shared(); });
+    if(!shared->valid)
+      return;
+
+    for(auto n = shared->add_user(); n > 0; n--)
+      if(auto c = compile_copy())
+        shared->add_copy(std::move(c));
+  }
+
+  void release_shared()
+  {
+    if(shared && shared->valid)
+      shared->remove_user();
+    shared.reset();
+  }
+
+  // The expression evaluated by the instance: its own, or a copy of the
+  // shared one loaded with the variables of the instance, which get back
+  // the values assigned by the expression when the evaluation ends.
+  class evaluation
+  {
+  public:
+    explicit evaluation(impl& self)
+        : m_self{self}
+    {
+      if(!self.shared || !self.shared->valid)
+        return;
+
+      m_copy = self.shared->acquire();
+      const auto n = std::min(m_copy->slots.size(), self.bindings.size());
+      for(std::size_t i = 0; i < n; i++)
+        if(!self.bindings[i].constant)
+          m_copy->slots[i] = *self.bindings[i].value;
+    }
+
+    evaluation(const evaluation&) = delete;
+    evaluation& operator=(const evaluation&) = delete;
+
+    ~evaluation()
+    {
+      if(!m_copy)
+        return;
+
+      const auto n = std::min(m_copy->slots.size(), m_self.bindings.size());
+      for(std::size_t i = 0; i < n; i++)
+        if(!m_self.bindings[i].constant)
+          *m_self.bindings[i].value = m_copy->slots[i];
+      m_self.shared->release(std::move(m_copy));
+    }
+
+    exprtk::expression<double>& expr() noexcept
+    {
+      return m_copy ? m_copy->expr : m_self.expr;
+    }
+
+    //! Variable of the k-th array added with add_array
+    double& array(std::size_t k) noexcept
+    {
+      return m_copy ? m_copy->slots[m_self.array_bindings[k]] : m_self.arrays[k].value;
+    }
+
+  private:
+    impl& m_self;
+    std::unique_ptr<compiled_expression> m_copy;
+  };
+
+  bool is_array(const std::string& var) const noexcept
+  {
+    return ossia::any_of(arrays, [&](const auto& a) { return a.name == var; });
+  }
+
+  // Symbols of the expression evaluated per block, with array variables
+  // as vectors of size n.
+  void add_block_symbols(
+      exprtk::symbol_table<double>& block_syms,
+      std::deque<exprtk::vector_view<double>>& views, double* data, std::size_t n)
+  {
+    // Scalar variables and constants are shared with the point-by-point
+    // expression. Functions are not: none of them takes vectors, and
+    // random() must give a different value at each point.
+    std::vector<std::string> names;
+    syms.get_variable_list(names);
+    for(const auto& name : names)
+    {
+      if(is_array(name))
+        continue;
+
+      if(syms.is_constant_node(name))
+        block_syms.add_constant(name, syms.get_variable(name)->value());
+      else
+        block_syms.add_variable(name, syms.get_variable(name)->ref());
+    }
+
+    for(const auto& a : arrays)
+    {
+      views.push_back(exprtk::make_vector_view(data, n));
+      block_syms.add_vector(a.name, views.back());
+    }
+  }
+
+  // Whether the expression is a function of the current point only:
+  // no assignment, no control structure, and only the functions which apply
+  // element-wise to vectors. Others, such as min or avg, would aggregate
+  // the whole block.
+  bool is_pointwise(std::size_t n)
+  {
+    using parser_t = exprtk::parser<double>;
+    using settings_t = parser_t::settings_t;
+    settings_t settings;
+    settings.disable_all_assignment_ops();
+    settings.disable_all_control_structures();
+    settings.disable_all_logic_ops();
+    settings.disable_local_vardef();
+    settings.disable_all_base_functions();
+    for(auto f :
+        {settings_t::e_bf_abs,   settings_t::e_bf_ceil,    settings_t::e_bf_floor,
+         settings_t::e_bf_round, settings_t::e_bf_trunc,   settings_t::e_bf_frac,
+         settings_t::e_bf_sgn,   settings_t::e_bf_exp,     settings_t::e_bf_expm1,
+         settings_t::e_bf_log,   settings_t::e_bf_log10,   settings_t::e_bf_log2,
+         settings_t::e_bf_log1p, settings_t::e_bf_sqrt,    settings_t::e_bf_sin,
+         settings_t::e_bf_cos,   settings_t::e_bf_tan,     settings_t::e_bf_asin,
+         settings_t::e_bf_acos,  settings_t::e_bf_atan,    settings_t::e_bf_sinh,
+         settings_t::e_bf_cosh,  settings_t::e_bf_tanh,    settings_t::e_bf_deg2rad,
+         settings_t::e_bf_rad2deg})
+      settings.enable_base_function(f);
+
+    // Checked with symbols of its own, destroyed along with the expression
+    std::vector<double> data(n);
+    std::deque<exprtk::vector_view<double>> views;
+    exprtk::symbol_table<double> check_syms;
+    add_block_symbols(check_syms, views, data.data(), n);
+
+    exprtk::expression<double> check;
+    check.register_symbol_table(check_syms);
+    parser_t check_parser{settings};
+    return check_parser.compile(cur_expr_txt, check);
+  }
+
+  std::unique_ptr<block_expression> compile_block(std::size_t n)
+  {
+    auto b = std::make_unique<block_expression>(arrays.size(), n);
+    if(!is_pointwise(n))
+      return b;
+
+    add_block_symbols(b->syms, b->inputs, b->scratch.data(), n);
+    for(std::size_t k = 0; k < b->inputs.size(); k++)
+      b->inputs[k].rebase(b->scratch_input(k));
+    b->syms.add_vector("ossia_out", b->output);
+    b->expr.register_symbol_table(b->syms);
+
+    exprtk::parser<double> block_parser;
+    b->valid = block_parser.compile("ossia_out := (" + cur_expr_txt + ");", b->expr);
+    return b;
+  }
 };
 
 math_expression::math_expression()
@@ -110,26 +551,40 @@ math_expression::~math_expression()
 void math_expression::add_variable(const std::string& var, double& value)
 {
   impl->syms.add_variable(var, value);
+  impl->bindings.push_back({var, &value, false});
 }
 
 void math_expression::add_constant(const std::string& var, double& value)
 {
   impl->syms.add_constant(var, value);
+  impl->bindings.push_back({var, &value, true});
 }
 
 void math_expression::add_vector(const std::string& var, std::vector<double>& value)
 {
-  impl->syms.add_vector(var, value);
+  if(impl->syms.add_vector(var, value))
+    impl->vectors++;
 }
 
 void math_expression::remove_vector(const std::string& var)
 {
-  impl->syms.remove_vector(var);
+  if(impl->syms.remove_vector(var))
+    impl->vectors--;
+}
+
+void math_expression::add_array(const std::string& var)
+{
+  auto& a = impl->arrays.emplace_back();
+  a.name = var;
+  impl->syms.add_variable(var, a.value);
+  impl->array_bindings.push_back(impl->bindings.size());
+  impl->bindings.push_back({var, &a.value, false});
 }
 
 void math_expression::add_constants()
 {
   impl->syms.add_constants();
+  impl->constants = true;
 }
 
 void math_expression::register_symbol_table()
@@ -162,15 +617,29 @@ bool math_expression::has_variable(std::string_view var) const noexcept
 bool math_expression::recompile()
 {
   impl->variables.clear();
+  impl->block.reset();
+  impl->release_shared();
 
-  impl->valid = impl->parser.compile(impl->cur_expr_txt, impl->expr);
+  if(impl->shareable())
+  {
+    impl->acquire_shared();
+    impl->valid = impl->shared->valid;
+    if(impl->valid)
+      impl->variables = impl->shared->variables;
+    else
+      ossia::logger().error("Error while parsing: {}", impl->shared->error);
+
+    return impl->valid;
+  }
+
+  impl->valid = impl->parser().compile(impl->cur_expr_txt, impl->expr);
   if(impl->valid)
   {
     exprtk::collect_variables(impl->cur_expr_txt, impl->variables);
   }
   else
   {
-    ossia::logger().error("Error while parsing: {}", impl->parser.error());
+    ossia::logger().error("Error while parsing: {}", impl->parser().error());
   }
 
   return impl->valid;
@@ -178,12 +647,56 @@ bool math_expression::recompile()
 
 std::string math_expression::error() const
 {
-  return impl->parser.error();
+  if(impl->shared)
+    return impl->shared->error;
+  return impl->parser_ptr ? impl->parser_ptr->error() : std::string{};
+}
+
+bool math_expression::evaluates_blocks() const noexcept
+{
+  return impl->block && impl->block->valid;
+}
+
+math_expression::cache_statistics math_expression::cache_stats() noexcept
+{
+  auto& cache = expression_cache::instance();
+  return {
+      cache.hits.load(std::memory_order_relaxed),
+      cache.misses.load(std::memory_order_relaxed)};
 }
 
 double math_expression::value()
 {
-  return impl->expr.value();
+  impl::evaluation e{*impl};
+  return e.expr().value();
+}
+
+void math_expression::values(const double* const* inputs, double* out, std::size_t n)
+{
+  if(n == 0)
+    return;
+
+  auto& self = *impl;
+  const auto num_arrays = self.arrays.size();
+
+  // Compiled again only when a block is larger than all the previous ones
+  if(self.valid && (!self.block || self.block->capacity < n))
+    self.block = self.compile_block(n);
+
+  if(self.block && self.block->valid)
+  {
+    self.block->run(inputs, out, n);
+    return;
+  }
+
+  impl::evaluation e{self};
+  auto& expr = e.expr();
+  for(std::size_t i = 0; i < n; i++)
+  {
+    for(std::size_t k = 0; k < num_arrays; k++)
+      e.array(k) = inputs[k][i];
+    out[i] = expr.value();
+  }
 }
 
 static std::vector<ossia::value> result_to_vec(auto& r)
@@ -251,11 +764,13 @@ static ossia::value result_to_value(auto& r)
 
 ossia::value math_expression::result()
 {
-  double v = impl->expr.value();
+  impl::evaluation e{*impl};
+  auto& expr = e.expr();
+  double v = expr.value();
   if(!ossia::safe_isnan(v))
     return v;
   else
-    return result_to_value(impl->expr.results());
+    return result_to_value(expr.results());
 }
 
 }
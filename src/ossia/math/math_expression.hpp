@@ -18,6 +18,13 @@ public:
   void add_constant(const std::string& var, double& value);
   void add_vector(const std::string& var, std::vector<double>& value);
   void remove_vector(const std::string& var);
+
+  /**
+   * @brief Adds a variable whose values are read from an array by values().
+   *
+   * Arrays are numbered in the order in which they are added.
+   */
+  void add_array(const std::string& var);
   void add_constants();
   void register_symbol_table();
   void update_symbol_table();
@@ -28,8 +35,43 @@ public:
   bool has_variable(std::string_view var) const noexcept;
   std::string error() const;
 
+  /**
+   * @brief Counters of the process-wide cache of compiled expressions.
+   *
+   * Instances with the same expression and the same variables share their
+   * compiled expression: compiling the second one is a cache hit.
+   * Instances evaluated at the same time by different threads each use
+   * a copy of it. The copies are compiled along with the instances, one
+   * per instance up to one per hardware thread: evaluating never compiles.
+   * Instances using vectors (add_vector) are compiled on their own.
+   */
+  struct cache_statistics
+  {
+    std::size_t hits{};
+    std::size_t misses{};
+  };
+  static cache_statistics cache_stats() noexcept;
+
   double value();
 
+  /**
+   * @brief Evaluates the expression at n points.
+   *
+   * For the i-th point, the variables added with add_array take the i-th
+   * element of their array in inputs, and the result is written in out[i].
+   *
+   * Element-wise expressions are evaluated a whole block at a time, with
+   * what does not depend on the arrays computed once per block. Others
+   * (assignments, control structures, random(), ...) are evaluated point
+   * by point.
+   * The block form is compiled for the largest n seen so far: smaller
+   * blocks are copied into arrays of that size.
+   */
+  void values(const double* const* inputs, double* out, std::size_t n);
+
+  //! Whether the last call to values() evaluated a whole block at a time
+  [[nodiscard]] bool evaluates_blocks() const noexcept;
+
   ossia::value result();
 
 private:
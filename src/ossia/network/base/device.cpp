@@ -1,6 +1,8 @@
 // This is an open source non-commercial project. Dear PVS-Studio, please check
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include <ossia/network/base/device.hpp>
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/base/parameter_index.hpp>
 #include <ossia/network/base/protocol.hpp>
 
 namespace ossia::net
@@ -9,7 +11,35 @@ device_base::~device_base() = default;
 
 device_base::device_base(std::unique_ptr<protocol_base> proto)
     : m_protocol{std::move(proto)}
+    , m_parameterIndex{std::make_unique<parameter_index>(*this)}
 {
+  // The tree is still empty: nothing to index yet
+}
+
+parameter_base* device_base::find_parameter(ossia::string_view osc_address)
+{
+  if(m_parameterIndex)
+  {
+    if(auto p = m_parameterIndex->find(osc_address))
+      return p;
+  }
+
+  if(auto n = ossia::net::find_node(get_root_node(), osc_address))
+    return n->get_parameter();
+  return nullptr;
+}
+
+void device_base::set_parameter_index_enabled(bool enabled)
+{
+  if(enabled && !m_parameterIndex)
+  {
+    m_parameterIndex = std::make_unique<parameter_index>(*this);
+    m_parameterIndex->rebuild();
+  }
+  else if(!enabled)
+  {
+    m_parameterIndex.reset();
+  }
 }
 
 protocol_base& device_base::get_protocol() const
@@ -12,6 +12,7 @@ namespace net
 {
 struct parameter_data;
 class protocol_base;
+class parameter_index;
 
 /**
  * @brief What a device is able to do
@@ -81,6 +82,27 @@ public:
 
   void set_echo(bool echo) { m_echo = echo; }
 
+  /**
+   * @brief Finds the parameter at an OSC address, e.g. "/foo/bar".
+   *
+   * Meant for the receive path of the protocols: when the parameter index
+   * is enabled, this is a single hash lookup; otherwise, or if the address
+   * is not indexed, the node tree is searched.
+   */
+  ossia::net::parameter_base* find_parameter(ossia::string_view osc_address);
+
+  /**
+   * @brief Maintains an index from OSC addresses to parameters.
+   *
+   * Enabled by default. Disabling it frees its memory and makes the
+   * creation and removal of parameters a bit cheaper.
+   */
+  void set_parameter_index_enabled(bool enabled);
+  ossia::net::parameter_index* get_parameter_index() const noexcept
+  {
+    return m_parameterIndex.get();
+  }
+
   void apply_incoming_message(
       const message_origin_identifier& id, ossia::net::parameter_base& param,
       ossia::value&& value);
@@ -118,6 +140,7 @@ public:
 
 protected:
   std::unique_ptr<ossia::net::protocol_base> m_protocol;
+  std::unique_ptr<ossia::net::parameter_index> m_parameterIndex;
   device_capabilities m_capabilities{};
   bool m_echo{false};
 };
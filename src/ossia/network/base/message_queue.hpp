@@ -1,10 +1,19 @@
 #pragma once
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/detail/audio_spin_mutex.hpp>
 #include <ossia/detail/ptr_set.hpp>
 #include <ossia/network/base/device.hpp>
 #include <ossia/network/base/parameter.hpp>
 
 #include <concurrentqueue.h>
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace ossia
 {
 struct received_value
@@ -13,6 +22,72 @@ struct received_value
   ossia::value value;
 };
 
+namespace detail
+{
+/**
+ * @brief One moodycamel producer token per thread enqueuing in a queue.
+ *
+ * Explicit producers are much cheaper than the implicit ones which
+ * moodycamel looks up from the thread id at each enqueue.
+ * The tokens are owned by this object: it must be destroyed before the queue.
+ */
+template <typename Queue>
+class thread_producer_tokens
+{
+public:
+  explicit thread_producer_tokens(Queue& q)
+      : m_queue{q}
+  {
+  }
+
+  moodycamel::ProducerToken& get()
+  {
+    struct cache_t
+    {
+      uint64_t id{};
+      moodycamel::ProducerToken* token{};
+    };
+    static thread_local cache_t cache;
+    if(cache.id == m_id)
+      return *cache.token;
+
+    const auto tid = std::this_thread::get_id();
+    std::lock_guard _{m_mutex};
+    auto it = ossia::find_if(m_tokens, [=](const auto& t) { return t.first == tid; });
+    if(it == m_tokens.end())
+    {
+      m_tokens.emplace_back(tid, std::make_unique<moodycamel::ProducerToken>(m_queue));
+      it = m_tokens.end() - 1;
+    }
+    cache = {m_id, it->second.get()};
+    return *cache.token;
+  }
+
+private:
+  static uint64_t next_id() noexcept
+  {
+    static std::atomic_uint64_t id{};
+    return ++id;
+  }
+
+  Queue& m_queue;
+  const uint64_t m_id = next_id();
+  std::mutex m_mutex;
+  std::vector<std::pair<std::thread::id, std::unique_ptr<moodycamel::ProducerToken>>>
+      m_tokens;
+};
+}
+
+/**
+ * @brief Values received by the registered parameters of a device.
+ *
+ * Parameters callbacks can be called from any thread; dequeuing must
+ * happen from a single thread at a time.
+ *
+ * When coalescing is enabled, only the most recent value of each parameter
+ * is kept until it is dequeued: the queue then only carries one entry
+ * per parameter which received something.
+ */
 class message_queue final : public Nano::Observer
 {
 public:
@@ -37,7 +112,39 @@ public:
     }
   }
 
-  bool try_dequeue(ossia::received_value& v) { return m_queue.try_dequeue(v); }
+  void set_coalesce(bool b) noexcept { m_coalesce.store(b, std::memory_order_relaxed); }
+  [[nodiscard]] bool coalesce() const noexcept
+  {
+    return m_coalesce.load(std::memory_order_relaxed);
+  }
+
+  bool try_dequeue(ossia::received_value& v)
+  {
+    queued_value q;
+    if(!m_queue.try_dequeue(q))
+      return false;
+    v = take(q);
+    return true;
+  }
+
+  /**
+   * Dequeues in bulk and calls f with each received_value, moved out of the queue.
+   * Returns the number of values passed to f.
+   */
+  template <typename F>
+  std::size_t drain(F&& f)
+  {
+    std::size_t total = 0;
+    std::size_t n = 0;
+    do
+    {
+      n = m_queue.try_dequeue_bulk(m_consumer, m_bulk.begin(), m_bulk.size());
+      for(std::size_t i = 0; i < n; i++)
+        f(take(m_bulk[i]));
+      total += n;
+    } while(n == m_bulk.size());
+    return total;
+  }
 
   void reg(ossia::net::parameter_base& p)
   {
@@ -45,8 +152,26 @@ public:
     auto reg_it = m_reg.find(&p);
     if(reg_it == m_reg.end())
     {
-      auto it = p.add_callback([this, ptr](const ossia::value& val) {
-        m_queue.enqueue({ptr, val});
+      auto& latest = m_latest[ptr];
+      if(!latest)
+        latest = std::make_unique<latest_value>();
+
+      auto it = p.add_callback([this, ptr, l = latest.get()](const ossia::value& val) {
+        auto& token = m_producers.get();
+        if(!m_coalesce.load(std::memory_order_relaxed))
+        {
+          m_queue.enqueue(token, {ptr, val, nullptr});
+          return;
+        }
+
+        bool pending{};
+        {
+          std::lock_guard _{l->mutex};
+          l->value = val;
+          pending = std::exchange(l->pending, true);
+        }
+        if(!pending)
+          m_queue.enqueue(token, {ptr, {}, l});
       });
       m_reg.insert({&p, {0, it}});
     }
@@ -71,6 +196,32 @@ public:
   }
 
 private:
+  // Most recent value of a parameter, when coalescing
+  struct latest_value
+  {
+    ossia::audio_spin_mutex mutex;
+    ossia::value value;
+    bool pending{};
+  };
+
+  struct queued_value
+  {
+    ossia::net::parameter_base* address{};
+    ossia::value value;
+    latest_value* latest{};
+  };
+
+  static ossia::received_value take(queued_value& q)
+  {
+    if(q.latest)
+    {
+      std::lock_guard _{q.latest->mutex};
+      q.latest->pending = false;
+      return {q.address, std::move(q.latest->value)};
+    }
+    return {q.address, std::move(q.value)};
+  }
+
   void on_param_removed(const ossia::net::parameter_base& p)
   {
     auto it = m_reg.find(const_cast<ossia::net::parameter_base*>(&p));
@@ -78,12 +229,20 @@ private:
       m_reg.erase(it);
   }
 
-  moodycamel::ConcurrentQueue<received_value> m_queue;
+  moodycamel::ConcurrentQueue<queued_value> m_queue;
+  moodycamel::ConsumerToken m_consumer{m_queue};
+  detail::thread_producer_tokens<moodycamel::ConcurrentQueue<queued_value>> m_producers{
+      m_queue};
+  std::array<queued_value, 64> m_bulk;
+  std::atomic_bool m_coalesce{};
 
   ossia::ptr_map<
       ossia::net::parameter_base*,
       std::pair<int, ossia::net::parameter_base::callback_index>>
       m_reg;
+
+  // Kept until the queue is destroyed, as queued values may point to them
+  ossia::ptr_map<ossia::net::parameter_base*, std::unique_ptr<latest_value>> m_latest;
 };
 
 class global_message_queue final : public Nano::Observer
@@ -96,12 +255,33 @@ public:
 
   void on_message(const ossia::net::parameter_base& p)
   {
-    m_queue.enqueue({const_cast<ossia::net::parameter_base*>(&p), p.value()});
+    m_queue.enqueue(
+        m_producers.get(), {const_cast<ossia::net::parameter_base*>(&p), p.value()});
   }
 
   bool try_dequeue(ossia::received_value& v) { return m_queue.try_dequeue(v); }
 
+  //! See message_queue::drain
+  template <typename F>
+  std::size_t drain(F&& f)
+  {
+    std::size_t total = 0;
+    std::size_t n = 0;
+    do
+    {
+      n = m_queue.try_dequeue_bulk(m_consumer, m_bulk.begin(), m_bulk.size());
+      for(std::size_t i = 0; i < n; i++)
+        f(std::move(m_bulk[i]));
+      total += n;
+    } while(n == m_bulk.size());
+    return total;
+  }
+
 private:
   moodycamel::ConcurrentQueue<received_value> m_queue;
+  moodycamel::ConsumerToken m_consumer{m_queue};
+  detail::thread_producer_tokens<moodycamel::ConcurrentQueue<received_value>> m_producers{
+      m_queue};
+  std::array<received_value, 64> m_bulk;
 };
 }
@@ -352,7 +352,7 @@ std::vector<node_base*> find_nodes(node_base& root, string_view pattern)
     else
       return {};
   }
-  else if(auto path = traversal::make_path(pattern))
+  else if(auto path = traversal::path_cache::instance().get(pattern))
   {
     std::vector<node_base*> nodes{&root};
     traversal::apply(*path, nodes);
@@ -13,6 +13,7 @@
 
 #include <nano_signal_slot.hpp>
 
+#include <atomic>
 #include <ciso646>
 #include <functional>
 #include <memory>
@@ -29,6 +30,7 @@ extern template class std::future<void>;
 namespace ossia
 {
 class value;
+class parameter_slots;
 namespace net
 {
 class node_base;
@@ -178,6 +180,12 @@ protected:
   bool m_disabled{};
   bool m_muted{};
   ossia::repetition_filter m_repetitionFilter{ossia::repetition_filter::OFF};
+
+private:
+  friend class ossia::parameter_slots;
+
+  //! Slot given to the parameter by the last ossia::parameter_slots which used it
+  mutable std::atomic_int m_slot{-1};
 };
 
 inline bool operator==(const parameter_base& lhs, const parameter_base& rhs)
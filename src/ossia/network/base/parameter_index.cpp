@@ -0,0 +1,149 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/node.hpp>
+#include <ossia/network/base/osc_address.hpp>
+#include <ossia/network/base/parameter.hpp>
+#include <ossia/network/base/parameter_index.hpp>
+
+namespace ossia::net
+{
+namespace
+{
+// Not every node type caches its address
+std::string address_of(const node_base& n)
+{
+  if(const auto& addr = n.osc_address(); !addr.empty())
+    return addr;
+  return osc_parameter_string(n);
+}
+}
+
+parameter_index::parameter_index(device_base& dev)
+    : m_device{dev}
+{
+  dev.on_node_created.connect<&parameter_index::on_node_created>(this);
+  dev.on_node_removing.connect<&parameter_index::on_node_removing>(this);
+  dev.on_node_renamed.connect<&parameter_index::on_node_renamed>(this);
+  dev.on_parameter_created.connect<&parameter_index::on_parameter_created>(this);
+  dev.on_parameter_removing.connect<&parameter_index::on_parameter_removing>(this);
+}
+
+parameter_index::~parameter_index()
+{
+  m_device.on_node_created.disconnect<&parameter_index::on_node_created>(this);
+  m_device.on_node_removing.disconnect<&parameter_index::on_node_removing>(this);
+  m_device.on_node_renamed.disconnect<&parameter_index::on_node_renamed>(this);
+  m_device.on_parameter_created.disconnect<&parameter_index::on_parameter_created>(
+      this);
+  m_device.on_parameter_removing.disconnect<&parameter_index::on_parameter_removing>(
+      this);
+}
+
+parameter_base* parameter_index::find(ossia::string_view osc_address) const
+{
+  read_lock_t lock{m_mutex};
+  auto it = m_map.find(osc_address);
+  return it != m_map.end() ? it->second : nullptr;
+}
+
+std::size_t parameter_index::size() const
+{
+  read_lock_t lock{m_mutex};
+  return m_map.size();
+}
+
+void parameter_index::rebuild()
+{
+  write_lock_t lock{m_mutex};
+  m_map.clear();
+  insert_rec(m_device.get_root_node());
+}
+
+void parameter_index::insert_rec(node_base& n)
+{
+  if(auto p = n.get_parameter())
+    m_map[address_of(n)] = p;
+
+  for(auto cld : n.children_copy())
+    insert_rec(*cld);
+}
+
+void parameter_index::on_node_created(node_base& n)
+{
+  // Most nodes get their parameter after their creation,
+  // but some node types are created with one.
+  if(auto p = n.get_parameter())
+  {
+    write_lock_t lock{m_mutex};
+    m_map[address_of(n)] = p;
+  }
+}
+
+void parameter_index::on_node_removing(node_base& n)
+{
+  // The children are removed first, so only this node is left to handle
+  auto p = n.get_parameter();
+  if(!p)
+    return;
+
+  write_lock_t lock{m_mutex};
+  auto it = m_map.find(address_of(n));
+  if(it != m_map.end() && it->second == p)
+    m_map.erase(it);
+}
+
+void parameter_index::on_node_renamed(node_base& n, std::string old_name)
+{
+  auto parent = n.get_parent();
+  if(!parent)
+    return;
+
+  // The addresses of the subtree were already updated:
+  // the old ones are recomputed from the old name.
+  const std::string new_prefix = address_of(n);
+  std::string old_prefix = address_of(*parent);
+  if(old_prefix.empty() || old_prefix.back() != '/')
+    old_prefix += '/';
+  old_prefix += old_name;
+
+  write_lock_t lock{m_mutex};
+  std::vector<node_base*> stack{&n};
+  while(!stack.empty())
+  {
+    node_base* cur = stack.back();
+    stack.pop_back();
+
+    if(auto p = cur->get_parameter())
+    {
+      std::string addr = address_of(*cur);
+      std::string old_addr = old_prefix;
+      old_addr.append(addr, new_prefix.size());
+
+      auto it = m_map.find(old_addr);
+      if(it != m_map.end() && it->second == p)
+        m_map.erase(it);
+      m_map[std::move(addr)] = p;
+    }
+
+    for(auto cld : cur->children_copy())
+      stack.push_back(cld);
+  }
+}
+
+void parameter_index::on_parameter_created(const parameter_base& p)
+{
+  auto addr = address_of(p.get_node());
+  write_lock_t lock{m_mutex};
+  m_map[std::move(addr)] = const_cast<parameter_base*>(&p);
+}
+
+void parameter_index::on_parameter_removing(const parameter_base& p)
+{
+  const auto addr = address_of(p.get_node());
+  write_lock_t lock{m_mutex};
+  auto it = m_map.find(addr);
+  if(it != m_map.end() && it->second == &p)
+    m_map.erase(it);
+}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <ossia/detail/mutex.hpp>
+#include <ossia/detail/string_map.hpp>
+
+#include <string>
+
+namespace ossia::net
+{
+class device_base;
+class node_base;
+class parameter_base;
+
+/**
+ * @brief Flat index from the OSC address of a parameter to the parameter.
+ *
+ * Finding a node from its address splits the address and does a linear
+ * search in the children of each level; this is a single hash lookup.
+ * The index follows the device tree through the signals of device_base:
+ * parameter creation and removal, node creation, removal and renaming.
+ *
+ * Lookups are thread-safe and can be done from the network threads.
+ *
+ * \see device_base::find_parameter
+ */
+class OSSIA_EXPORT parameter_index
+{
+public:
+  explicit parameter_index(device_base& dev);
+  ~parameter_index();
+
+  parameter_index(const parameter_index&) = delete;
+  parameter_index(parameter_index&&) = delete;
+  parameter_index& operator=(const parameter_index&) = delete;
+  parameter_index& operator=(parameter_index&&) = delete;
+
+  //! The address is the OSC address without the device, e.g. "/foo/bar"
+  [[nodiscard]] parameter_base* find(ossia::string_view osc_address) const;
+
+  [[nodiscard]] std::size_t size() const;
+
+  //! Indexes again every parameter of the device tree
+  void rebuild();
+
+private:
+  void on_node_created(node_base& n);
+  void on_node_removing(node_base& n);
+  void on_node_renamed(node_base& n, std::string old_name);
+  void on_parameter_created(const parameter_base& p);
+  void on_parameter_removing(const parameter_base& p);
+
+  void insert_rec(node_base& n) TS_REQUIRES(m_mutex);
+
+  device_base& m_device;
+  mutable shared_mutex_t m_mutex;
+  ossia::string_map<parameter_base*> m_map TS_GUARDED_BY(m_mutex);
+};
+}
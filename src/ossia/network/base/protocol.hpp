@@ -158,6 +158,12 @@ public:
 
   virtual void start_execution() { }
   virtual void stop_execution() { }
+
+  //! Called at the beginning and at the end of each execution tick:
+  //! protocols which buffer their output during a tick send it in
+  //! flush_output.
+  virtual void begin_tick() { }
+  virtual void flush_output() { }
   virtual void stop() { }
 
   flags get_flags() const noexcept { return m_flags; }
@@ -7,6 +7,7 @@
 #include <ossia/network/base/node_functions.hpp>
 #include <ossia/network/base/parameter.hpp>
 #include <ossia/network/common/path.hpp>
+#include <ossia/network/common/path_pattern.hpp>
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -16,15 +17,12 @@
 #include <tsl/hopscotch_set.h>
 
 #include <iostream>
-#include <regex>
+#include <list>
+#include <mutex>
 
 namespace ossia::traversal
 {
-using rexp = std::shared_ptr<re2::RE2>;
-static inline bool rexp_match(std::string_view m, const rexp& r)
-{
-  return re2::RE2::FullMatch(m, *r);
-}
+using pattern_ptr = std::shared_ptr<const segment_pattern>;
 
 void apply(const path& p, std::vector<ossia::net::node_base*>& nodes)
 {
@@ -89,12 +87,13 @@ void get_all_children(std::vector<ossia::net::node_base*>& vec)
   get_all_children_rec(vec, inserted);
 }
 
-void match_device_with_regex(std::vector<ossia::net::node_base*>& vec, const rexp& r)
+void match_device_with_pattern(
+    std::vector<ossia::net::node_base*>& vec, const segment_pattern& r)
 {
   for(auto it = vec.cbegin(); it != vec.cend();)
   {
     const auto& name = (*it)->get_device().get_name();
-    if(!rexp_match(name, r))
+    if(!r.match(name))
       it = vec.erase(it);
     else
       ++it;
@@ -112,7 +111,7 @@ void match_device_simple(std::vector<ossia::net::node_base*>& vec, const std::st
   }
 }
 
-void match_with_regex(std::vector<ossia::net::node_base*>& vec, const rexp& r)
+void match_with_pattern(std::vector<ossia::net::node_base*>& vec, const segment_pattern& r)
 {
   ossia::small_vector<ossia::net::node_base*, 16> old(vec.begin(), vec.end());
   vec.clear();
@@ -121,7 +120,7 @@ void match_with_regex(std::vector<ossia::net::node_base*>& vec, const rexp& r)
   {
     for(auto& cld : node->children())
     {
-      if(rexp_match(cld->get_name(), r))
+      if(r.match(cld->get_name()))
       {
         vec.push_back(cld.get());
       }
@@ -146,18 +145,6 @@ void match_simple(std::vector<ossia::net::node_base*>& vec, const std::string& r
   }
 }
 
-struct regex_cache
-{
-  static regex_cache& instance()
-  {
-    static regex_cache c;
-    return c;
-  }
-
-  ossia::string_map<rexp> map;
-  std::mutex mutex;
-};
-
 std::string substitute_characters(const std::string& part)
 {
   std::string res;
@@ -189,16 +176,10 @@ std::string substitute_characters(const std::string& part)
   return res;
 }
 
-rexp make_regex(std::string& part)
+pattern_ptr make_pattern(std::string& part)
 {
-  // Perform the various regex-like replacements
-  // note: seriously, don't do this with regex if possible
   net::expand_ranges(part);
-  std::string res = "^";
-  res += substitute_characters(part);
-  res += "$";
-
-  return std::make_shared<re2::RE2>(res);
+  return std::make_shared<const segment_pattern>(part);
 }
 
 constexpr bool is_regex(std::string_view v)
@@ -216,7 +197,6 @@ constexpr bool is_regex(std::string_view v)
 
 void add_device_part(std::string part, path& p)
 {
-  // TODO LRU cache
   if(!is_regex(part))
   {
     p.child_functions.emplace_back(
@@ -224,23 +204,8 @@ void add_device_part(std::string part, path& p)
   }
   else
   {
-    auto& map = regex_cache::instance();
-    std::lock_guard<std::mutex> _(map.mutex);
-
-    auto it = map.map.find(part);
-    if(it != map.map.end())
-    {
-      p.child_functions.emplace_back(
-          [r = it->second](auto& v) { match_device_with_regex(v, r); });
-    }
-    else
-    {
-      std::string orig = part;
-
-      auto it = map.map.emplace(std::move(orig), make_regex(part));
-      p.child_functions.emplace_back(
-          [r = it.first->second](auto& v) { match_device_with_regex(v, r); });
-    }
+    p.child_functions.emplace_back(
+        [r = make_pattern(part)](auto& v) { match_device_with_pattern(v, *r); });
   }
 }
 
@@ -256,23 +221,8 @@ void add_relative_path(std::string& part, path& p)
     }
     else
     {
-      // TODO LRU cache
-      auto& map = regex_cache::instance();
-      std::lock_guard<std::mutex> _(map.mutex);
-
-      auto it = map.map.find(part);
-      if(it != map.map.end())
-      {
-        p.child_functions.emplace_back(
-            [r = it->second](auto& v) { match_with_regex(v, r); });
-      }
-      else
-      {
-        std::string orig = part;
-        auto it = map.map.emplace(std::move(orig), make_regex(part));
-        p.child_functions.emplace_back(
-            [r = it.first->second](auto& v) { match_with_regex(v, r); });
-      }
+      p.child_functions.emplace_back(
+          [r = make_pattern(part)](auto& v) { match_with_pattern(v, *r); });
     }
   }
   else
@@ -354,6 +304,58 @@ catch(...)
   return std::nullopt;
 }
 
+path_cache::path_cache(std::size_t capacity)
+    : m_capacity{std::max(capacity, std::size_t(1))}
+{
+  m_index.reserve(m_capacity);
+}
+
+path_cache::~path_cache() = default;
+
+path_cache& path_cache::instance()
+{
+  static path_cache c;
+  return c;
+}
+
+std::shared_ptr<const path> path_cache::get(ossia::string_view address)
+{
+  std::lock_guard<std::mutex> _(m_mutex);
+  if(auto it = m_index.find(address); it != m_index.end())
+  {
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->second;
+  }
+
+  std::shared_ptr<const path> p;
+  if(auto res = make_path(address))
+    p = std::make_shared<const path>(*std::move(res));
+
+  if(m_entries.size() >= m_capacity)
+  {
+    m_index.erase(ossia::string_view(m_entries.back().first));
+    m_entries.pop_back();
+  }
+
+  // The keys of the index point to the strings stored in the list nodes
+  m_entries.emplace_front(std::string(address), p);
+  m_index.emplace(ossia::string_view(m_entries.front().first), m_entries.begin());
+  return p;
+}
+
+std::size_t path_cache::size() const
+{
+  std::lock_guard<std::mutex> _(m_mutex);
+  return m_entries.size();
+}
+
+void path_cache::clear()
+{
+  std::lock_guard<std::mutex> _(m_mutex);
+  m_index.clear();
+  m_entries.clear();
+}
+
 bool match(const path& p, const ossia::net::node_base& node)
 {
   return match(p, node, node.get_device().get_root_node());
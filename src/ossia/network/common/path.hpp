@@ -1,12 +1,16 @@
 #pragma once
 #include <ossia/detail/optional.hpp>
 #include <ossia/detail/regex_fwd.hpp>
+#include <ossia/detail/string_map.hpp>
 #include <ossia/network/base/address_scope.hpp>
 #include <ossia/network/base/name_validation.hpp>
 
 #include <smallfun.hpp>
 
 #include <iosfwd>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace ossia
@@ -177,23 +181,23 @@ inline path_element operator/(const path_element& lhs, const stop& rhs)
  * //bin/bo??o/bee
  * buz:/{bee,boo}*
  *
- * We have a translation phase :
- * Let [:ossia:] be the regex character class defined by
+ * Let [:ossia:] be the character class defined by
  * ossia::net::name_characters()
  * "?"      -> [:ossia:]?
  * "*"      -> [:ossia:]*
  * "!"      -> any_instance()
  * "//"     -> any_path() /
  * ".."     -> get_parent()
- * "{1..5}" -> get_range()
- * "[..]"   -> already handled by the regex engine.
- * "{a,b}"  -> "(a|b)"
+ * "{1..5}" -> expanded to {1,2,3,4,5}
+ * "[..]"   -> character class, negated with "[!..]"
+ * "{a,b}"  -> a or b
  *
- * All given paths are ended by "$"
+ * Segments always have to match entirely.
  *
  * Given a path in the "user" format :
  * First try to find the largest absolute part from the beginning.
- * Then apply regexes to each sub-path and child node by splitting :
+ * Then compile each sub-path into a segment_pattern and match the child
+ * nodes by splitting :
  *
  * foo:/bar/baz / b*anana.?? / *.*
  * // bonkers / *
@@ -236,6 +240,38 @@ OSSIA_EXPORT bool is_pattern(ossia::string_view address);
  */
 OSSIA_EXPORT std::optional<path> make_path(ossia::string_view address);
 
+/**
+ * @brief Least-recently-used cache of parsed paths, keyed by their pattern.
+ *
+ * Parsing and compiling a pattern costs much more than matching it,
+ * and the same patterns tend to be received over and over.
+ * Thread-safe; the returned paths stay valid after their eviction.
+ */
+class OSSIA_EXPORT path_cache
+{
+public:
+  explicit path_cache(std::size_t capacity = 256);
+  ~path_cache();
+
+  //! Shared by find_nodes and the network protocols
+  static path_cache& instance();
+
+  //! Returns nullptr if the address is not a valid path
+  std::shared_ptr<const path> get(ossia::string_view address);
+
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+  void clear();
+
+private:
+  using entry = std::pair<std::string, std::shared_ptr<const path>>;
+
+  mutable std::mutex m_mutex;
+  std::list<entry> m_entries;
+  ossia::string_view_map<std::list<entry>::iterator> m_index;
+  std::size_t m_capacity{};
+};
+
 /**
  * @brief Get all the nodes matching a path, from a given list of root nodes.
  *
@@ -253,7 +289,7 @@ OSSIA_EXPORT bool match(const path& p, const ossia::net::node_base& node);
 OSSIA_EXPORT bool
 match(const path& p, const ossia::net::node_base& node, ossia::net::node_base& root);
 
-//! Convert ossia regex syntax to std::regex
+//! Convert ossia pattern syntax to a regex
 OSSIA_EXPORT std::string substitute_characters(const std::string& path);
 
 //! Only useful for tests
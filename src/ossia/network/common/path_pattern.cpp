@@ -0,0 +1,293 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/detail/small_vector.hpp>
+#include <ossia/network/base/name_validation.hpp>
+#include <ossia/network/common/path_pattern.hpp>
+
+#include <limits>
+#include <stdexcept>
+
+namespace ossia::traversal
+{
+namespace
+{
+// Reads a set in the syntax of regex character classes, e.g. "a-zA-Z_-",
+// until the end of the string or an unescaped ']'.
+std::size_t read_class(std::string_view p, std::size_t i, std::bitset<256>& c)
+{
+  const std::size_t begin = i;
+  for(; i < p.size(); i++)
+  {
+    unsigned char first = p[i];
+    if(first == ']' && i != begin)
+      break;
+    if(first == '\\' && i + 1 < p.size())
+      first = p[++i];
+
+    if(i + 2 < p.size() && p[i + 1] == '-' && p[i + 2] != ']')
+    {
+      const unsigned char last = p[i + 2];
+      for(unsigned int k = first; k <= last; k++)
+        c.set(k);
+      i += 2;
+    }
+    else
+    {
+      c.set(first);
+    }
+  }
+  return i;
+}
+
+std::bitset<256> make_class(std::string_view chars)
+{
+  std::bitset<256> c;
+  read_class(chars, 0, c);
+  return c;
+}
+
+enum : uint16_t
+{
+  name_class = 0,
+  instance_class = 1
+};
+}
+
+segment_pattern::segment_pattern(std::string_view pattern)
+{
+  m_classes.push_back(make_class(ossia::net::name_characters()));
+  m_classes.push_back(make_class(ossia::net::name_characters_no_instance()));
+
+  std::size_t i = 0;
+  compile(parse(pattern, i, false));
+  emit({opcode::accept});
+}
+
+uint16_t segment_pattern::add_class(const std::bitset<256>& c)
+{
+  for(std::size_t i = 0; i < m_classes.size(); i++)
+    if(m_classes[i] == c)
+      return i;
+  m_classes.push_back(c);
+  return m_classes.size() - 1;
+}
+
+uint16_t segment_pattern::parse_class(std::string_view p, std::size_t& i)
+{
+  // p[i] is the opening bracket
+  i++;
+  bool negate = false;
+  if(i < p.size() && (p[i] == '!' || p[i] == '^'))
+  {
+    negate = true;
+    i++;
+  }
+
+  std::bitset<256> c;
+  i = read_class(p, i, c);
+  if(i >= p.size())
+    throw std::runtime_error("Unterminated character class in pattern");
+  i++;
+
+  if(negate)
+    c.flip();
+  return add_class(c);
+}
+
+auto segment_pattern::parse(std::string_view p, std::size_t& i, bool in_alternative)
+    -> sequence
+{
+  sequence seq;
+  auto append_literal = [&](char c) {
+    if(seq.empty() || seq.back().type != kind::literal)
+      seq.push_back(token{kind::literal, 0, {}, {}});
+    seq.back().text += c;
+  };
+
+  while(i < p.size())
+  {
+    const char c = p[i];
+    if(in_alternative && (c == ',' || c == '}'))
+      break;
+
+    switch(c)
+    {
+      case '\\':
+        if(i + 1 < p.size())
+          i++;
+        append_literal(p[i]);
+        i++;
+        break;
+      case '?':
+        seq.push_back(token{kind::optional_char, name_class, {}, {}});
+        i++;
+        break;
+      case '*':
+        if(seq.empty() || seq.back().type != kind::any_chars)
+          seq.push_back(token{kind::any_chars, name_class, {}, {}});
+        i++;
+        break;
+      case '!':
+        seq.push_back(token{kind::instance, instance_class, {}, {}});
+        i++;
+        break;
+      case '[':
+        seq.push_back(token{kind::one_char, parse_class(p, i), {}, {}});
+        break;
+      case '{': {
+        token t{kind::alternatives, 0, {}, {}};
+        i++;
+        for(;;)
+        {
+          t.alternatives.push_back(parse(p, i, true));
+          if(i >= p.size())
+            throw std::runtime_error("Unterminated alternative in pattern");
+          if(p[i++] == '}')
+            break;
+        }
+        seq.push_back(std::move(t));
+        break;
+      }
+      default:
+        append_literal(c);
+        i++;
+        break;
+    }
+  }
+  return seq;
+}
+
+uint16_t segment_pattern::emit(instruction i)
+{
+  if(m_program.size() >= std::numeric_limits<uint16_t>::max())
+    throw std::runtime_error("Pattern too long");
+  m_program.push_back(i);
+  return m_program.size() - 1;
+}
+
+// Zero or more characters of a class
+void segment_pattern::compile_repeat(uint16_t char_class)
+{
+  const uint16_t split = emit({opcode::split});
+  emit({opcode::char_class, 0, char_class});
+  emit({opcode::jump, 0, 0, split});
+  m_program[split].next = split + 1;
+  m_program[split].alt = m_program.size();
+}
+
+void segment_pattern::compile(const sequence& seq)
+{
+  for(const token& t : seq)
+  {
+    switch(t.type)
+    {
+      case kind::literal:
+        for(char c : t.text)
+          emit({opcode::character, static_cast<unsigned char>(c)});
+        break;
+
+      case kind::one_char:
+        emit({opcode::char_class, 0, t.char_class});
+        break;
+
+      case kind::optional_char: {
+        const uint16_t split = emit({opcode::split});
+        emit({opcode::char_class, 0, t.char_class});
+        m_program[split].next = split + 1;
+        m_program[split].alt = m_program.size();
+        break;
+      }
+
+      case kind::any_chars:
+        compile_repeat(t.char_class);
+        break;
+
+      case kind::instance: {
+        // Optional "." followed by at least one character
+        const uint16_t split = emit({opcode::split});
+        emit({opcode::character, '.'});
+        emit({opcode::char_class, 0, t.char_class});
+        compile_repeat(t.char_class);
+        m_program[split].next = split + 1;
+        m_program[split].alt = m_program.size();
+        break;
+      }
+
+      case kind::alternatives: {
+        // Each alternative but the last one is tried through a split,
+        // and jumps after the last one when it is done
+        ossia::small_vector<uint16_t, 8> jumps;
+        for(std::size_t k = 0; k + 1 < t.alternatives.size(); k++)
+        {
+          const uint16_t split = emit({opcode::split});
+          m_program[split].next = split + 1;
+          compile(t.alternatives[k]);
+          jumps.push_back(emit({opcode::jump}));
+          m_program[split].alt = m_program.size();
+        }
+        compile(t.alternatives.back());
+        for(uint16_t j : jumps)
+          m_program[j].next = m_program.size();
+        break;
+      }
+    }
+  }
+}
+
+bool segment_pattern::match(std::string_view name) const noexcept
+{
+  // The states reached after each character. A state is only added once
+  // per character, so each step costs at most the size of the program.
+  ossia::small_vector<uint16_t, 32> states[2], stack;
+  ossia::small_vector<std::size_t, 32> added(m_program.size(), std::size_t(-1));
+
+  auto add = [&](auto& states, uint16_t pc, std::size_t step) {
+    stack.push_back(pc);
+    while(!stack.empty())
+    {
+      pc = stack.back();
+      stack.pop_back();
+      if(added[pc] == step)
+        continue;
+      added[pc] = step;
+
+      const instruction& i = m_program[pc];
+      switch(i.op)
+      {
+        case opcode::split:
+          stack.push_back(i.alt);
+          stack.push_back(i.next);
+          break;
+        case opcode::jump:
+          stack.push_back(i.next);
+          break;
+        default:
+          states.push_back(pc);
+          break;
+      }
+    }
+  };
+
+  add(states[0], 0, 0);
+  for(std::size_t k = 0; k < name.size(); k++)
+  {
+    const auto c = static_cast<unsigned char>(name[k]);
+    auto& current = states[k % 2];
+    auto& next = states[(k + 1) % 2];
+    next.clear();
+    for(uint16_t pc : current)
+    {
+      const instruction& i = m_program[pc];
+      if((i.op == opcode::character && i.ch == c)
+         || (i.op == opcode::char_class && m_classes[i.char_class].test(c)))
+        add(next, pc + 1, k + 1);
+    }
+    if(next.empty())
+      return false;
+  }
+
+  return ossia::any_of(
+      states[name.size() % 2], [&](uint16_t pc) { return m_program[pc].op == opcode::accept; });
+}
+}
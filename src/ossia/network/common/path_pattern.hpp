@@ -0,0 +1,94 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ossia::traversal
+{
+/**
+ * @brief Compiled matcher for a single segment of an address pattern.
+ *
+ * The syntax is the one described in path.hpp :
+ * - "?" matches zero or one character of ossia::net::name_characters().
+ * - "*" matches any sequence of characters of ossia::net::name_characters().
+ * - "[abc]", "[a-z]" match one character of the class; "[!a-z]" or "[^a-z]"
+ *   one character which is not part of the class.
+ * - "{foo,b*r}" matches one of the alternatives, which can be patterns.
+ * - "!" matches an optional instance suffix, e.g. ".1" or ".foo".
+ * - "\" escapes the next character.
+ * Every other character, including ".", is matched literally.
+ *
+ * Numeric ranges such as "{1..5}" must have been expanded beforehand
+ * with ossia::net::expand_ranges.
+ *
+ * The pattern is compiled once into a small non-deterministic automaton.
+ * Matching runs all its states over the name in a single pass, without
+ * backtracking: it takes at most O(name length × pattern length) steps
+ * whatever the pattern, since patterns can come from the network.
+ */
+class OSSIA_EXPORT segment_pattern
+{
+public:
+  //! Throws std::runtime_error if a character class or an alternative is not
+  //! closed, or if the pattern is too long
+  explicit segment_pattern(std::string_view pattern);
+
+  [[nodiscard]] bool match(std::string_view name) const noexcept;
+
+private:
+  enum class kind : uint8_t
+  {
+    literal,
+    one_char,
+    optional_char,
+    any_chars,
+    instance,
+    alternatives
+  };
+
+  struct token;
+  using sequence = std::vector<token>;
+  struct token
+  {
+    kind type{};
+    //! For one_char, optional_char and any_chars
+    uint16_t char_class{};
+    std::string text;
+    std::vector<sequence> alternatives;
+  };
+
+  enum class opcode : uint8_t
+  {
+    character,
+    char_class,
+    //! Continue at both next and alt
+    split,
+    jump,
+    accept
+  };
+
+  struct instruction
+  {
+    opcode op{};
+    unsigned char ch{};
+    uint16_t char_class{};
+    uint16_t next{};
+    uint16_t alt{};
+  };
+
+  sequence parse(std::string_view p, std::size_t& i, bool in_alternative);
+  uint16_t parse_class(std::string_view p, std::size_t& i);
+  uint16_t add_class(const std::bitset<256>& c);
+
+  uint16_t emit(instruction i);
+  void compile(const sequence& seq);
+  void compile_repeat(uint16_t char_class);
+
+  std::vector<instruction> m_program;
+  std::vector<std::bitset<256>> m_classes;
+};
+}
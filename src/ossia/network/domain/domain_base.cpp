@@ -229,10 +229,25 @@ ossia::domain make_domain_from_minmax(
   return ossia::make_domain(ossia::value(min), ossia::value(max));
 }
 
+namespace
+{
+// Float and int parameters with a domain of their own type are the common
+// case: bound them without going through the (value x domain) dispatch.
+template <typename T>
+OSSIA_INLINE const domain_base<T>* numeric_domain(const domain& dom, const value& val)
+{
+  return val.v.target<T>() ? dom.v.target<domain_base<T>>() : nullptr;
+}
+}
+
 value apply_domain(const domain& dom, bounding_mode b, const ossia::value& val)
 {
   if(bool(dom) && bool(val.v))
   {
+    if(auto d = numeric_domain<float>(dom, val))
+      return apply_domain_visitor{b}(*val.v.target<float>(), *d);
+    if(auto d = numeric_domain<int32_t>(dom, val))
+      return apply_domain_visitor{b}(*val.v.target<int32_t>(), *d);
     return ossia::apply(apply_domain_visitor{b}, val.v, dom.v);
   }
   return val;
@@ -242,6 +257,10 @@ value apply_domain(const domain& dom, bounding_mode b, ossia::value&& val)
 {
   if(bool(dom) && bool(val.v) && b != ossia::bounding_mode::FREE)
   {
+    if(auto d = numeric_domain<float>(dom, val))
+      return apply_domain_visitor{b}(*val.v.target<float>(), *d);
+    if(auto d = numeric_domain<int32_t>(dom, val))
+      return apply_domain_visitor{b}(*val.v.target<int32_t>(), *d);
     return ossia::apply(apply_domain_visitor{b}, ossia::move(val.v), dom.v);
   }
   return std::move(val);
@@ -10,6 +10,8 @@
 #include <ossia/network/value/value.hpp>
 #include <ossia/network/value/value_conversion.hpp>
 
+#include <algorithm>
+
 namespace ossia::net
 {
 struct dummy_lock
@@ -33,6 +35,8 @@ generic_parameter::generic_parameter(ossia::net::node_base& node)
     , m_boundingMode(ossia::bounding_mode::FREE)
     , m_value(ossia::impulse{})
 {
+  value_lock_t lock(m_valueMutex);
+  publish_value();
 }
 
 generic_parameter::generic_parameter(
@@ -44,6 +48,10 @@ generic_parameter::generic_parameter(
     , m_boundingMode(get_value_or(data.bounding, ossia::bounding_mode::FREE))
     , m_value(init_value(m_valueType))
 {
+  {
+    value_lock_t lock(m_valueMutex);
+    publish_value();
+  }
   m_repetitionFilter = get_value_or(data.rep_filter, ossia::repetition_filter::OFF);
   update_parameter_type(data.type, *this);
 }
@@ -98,11 +106,74 @@ const ossia::value& generic_parameter::getValue() const
 
 ossia::value generic_parameter::value() const
 {
-  value_lock_t lock(m_valueMutex);
+  // Numbers, vectors, booleans...: read without locking
+  const auto scalar = m_scalarValue.load();
+  switch(scalar.type)
+  {
+    case ossia::val_type::FLOAT:
+      return scalar.f[0];
+    case ossia::val_type::INT:
+      return scalar.i;
+    case ossia::val_type::VEC2F:
+      return ossia::make_vec(scalar.f[0], scalar.f[1]);
+    case ossia::val_type::VEC3F:
+      return ossia::make_vec(scalar.f[0], scalar.f[1], scalar.f[2]);
+    case ossia::val_type::VEC4F:
+      return ossia::make_vec(scalar.f[0], scalar.f[1], scalar.f[2], scalar.f[3]);
+    case ossia::val_type::IMPULSE:
+      return ossia::impulse{};
+    case ossia::val_type::BOOL:
+      return scalar.b;
+    case ossia::val_type::CHAR:
+      return scalar.c;
+    default:
+      break;
+  }
 
+  // Strings and lists
+  value_lock_t lock(m_valueMutex);
   return m_value;
 }
 
+void generic_parameter::publish_value()
+{
+  struct writer
+  {
+    scalar_value& s;
+    void operator()(float v) const noexcept { s.f[0] = v; }
+    void operator()(int32_t v) const noexcept { s.i = v; }
+    void operator()(const ossia::vec2f& v) const noexcept
+    {
+      std::copy_n(v.begin(), 2, s.f);
+    }
+    void operator()(const ossia::vec3f& v) const noexcept
+    {
+      std::copy_n(v.begin(), 3, s.f);
+    }
+    void operator()(const ossia::vec4f& v) const noexcept
+    {
+      std::copy_n(v.begin(), 4, s.f);
+    }
+    void operator()(ossia::impulse) const noexcept { }
+    void operator()(bool v) const noexcept { s.b = v; }
+    void operator()(char v) const noexcept { s.c = v; }
+    void operator()(const std::string&) const noexcept
+    {
+      s.type = ossia::val_type::NONE;
+    }
+    void operator()(const std::vector<ossia::value>&) const noexcept
+    {
+      s.type = ossia::val_type::NONE;
+    }
+    void operator()() const noexcept { s.type = ossia::val_type::NONE; }
+  };
+
+  scalar_value scalar{};
+  scalar.type = m_value.get_type();
+  m_value.apply(writer{scalar});
+  m_scalarValue.store(scalar);
+}
+
 ossia::value generic_parameter::set_value(const ossia::value& val)
 {
   ossia::value copy;
@@ -124,6 +195,7 @@ ossia::value generic_parameter::set_value(const ossia::value& val)
       m_value = ossia::convert(val, m_previousValue);
       copy = m_value;
     }
+    publish_value();
   }
   send(copy);
 
@@ -149,6 +221,7 @@ ossia::value generic_parameter::set_value(ossia::value&& val)
       m_value = ossia::convert(std::move(val), m_previousValue);
       copy = m_value;
     }
+    publish_value();
   }
 
   send(copy);
@@ -176,6 +249,7 @@ ossia::value generic_parameter::set_value_quiet(const ossia::value& val)
       m_value = ossia::convert(val, m_previousValue);
       copy = m_value;
     }
+    publish_value();
   }
 
   return copy;
@@ -200,6 +274,7 @@ ossia::value generic_parameter::set_value_quiet(ossia::value&& val)
       m_value = ossia::convert(std::move(val), m_previousValue);
       copy = m_value;
     }
+    publish_value();
   }
 
   return copy;
@@ -212,6 +287,7 @@ void generic_parameter::set_value_quiet(const destination& destination)
   {
     m_previousValue = std::move(m_value); // TODO also implement me for MIDI
     m_value = destination.address().fetch_value();
+    publish_value();
   }
   else
   {
@@ -237,6 +313,7 @@ ossia::net::generic_parameter& generic_parameter::set_value_type(ossia::val_type
     m_valueType = type;
 
     m_value = init_value(type);
+    publish_value();
     if(m_domain)
     {
       convert_compatible_domain(m_domain, m_valueType);
@@ -326,6 +403,7 @@ generic_parameter& generic_parameter::set_unit(const unit_t& v)
       {
         m_valueType = vt;
         m_value = ossia::convert(m_value, m_valueType);
+        publish_value();
         if(m_domain)
         {
           convert_compatible_domain(m_domain, m_valueType);
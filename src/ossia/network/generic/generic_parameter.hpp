@@ -2,6 +2,7 @@
 #include <ossia/detail/callback_container.hpp>
 #include <ossia/detail/mutex.hpp>
 #include <ossia/detail/optional.hpp>
+#include <ossia/detail/seqlock.hpp>
 #include <ossia/network/base/node_attributes.hpp>
 #include <ossia/network/base/parameter.hpp>
 #include <ossia/network/domain/domain.hpp>
@@ -32,6 +33,21 @@ protected:
   mutable mutex_t m_valueMutex;
   ossia::value m_value TS_GUARDED_BY(m_valueMutex);
 
+  //! Copy of m_value for value() to read without locking, when m_value is
+  //! neither a string nor a list. Written with m_valueMutex held.
+  struct scalar_value
+  {
+    ossia::val_type type{ossia::val_type::NONE};
+    union
+    {
+      float f[4];
+      int32_t i;
+      bool b;
+      char c;
+    };
+  };
+  ossia::seqlock<scalar_value> m_scalarValue;
+
   ossia::domain m_domain;
 
   ossia::value m_previousValue; //! Used for repetition filter.
@@ -79,6 +95,8 @@ public:
   void on_removing_last_callback() final override;
 
 private:
+  void publish_value() TS_REQUIRES(m_valueMutex);
+
   friend struct update_parameter_visitor;
 };
 }
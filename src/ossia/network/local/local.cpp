@@ -89,6 +89,20 @@ void multiplex_protocol::stop()
     proto->stop();
 }
 
+void multiplex_protocol::begin_tick()
+{
+  lock_guard guard(m_protocols_mutex);
+  for(auto& proto : m_protocols)
+    proto->begin_tick();
+}
+
+void multiplex_protocol::flush_output()
+{
+  lock_guard guard(m_protocols_mutex);
+  for(auto& proto : m_protocols)
+    proto->flush_output();
+}
+
 void multiplex_protocol::set_device(device_base& dev)
 {
   m_device = &dev;
@@ -47,6 +47,8 @@ public:
       const ossia::value& v) override;
 
   void stop() override;
+  void begin_tick() override;
+  void flush_output() override;
   void set_device(ossia::net::device_base& dev) override;
 
   //! Use this to add protocols through which you will expose the device. For
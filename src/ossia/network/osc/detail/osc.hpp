@@ -431,9 +431,76 @@ inline ossia::value get_filtered_value(
       addr.get_bounding());
 }
 
+/**
+ * @brief Fast path for the messages whose type tags are exactly the ones
+ * the parameter would send: ",f" for float, ",i" for int, ",ff" for vec2f...
+ *
+ * These are the tags written by the static policies of both OSC 1.0 and 1.1.
+ * The arguments are read directly, without copying the current value of the
+ * parameter and visiting it as to_value does.
+ * Returns an invalid value for any other message.
+ */
+inline ossia::value
+get_typed_value(ossia::val_type type, const oscpack::ReceivedMessage& mess)
+{
+  const char* tags = mess.TypeTags();
+  if(!tags)
+    return {};
+
+  auto read_floats = [&](auto& arr) -> bool {
+    constexpr std::size_t N = std::tuple_size_v<std::decay_t<decltype(arr)>>;
+    if(mess.ArgumentCount() != N)
+      return false;
+    for(std::size_t i = 0; i < N; i++)
+      if(tags[i] != oscpack::FLOAT_TYPE_TAG)
+        return false;
+
+    auto it = mess.ArgumentsBegin();
+    for(std::size_t i = 0; i < N; i++, ++it)
+      arr[i] = it->AsFloatUnchecked();
+    return true;
+  };
+
+  switch(type)
+  {
+    case ossia::val_type::FLOAT:
+      if(mess.ArgumentCount() == 1 && tags[0] == oscpack::FLOAT_TYPE_TAG)
+        return mess.ArgumentsBegin()->AsFloatUnchecked();
+      break;
+    case ossia::val_type::INT:
+      if(mess.ArgumentCount() == 1 && tags[0] == oscpack::INT32_TYPE_TAG)
+        return mess.ArgumentsBegin()->AsInt32Unchecked();
+      break;
+    case ossia::val_type::VEC2F: {
+      ossia::vec2f v;
+      if(read_floats(v))
+        return v;
+      break;
+    }
+    case ossia::val_type::VEC3F: {
+      ossia::vec3f v;
+      if(read_floats(v))
+        return v;
+      break;
+    }
+    case ossia::val_type::VEC4F: {
+      ossia::vec4f v;
+      if(read_floats(v))
+        return v;
+      break;
+    }
+    default:
+      break;
+  }
+  return {};
+}
+
 inline ossia::value get_filtered_value(
     ossia::net::parameter_base& addr, const oscpack::ReceivedMessage& mess)
 {
+  if(auto v = get_typed_value(addr.get_value_type(), mess); v.valid())
+    return bound_value(addr.get_domain(), std::move(v), addr.get_bounding());
+
   return get_filtered_value(
       addr, mess.ArgumentsBegin(), mess.ArgumentsEnd(), mess.ArgumentCount());
 }
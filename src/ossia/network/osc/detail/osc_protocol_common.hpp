@@ -6,6 +6,7 @@
 #include <ossia/network/osc/detail/osc_packet_processor.hpp>
 #include <ossia/network/osc/detail/osc_receive.hpp>
 #include <ossia/network/osc/detail/osc_value_write_visitor.hpp>
+#include <ossia/network/osc/detail/output_coalescer.hpp>
 #include <ossia/network/value/format_value.hpp>
 
 namespace ossia::net
@@ -20,11 +21,23 @@ struct osc_protocol_common
     auto val = bound_value(addr, std::forward<Value_T>(v));
     if(val.valid())
     {
-      using send_visitor = osc_value_send_visitor<
-          ossia::net::parameter_base, OscVersion, typename T::writer_type>;
+      // During a tick, only the last value is sent, by flush_output
+      const bool buffered
+          = self.output_coalescing()
+            && self.buffer_message(&addr, [&](osc_output_coalescer::message_writer w) {
+                 using send_visitor = osc_value_send_visitor<
+                     ossia::net::parameter_base, OscVersion,
+                     osc_output_coalescer::message_writer>;
+                 val.apply(send_visitor{addr, addr.get_node().osc_address(), w});
+               });
+      if(!buffered)
+      {
+        using send_visitor = osc_value_send_visitor<
+            ossia::net::parameter_base, OscVersion, typename T::writer_type>;
 
-      send_visitor vis{addr, addr.get_node().osc_address(), self.writer()};
-      val.apply(vis);
+        send_visitor vis{addr, addr.get_node().osc_address(), self.writer()};
+        val.apply(vis);
+      }
 
       if(const auto& logger = self.m_logger.outbound_logger)
       {
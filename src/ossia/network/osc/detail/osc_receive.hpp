@@ -6,6 +6,7 @@
 #include <ossia/network/base/message_origin_identifier.hpp>
 #include <ossia/network/base/parameter.hpp>
 #include <ossia/network/common/network_logger.hpp>
+#include <ossia/network/common/path.hpp>
 #include <ossia/network/osc/detail/osc.hpp>
 
 #include <oscpack/osc/OscPrintReceivedElements.h>
@@ -109,36 +110,42 @@ void on_input_message(
   {
     f.on_listened_value(**addr, dev, logger);
   }
-  else
+  else if(ossia::traversal::is_pattern(addr_txt))
   {
-    // We still want to save the value even if it is not listened to.
-    if(auto n = find_node(dev.get_root_node(), addr_txt))
+    // Pattern matching: the compiled patterns are kept across messages
+    std::vector<ossia::net::node_base*> nodes{&dev.get_root_node()};
+    if(auto path = ossia::traversal::path_cache::instance().get(addr_txt))
+      ossia::traversal::apply(*path, nodes);
+    else
+      nodes.clear();
+
+    for(auto n : nodes)
     {
-      if(auto base_addr = n->get_parameter())
+      if(auto addr = n->get_parameter())
       {
-        if constexpr(!SilentUpdate)
-          f.on_value(*base_addr, dev);
+        if(!SilentUpdate || listening.find(n->osc_address()))
+          f.on_value(*addr, dev);
         else
-          f.on_value_quiet(*base_addr, dev);
+          f.on_value_quiet(*addr, dev);
       }
     }
+
+    if(nodes.empty())
+      f.on_unhandled(dev);
+  }
+  else
+  {
+    // We still want to save the value even if it is not listened to.
+    if(auto base_addr = dev.find_parameter(addr_txt))
+    {
+      if constexpr(!SilentUpdate)
+        f.on_value(*base_addr, dev);
+      else
+        f.on_value_quiet(*base_addr, dev);
+    }
     else
     {
-      // Try to handle pattern matching
-      auto nodes = find_nodes(dev.get_root_node(), addr_txt);
-      for(auto n : nodes)
-      {
-        if(auto addr = n->get_parameter())
-        {
-          if(!SilentUpdate || listening.find(n->osc_address()))
-            f.on_value(*addr, dev);
-          else
-            f.on_value_quiet(*addr, dev);
-        }
-      }
-
-      if(nodes.empty())
-        f.on_unhandled(dev);
+      f.on_unhandled(dev);
     }
   }
 
@@ -0,0 +1,168 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/detail/logger.hpp>
+#include <ossia/detail/mutex.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ossia::net
+{
+/**
+ * @brief Output buffering of the OSC protocols.
+ *
+ * When enabled, the messages pushed during an execution tick, that is
+ * between protocol_base::begin_tick and protocol_base::flush_output,
+ * are kept with only the last message of each parameter. They are then
+ * packed into bundles of at most max_datagram_size bytes; a bundle which
+ * would contain a single message is sent as that message.
+ * Outside of a tick, messages are sent immediately.
+ *
+ * Only the generic OSC protocols use it: OSCQuery and Minuit send their
+ * messages as they are pushed.
+ */
+class osc_output_coalescer
+{
+public:
+  //! Ethernet MTU minus the IPv4 and UDP headers
+  static constexpr std::size_t default_datagram_size = 1472;
+
+  //! Stores the encoded message of a parameter
+  struct message_writer
+  {
+    std::string& message;
+    void operator()(const char* data, std::size_t sz) const { message.assign(data, sz); }
+  };
+
+  [[nodiscard]] bool output_coalescing() const noexcept
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  void set_output_coalescing(
+      bool enabled, std::size_t max_datagram_size = default_datagram_size)
+  {
+    lock_t lock{m_mutex};
+    m_maxSize = std::max(max_datagram_size, bundle_header_size + 8);
+    m_enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  //! Messages are buffered from here to the next flush_output_buffer
+  void begin_output_tick()
+  {
+    lock_t lock{m_mutex};
+    m_inTick = true;
+  }
+
+  /**
+   * @brief Replaces the pending message of `key`.
+   * `encode` is called with a message_writer.
+   * Returns false, without calling `encode`, when no tick is in progress:
+   * the message has to be sent by the caller.
+   */
+  template <typename Encode>
+  bool buffer_message(const void* key, Encode&& encode)
+  {
+    lock_t lock{m_mutex};
+    if(!m_inTick)
+      return false;
+
+    auto [it, inserted] = m_index.try_emplace(key, m_count);
+    if(inserted)
+    {
+      if(m_count == m_messages.size())
+        m_messages.emplace_back();
+      m_count++;
+    }
+    encode(message_writer{m_messages[it->second]});
+    return true;
+  }
+
+  /**
+   * @brief Packs the pending messages and passes them
+   * to `send(const std::vector<std::string>& datagrams)`.
+   */
+  template <typename Send>
+  void flush_output_buffer(Send&& send)
+  {
+    lock_t lock{m_mutex};
+    m_inTick = false;
+    if(m_count == 0)
+      return;
+
+    pack();
+    try
+    {
+      send(m_datagrams);
+    }
+    catch(const std::exception& e)
+    {
+      ossia::logger().error("osc_output_coalescer: {}", e.what());
+    }
+    catch(...)
+    {
+      ossia::logger().error("osc_output_coalescer: unknown error");
+    }
+
+    m_index.clear();
+    m_count = 0;
+  }
+
+private:
+  // "#bundle\0" followed by the "immediately" time tag
+  static constexpr std::size_t bundle_header_size = 16;
+
+  void pack()
+  {
+    m_datagrams.clear();
+
+    std::size_t first = 0;
+    while(first < m_count)
+    {
+      // Find how many messages fit in this datagram
+      std::size_t size = bundle_header_size + 4 + m_messages[first].size();
+      std::size_t last = first + 1;
+      while(last < m_count && size + 4 + m_messages[last].size() <= m_maxSize)
+      {
+        size += 4 + m_messages[last].size();
+        last++;
+      }
+
+      if(last == first + 1)
+      {
+        m_datagrams.push_back(std::move(m_messages[first]));
+      }
+      else
+      {
+        std::string& dgram = m_datagrams.emplace_back();
+        dgram.reserve(size);
+        dgram.append("#bundle\0\0\0\0\0\0\0\0\1", bundle_header_size);
+        for(std::size_t i = first; i < last; i++)
+        {
+          const int32_t sz = boost::endian::native_to_big(int32_t(m_messages[i].size()));
+          char sz_bytes[4];
+          std::memcpy(sz_bytes, &sz, 4);
+          dgram.append(sz_bytes, 4);
+          dgram.append(m_messages[i]);
+          m_messages[i].clear();
+        }
+      }
+      first = last;
+    }
+  }
+
+  mutable mutex_t m_mutex;
+  ossia::fast_hash_map<const void*, std::size_t> m_index TS_GUARDED_BY(m_mutex);
+  std::vector<std::string> m_messages TS_GUARDED_BY(m_mutex);
+  std::vector<std::string> m_datagrams TS_GUARDED_BY(m_mutex);
+  std::size_t m_count TS_GUARDED_BY(m_mutex){};
+  std::size_t m_maxSize TS_GUARDED_BY(m_mutex){default_datagram_size};
+  bool m_inTick TS_GUARDED_BY(m_mutex){};
+  std::atomic_bool m_enabled{};
+};
+}
@@ -36,6 +36,9 @@ struct send_socket_configuration : socket_configuration
 };
 struct receive_socket_configuration : socket_configuration
 {
+  // Linux only: number of datagrams read at once with recvmmsg.
+  // 0 reads them one at a time.
+  uint16_t batch_size{};
 };
 
 struct double_fd_configuration
@@ -10,8 +10,29 @@
 
 #include <nano_signal_slot.hpp>
 
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
 namespace ossia::net
 {
+struct udp_receive_statistics
+{
+  //! Datagrams passed to the receive callback
+  uint64_t received{};
+
+  //! Datagrams lost because the receive buffer of the socket was full,
+  //! or because they were truncated. Only counted with batched receive.
+  uint64_t dropped{};
+
+  //! Number of times a whole batch was filled by a single read:
+  //! datagrams arrive faster than they are processed.
+  uint64_t overruns{};
+};
 
 class udp_receive_socket
 {
@@ -25,7 +46,23 @@ public:
   {
   }
 
-  ~udp_receive_socket() = default;
+  udp_receive_socket(
+      const receive_socket_configuration& conf, boost::asio::io_context& ctx)
+      : udp_receive_socket{static_cast<const socket_configuration&>(conf), ctx}
+  {
+    m_batchSize = conf.batch_size;
+  }
+
+  //! Must be called before receive(). Ignored outside of Linux.
+  void set_batch_size(std::size_t n) noexcept { m_batchSize = n; }
+
+  udp_receive_statistics statistics() const noexcept
+  {
+    return {
+        m_received.load(std::memory_order_relaxed),
+        m_dropped.load(std::memory_order_relaxed),
+        m_overruns.load(std::memory_order_relaxed)};
+  }
 
   void open()
   {
@@ -47,6 +84,15 @@ public:
   template <typename F>
   void receive(F f)
   {
+#if defined(__linux__)
+    if(m_batchSize > 1)
+    {
+      init_batch();
+      receive_batch(std::move(f));
+      return;
+    }
+#endif
+
     m_socket.async_receive_from(
         boost::asio::mutable_buffer(&m_data[0], std::size(m_data)), m_endpoint,
         [this, f](auto ec, std::size_t sz) {
@@ -55,6 +101,7 @@ public:
 
       if(!ec && sz > 0)
       {
+        m_received.fetch_add(1, std::memory_order_relaxed);
         try
         {
           f(m_data, sz);
@@ -79,6 +126,131 @@ public:
   proto::endpoint m_endpoint;
   proto::socket m_socket;
   alignas(16) char m_data[65535];
+
+private:
+#if defined(__linux__)
+  static constexpr std::size_t max_datagram_size = 65535;
+  static constexpr std::size_t control_size = CMSG_SPACE(sizeof(uint32_t));
+
+  void init_batch()
+  {
+    // Ask the kernel for the count of datagrams it dropped on this socket
+    const int one = 1;
+    ::setsockopt(m_socket.native_handle(), SOL_SOCKET, SO_RXQ_OVFL, &one, sizeof(one));
+
+    // The ring is only allocated again if the batch size changed since the
+    // previous call to receive()
+    const std::size_t ring_size = m_batchSize * max_datagram_size;
+    if(m_ring.size() == ring_size)
+      return;
+
+    m_ring.resize(ring_size);
+    m_control.resize(m_batchSize * control_size);
+    m_iovecs.resize(m_batchSize);
+    m_msgs.resize(m_batchSize);
+    for(std::size_t i = 0; i < m_batchSize; i++)
+    {
+      m_iovecs[i].iov_base = m_ring.data() + i * max_datagram_size;
+      m_iovecs[i].iov_len = max_datagram_size;
+    }
+  }
+
+  // Waits for the socket to be readable and reads as many datagrams
+  // as possible, up to the batch size, with a single system call.
+  template <typename F>
+  void receive_batch(F f)
+  {
+    m_socket.async_wait(proto::socket::wait_read, [this, f](auto ec) {
+      if(ec == boost::asio::error::operation_aborted)
+        return;
+
+      if(!ec)
+        read_batch(f);
+
+      this->receive_batch(f);
+    });
+  }
+
+  template <typename F>
+  void read_batch(const F& f)
+  {
+    // recvmmsg overwrites the lengths of the headers
+    for(std::size_t i = 0; i < m_batchSize; i++)
+    {
+      auto& hdr = m_msgs[i].msg_hdr;
+      hdr = {};
+      hdr.msg_iov = &m_iovecs[i];
+      hdr.msg_iovlen = 1;
+      hdr.msg_control = m_control.data() + i * control_size;
+      hdr.msg_controllen = control_size;
+    }
+
+    const int n = ::recvmmsg(
+        m_socket.native_handle(), m_msgs.data(), m_batchSize, MSG_DONTWAIT, nullptr);
+    if(n <= 0)
+      return;
+
+    if(std::size_t(n) == m_batchSize)
+      m_overruns.fetch_add(1, std::memory_order_relaxed);
+
+    std::size_t received = 0;
+    for(int i = 0; i < n; i++)
+    {
+      auto& hdr = m_msgs[i].msg_hdr;
+      read_drop_count(hdr);
+
+      if(hdr.msg_flags & MSG_TRUNC)
+      {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+
+      received++;
+      try
+      {
+        f((const char*)m_iovecs[i].iov_base, std::size_t(m_msgs[i].msg_len));
+      }
+      catch(const std::exception& e)
+      {
+        ossia::logger().error("[udp_socket::receive]: {}", e.what());
+      }
+      catch(...)
+      {
+        ossia::logger().error("[udp_socket::receive]: unknown error");
+      }
+    }
+    m_received.fetch_add(received, std::memory_order_relaxed);
+  }
+
+  void read_drop_count(msghdr& hdr)
+  {
+    for(auto cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg))
+    {
+      if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+      {
+        // Total count of drops since the socket was opened
+        uint32_t total{};
+        std::memcpy(&total, CMSG_DATA(cmsg), sizeof(total));
+        if(total > m_kernelDrops)
+        {
+          m_dropped.fetch_add(total - m_kernelDrops, std::memory_order_relaxed);
+          m_kernelDrops = total;
+        }
+      }
+    }
+  }
+
+  std::vector<::mmsghdr> m_msgs;
+  std::vector<::iovec> m_iovecs;
+  std::vector<char> m_ring;
+  std::vector<char> m_control;
+  uint32_t m_kernelDrops{};
+#endif
+
+  std::size_t m_batchSize{};
+  std::atomic<uint64_t> m_received{};
+  std::atomic<uint64_t> m_dropped{};
+  std::atomic<uint64_t> m_overruns{};
 };
 
 class udp_send_socket
@@ -120,6 +292,53 @@ public:
     m_socket.send_to(boost::asio::buffer(data, sz), m_endpoint);
   }
 
+  /**
+   * @brief Sends a sequence of datagrams to the endpoint.
+   * On Linux a single sendmmsg call sends up to 64 datagrams.
+   */
+  template <typename Datagrams>
+  void write_datagrams(const Datagrams& datagrams)
+  {
+#if defined(__linux__)
+    static constexpr std::size_t batch = 64;
+    const std::size_t count = std::size(datagrams);
+    ::mmsghdr msgs[batch];
+    ::iovec iovs[batch];
+
+    std::size_t first = 0;
+    while(first < count)
+    {
+      const std::size_t n = std::min(batch, count - first);
+      for(std::size_t i = 0; i < n; i++)
+      {
+        const auto& dgram = datagrams[first + i];
+        iovs[i].iov_base = const_cast<char*>(std::data(dgram));
+        iovs[i].iov_len = std::size(dgram);
+
+        msgs[i] = {};
+        msgs[i].msg_hdr.msg_name = m_endpoint.data();
+        msgs[i].msg_hdr.msg_namelen = m_endpoint.size();
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      int sent = ::sendmmsg(m_socket.native_handle(), msgs, n, 0);
+      if(sent <= 0)
+      {
+        // e.g. EAGAIN: send the remaining datagrams of the batch one by one
+        sent = 0;
+      }
+      for(std::size_t i = sent; i < n; i++)
+        write((const char*)iovs[i].iov_base, iovs[i].iov_len);
+
+      first += n;
+    }
+#else
+    for(const auto& dgram : datagrams)
+      write(std::data(dgram), std::size(dgram));
+#endif
+  }
+
   Nano::Signal<void()> on_close;
 
   boost::asio::io_context& m_context;
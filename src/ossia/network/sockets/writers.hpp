@@ -5,6 +5,7 @@
 #include <boost/asio/error.hpp>
 
 #include <cinttypes>
+#include <type_traits>
 #include <vector>
 
 namespace ossia::net
@@ -16,6 +17,24 @@ struct socket_writer
   void operator()(const char* data, std::size_t sz) const { socket.write(data, sz); }
 };
 
+/**
+ * @brief Sends each element of `datagrams` as a separate packet.
+ * Sockets which can send several datagrams at once provide write_datagrams.
+ */
+template <typename Socket, typename Datagrams>
+void write_datagrams(Socket& socket, const Datagrams& datagrams)
+{
+  if constexpr(requires { socket.write_datagrams(datagrams); })
+  {
+    socket.write_datagrams(datagrams);
+  }
+  else
+  {
+    for(const auto& dgram : datagrams)
+      socket.write(std::data(dgram), std::size(dgram));
+  }
+}
+
 template <typename Socket>
 struct multi_socket_writer
 {
@@ -283,6 +283,11 @@ inline char& value_variant_type::get()
 template <typename Visitor>
 auto apply_nonnull(Visitor&& functor, const value_variant_type& var)
 {
+  // Float and int first: most values are one or the other
+  if(var.m_type == value_variant_type::Type::Type0)
+    return functor(var.m_impl.m_value0);
+  if(var.m_type == value_variant_type::Type::Type1)
+    return functor(var.m_impl.m_value1);
   switch(var.m_type)
   {
     case value_variant_type::Type::Type0:
@@ -312,6 +317,11 @@ auto apply_nonnull(Visitor&& functor, const value_variant_type& var)
 template <typename Visitor>
 auto apply_nonnull(Visitor&& functor, value_variant_type& var)
 {
+  // Float and int first: most values are one or the other
+  if(var.m_type == value_variant_type::Type::Type0)
+    return functor(var.m_impl.m_value0);
+  if(var.m_type == value_variant_type::Type::Type1)
+    return functor(var.m_impl.m_value1);
   switch(var.m_type)
   {
     case value_variant_type::Type::Type0:
@@ -341,6 +351,11 @@ auto apply_nonnull(Visitor&& functor, value_variant_type& var)
 template <typename Visitor>
 auto apply_nonnull(Visitor&& functor, value_variant_type&& var)
 {
+  // Float and int first: most values are one or the other
+  if(var.m_type == value_variant_type::Type::Type0)
+    return functor(std::move(var.m_impl.m_value0));
+  if(var.m_type == value_variant_type::Type::Type1)
+    return functor(std::move(var.m_impl.m_value1));
   switch(var.m_type)
   {
     case value_variant_type::Type::Type0:
@@ -370,6 +385,11 @@ auto apply_nonnull(Visitor&& functor, value_variant_type&& var)
 template <typename Visitor>
 auto apply(Visitor&& functor, const value_variant_type& var)
 {
+  // Float and int first: most values are one or the other
+  if(var.m_type == value_variant_type::Type::Type0)
+    return functor(var.m_impl.m_value0);
+  if(var.m_type == value_variant_type::Type::Type1)
+    return functor(var.m_impl.m_value1);
   switch(var.m_type)
   {
     case value_variant_type::Type::Type0:
@@ -399,6 +419,11 @@ auto apply(Visitor&& functor, const value_variant_type& var)
 template <typename Visitor>
 auto apply(Visitor&& functor, value_variant_type& var)
 {
+  // Float and int first: most values are one or the other
+  if(var.m_type == value_variant_type::Type::Type0)
+    return functor(var.m_impl.m_value0);
+  if(var.m_type == value_variant_type::Type::Type1)
+    return functor(var.m_impl.m_value1);
   switch(var.m_type)
   {
     case value_variant_type::Type::Type0:
@@ -428,6 +453,11 @@ auto apply(Visitor&& functor, value_variant_type& var)
 template <typename Visitor>
 auto apply(Visitor&& functor, value_variant_type&& var)
 {
+  // Float and int first: most values are one or the other
+  if(var.m_type == value_variant_type::Type::Type0)
+    return functor(std::move(var.m_impl.m_value0));
+  if(var.m_type == value_variant_type::Type::Type1)
+    return functor(std::move(var.m_impl.m_value1));
   switch(var.m_type)
   {
     case value_variant_type::Type::Type0:
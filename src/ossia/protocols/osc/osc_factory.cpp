@@ -238,20 +238,31 @@ make_osc_protocol(network_context_ptr ctx, osc_protocol_configuration config)
 {
   using conf = osc_protocol_configuration;
 
+  const bool bundle_output = config.bundle_output;
+  const std::size_t max_datagram_size = config.max_datagram_size;
+
+  std::unique_ptr<osc_protocol_base> proto;
   switch(config.version)
   {
     case conf::OSC1_0:
-      return make_osc_protocol_impl<osc_1_0_policy>(std::move(ctx), std::move(config));
+      proto = make_osc_protocol_impl<osc_1_0_policy>(std::move(ctx), std::move(config));
+      break;
     case conf::OSC1_1:
-      return make_osc_protocol_impl<osc_1_1_policy>(std::move(ctx), std::move(config));
+      proto = make_osc_protocol_impl<osc_1_1_policy>(std::move(ctx), std::move(config));
+      break;
     case conf::EXTENDED:
-      return make_osc_protocol_impl<osc_extended_policy>(
+      proto = make_osc_protocol_impl<osc_extended_policy>(
           std::move(ctx), std::move(config));
+      break;
     default:
       break;
   }
 
-  return {};
+  if(bundle_output)
+    if(auto coalescer = dynamic_cast<osc_output_coalescer*>(proto.get()))
+      coalescer->set_output_coalescing(true, max_datagram_size);
+
+  return proto;
 }
 
 }
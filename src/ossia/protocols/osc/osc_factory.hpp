@@ -31,6 +31,13 @@ struct osc_protocol_configuration
     SLIP
   } framing{SLIP};
 
+  // Buffer the values pushed during an execution tick and send them as
+  // bundles when the tick ends, keeping only the last value of each parameter
+  bool bundle_output{false};
+
+  // Maximum size of the datagrams sent when bundle_output is set
+  std::size_t max_datagram_size{1472};
+
   ossia::variant<
       udp_configuration, tcp_configuration, unix_dgram_configuration,
       unix_stream_configuration, serial_configuration, ws_client_configuration,
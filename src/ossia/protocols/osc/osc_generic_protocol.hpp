@@ -27,7 +27,9 @@
 namespace ossia::net
 {
 template <typename OscMode, typename SendSocket, typename RecvSocket>
-class osc_generic_bidir_protocol : public can_learn<ossia::net::protocol_base>
+class osc_generic_bidir_protocol
+    : public can_learn<ossia::net::protocol_base>
+    , public osc_output_coalescer
 {
 public:
   // using socket_type = Socket;
@@ -233,6 +235,18 @@ public:
     }
   }
 
+  void begin_tick() override { begin_output_tick(); }
+
+  void flush_output() override
+  {
+    if constexpr(!std::is_same_v<SendSocket, ossia::net::null_socket>)
+    {
+      flush_output_buffer([this](const auto& datagrams) {
+        write_datagrams(to_client, datagrams);
+      });
+    }
+  }
+
   void set_device(ossia::net::device_base& dev) override { m_device = &dev; }
 
   auto writer() noexcept { return writer_type{to_client}; }
@@ -249,7 +263,9 @@ public:
 };
 
 template <typename OscMode, typename Socket>
-class osc_generic_server_protocol : public can_learn<ossia::net::protocol_base>
+class osc_generic_server_protocol
+    : public can_learn<ossia::net::protocol_base>
+    , public osc_output_coalescer
 {
 public:
   using socket_type = Socket;
@@ -327,6 +343,14 @@ public:
     return OscMode::on_received_message(*this, m);
   }
 
+  void begin_tick() override { begin_output_tick(); }
+
+  void flush_output() override
+  {
+    flush_output_buffer(
+        [this](const auto& datagrams) { write_datagrams(m_server, datagrams); });
+  }
+
   void set_device(ossia::net::device_base& dev) override { m_device = &dev; }
 
   auto writer() noexcept { return writer_type{m_server}; }
@@ -342,7 +366,9 @@ public:
 };
 
 template <typename OscMode, typename Socket>
-class osc_generic_client_protocol : public can_learn<ossia::net::protocol_base>
+class osc_generic_client_protocol
+    : public can_learn<ossia::net::protocol_base>
+    , public osc_output_coalescer
 {
 public:
   using socket_type = Socket;
@@ -425,6 +451,14 @@ public:
     return OscMode::on_received_message(*this, m);
   }
 
+  void begin_tick() override { begin_output_tick(); }
+
+  void flush_output() override
+  {
+    flush_output_buffer(
+        [this](const auto& datagrams) { write_datagrams(m_client, datagrams); });
+  }
+
   void set_device(ossia::net::device_base& dev) override { m_device = &dev; }
 
   auto writer() noexcept { return writer_type{m_client}; }
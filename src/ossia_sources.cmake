@@ -47,6 +47,7 @@ set(API_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/detail/regex_fwd.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/detail/std_fwd.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/detail/safe_vec.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/detail/seqlock.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/detail/size.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/detail/ssize.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/detail/small_vector.hpp"
@@ -125,9 +126,11 @@ set(API_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/value_callback.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/name_validation.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/message_queue.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/parameter_index.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/debug.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/extended_types.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/path.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/path_pattern.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/complex_type.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/device_parameter.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/generic/generic_parameter.hpp"
@@ -206,6 +209,7 @@ set(SRCS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/domain/wrap.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/domain/fold.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/parameter.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/parameter_index.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/device.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/name_validation.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/node.cpp"
@@ -215,6 +219,7 @@ set(SRCS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/protocol.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/extended_types.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/path.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/path_pattern.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/complex_type.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/debug.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/device_parameter.cpp"
@@ -268,6 +273,7 @@ set(OSSIA_EDITOR_HEADERS
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/expression/operators.hpp"
 
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/scenario/scenario.hpp"
+  "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/scenario/detail/compiled_scenario.hpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/scenario/detail/continuity.hpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/scenario/time_interval.hpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/scenario/time_event.hpp"
@@ -305,6 +311,7 @@ set(OSSIA_EDITOR_SRCS
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/expression/expression_bool.cpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/expression/expression_pulse.cpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/loop/loop.cpp"
+  "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/scenario/detail/compiled_scenario.cpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/scenario/detail/scenario_execution.cpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/scenario/detail/scenario_sync_execution.cpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/editor/scenario/detail/scenario_sync_musical_execution.cpp"
@@ -370,6 +377,7 @@ set(OSSIA_OSC_HEADERS
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/osc/detail/osc_packet_processor.hpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/osc/detail/osc_utils.hpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/osc/detail/osc_value_write_visitor.hpp"
+  "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/osc/detail/output_coalescer.hpp"
 
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/protocols/osc/osc_generic_protocol.hpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/protocols/osc/osc_factory.hpp"
@@ -653,8 +661,13 @@ set(OSSIA_DATAFLOW_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/connection.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/data.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/value_vector.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/parameter_slots.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/value_pool.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/value_port.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/audio_port.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/audio_arena.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/audio_kernels.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/audio_kernels_impl.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/audio_stretch_mode.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/midi_port.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/data_copy.hpp"
@@ -721,12 +734,14 @@ set(OSSIA_DATAFLOW_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/safe_nodes/tick_policies.hpp"
 
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/breadth_first_search.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/dynamic_topological_order.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph_ordering.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph_static.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph_parallel.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph_parallel_impl.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph_utils.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/incremental_transitive_closure.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph_interface.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/node_executors.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/small_graph.hpp"
@@ -740,7 +755,10 @@ set(OSSIA_DATAFLOW_SRCS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/audio_protocol.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/audio_device.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/audio_engine.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/audio_arena.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/audio_kernels.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/data.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/value_pool.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/port.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph_node.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/execution_state.cpp"
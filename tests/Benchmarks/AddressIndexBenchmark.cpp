@@ -0,0 +1,96 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/base/parameter_index.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/local/local.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <random>
+
+// Compares the lookup of received OSC addresses through the node tree
+// (find_node) and through the device parameter index (find_parameter).
+// The tree is made of `range(0)` copies of the address corpus,
+// each under its own root node: 20 copies give ~100k parameters.
+static std::vector<std::string> load_corpus()
+{
+  std::vector<std::string> res;
+  std::ifstream f{OSSIA_ADDRESS_CORPUS};
+  std::string line;
+  while(std::getline(f, line))
+    if(!line.empty())
+      res.push_back(line);
+  return res;
+}
+
+struct address_fixture
+{
+  ossia::net::generic_device device{
+      std::make_unique<ossia::net::multiplex_protocol>(), "bench"};
+  std::vector<std::string> addresses;
+
+  explicit address_fixture(int copies)
+  {
+    static const auto corpus = load_corpus();
+    for(int i = 0; i < copies; i++)
+    {
+      const std::string prefix = "/copy" + std::to_string(i);
+      for(const auto& addr : corpus)
+      {
+        auto& n = ossia::net::find_or_create_node(device, prefix + addr);
+        n.create_parameter(ossia::val_type::FLOAT);
+        addresses.push_back(n.osc_address());
+      }
+    }
+
+    std::shuffle(addresses.begin(), addresses.end(), std::mt19937{1234});
+  }
+};
+
+static void BM_find_node(benchmark::State& state)
+{
+  address_fixture f(state.range(0));
+  auto& root = f.device.get_root_node();
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    auto n = ossia::net::find_node(root, f.addresses[i]);
+    benchmark::DoNotOptimize(n->get_parameter());
+    i = (i + 1) % f.addresses.size();
+  }
+}
+
+static void BM_find_parameter(benchmark::State& state)
+{
+  address_fixture f(state.range(0));
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(f.device.find_parameter(f.addresses[i]));
+    i = (i + 1) % f.addresses.size();
+  }
+}
+
+static void BM_find_missing(benchmark::State& state)
+{
+  address_fixture f(state.range(0));
+  std::vector<std::string> missing;
+  for(const auto& addr : f.addresses)
+    missing.push_back(addr + "/missing");
+
+  auto& index = *f.device.get_parameter_index();
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(index.find(missing[i]));
+    i = (i + 1) % missing.size();
+  }
+}
+
+BENCHMARK(BM_find_node)->Arg(1)->Arg(4)->Arg(20);
+BENCHMARK(BM_find_parameter)->Arg(1)->Arg(4)->Arg(20);
+BENCHMARK(BM_find_missing)->Arg(1)->Arg(20);
+BENCHMARK_MAIN();
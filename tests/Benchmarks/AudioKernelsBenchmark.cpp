@@ -0,0 +1,202 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <ossia/dataflow/audio_kernels.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+// Throughput of the audio kernels, for each instruction set supported by the
+// build and the CPU. The first argument is the instruction set
+// (0 scalar, 1 sse2, 2 avx2, 3 neon), the second the buffer size.
+// "samples/ns" counts the samples of one channel.
+static const ossia::audio_kernel_table* get_kernels(benchmark::State& state)
+{
+  auto k = ossia::audio_kernels_for(ossia::simd_isa(state.range(0)));
+  if(!k)
+    state.SkipWithError("instruction set not supported");
+  else
+    state.SetLabel(k->name);
+  return k;
+}
+
+static void set_rate(benchmark::State& state, std::size_t samples_per_iteration)
+{
+  state.counters["samples/ns"] = benchmark::Counter(
+      double(state.iterations()) * samples_per_iteration * 1e-9,
+      benchmark::Counter::kIsRate);
+}
+
+static void BM_mix(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<double> src(n, 0.1), dst(n, 0.);
+  for(auto _ : state)
+  {
+    k->mix(src.data(), dst.data(), n);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, n);
+}
+
+static void BM_mix_gain(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<double> src(n, 0.1), dst(n, 0.);
+  for(auto _ : state)
+  {
+    k->mix_gain(src.data(), dst.data(), n, 0.5);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, n);
+}
+
+static void BM_copy_gain(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<double> src(n, 0.1), dst(n, 0.);
+  for(auto _ : state)
+  {
+    k->copy_gain(src.data(), dst.data(), n, 0.5);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, n);
+}
+
+static void BM_mix_from_float(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<float> src(n, 0.1f);
+  std::vector<double> dst(n, 0.);
+  for(auto _ : state)
+  {
+    k->mix_from_float(src.data(), dst.data(), n);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, n);
+}
+
+static void BM_mix_to_float(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<double> src(n, 0.1);
+  std::vector<float> dst(n, 0.f);
+  for(auto _ : state)
+  {
+    k->mix_to_float(src.data(), dst.data(), n, 0.5);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, n);
+}
+
+static void BM_interleave_stereo(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<float> l(n, 0.1f), r(n, 0.2f), out(2 * n);
+  const float* in[2]{l.data(), r.data()};
+  for(auto _ : state)
+  {
+    k->interleave(in, out.data(), 2, n);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, 2 * n);
+}
+
+static void BM_deinterleave_stereo(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<float> in(2 * n, 0.1f), l(n), r(n);
+  float* out[2]{l.data(), r.data()};
+  for(auto _ : state)
+  {
+    k->deinterleave(in.data(), out, 2, n);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, 2 * n);
+}
+
+static void BM_float_to_s16(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<float> in(n, 0.1f);
+  std::vector<int16_t> out(n);
+  for(auto _ : state)
+  {
+    k->float_to_s16(in.data(), out.data(), n);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, n);
+}
+
+static void BM_float_to_s32(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<float> in(n, 0.1f);
+  std::vector<int32_t> out(n);
+  for(auto _ : state)
+  {
+    k->float_to_s32(in.data(), out.data(), n);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, n);
+}
+
+static void BM_s16_to_float(benchmark::State& state)
+{
+  auto k = get_kernels(state);
+  if(!k)
+    return;
+  const std::size_t n = state.range(1);
+  std::vector<int16_t> in(n, 1000);
+  std::vector<float> out(n);
+  for(auto _ : state)
+  {
+    k->s16_to_float(in.data(), out.data(), n);
+    benchmark::ClobberMemory();
+  }
+  set_rate(state, n);
+}
+
+#define OSSIA_KERNEL_BENCH(name) \
+  BENCHMARK(name)->ArgsProduct({{0, 1, 2, 3}, {64, 512, 4096}})
+
+OSSIA_KERNEL_BENCH(BM_mix);
+OSSIA_KERNEL_BENCH(BM_mix_gain);
+OSSIA_KERNEL_BENCH(BM_copy_gain);
+OSSIA_KERNEL_BENCH(BM_mix_from_float);
+OSSIA_KERNEL_BENCH(BM_mix_to_float);
+OSSIA_KERNEL_BENCH(BM_interleave_stereo);
+OSSIA_KERNEL_BENCH(BM_deinterleave_stereo);
+OSSIA_KERNEL_BENCH(BM_float_to_s16);
+OSSIA_KERNEL_BENCH(BM_float_to_s32);
+OSSIA_KERNEL_BENCH(BM_s16_to_float);
+BENCHMARK_MAIN();
@@ -0,0 +1,154 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <ossia/math/math_expression.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Evaluation of one expression over a block of points, as done by
+// audio-rate mappings or by a mapping applied to many parameters.
+// The argument is the size of the block.
+static const std::string expression = "a * x + sin(y * 2 * pi) * (b / 3)";
+
+struct math_bench
+{
+  explicit math_bench(std::size_t n)
+      : x(n)
+      , y(n)
+      , out(n)
+  {
+    for(std::size_t i = 0; i < n; i++)
+    {
+      x[i] = double(i) / n;
+      y[i] = 1. - double(i) / n;
+    }
+
+  }
+
+  // x and y are arrays for values()
+  void setup_block(ossia::math_expression& expr)
+  {
+    expr.add_variable("a", a);
+    expr.add_variable("b", b);
+    expr.add_array("x");
+    expr.add_array("y");
+    expr.add_constants();
+    expr.register_symbol_table();
+  }
+
+  double a{0.5}, b{2.};
+  std::vector<double> x, y, out;
+};
+
+// One value() per point
+static void BM_math_points(benchmark::State& state)
+{
+  const std::size_t n = state.range(0);
+  math_bench bench{n};
+  double cur_x{}, cur_y{};
+  ossia::math_expression expr;
+  expr.add_variable("a", bench.a);
+  expr.add_variable("b", bench.b);
+  expr.add_variable("x", cur_x);
+  expr.add_variable("y", cur_y);
+  expr.add_constants();
+  expr.register_symbol_table();
+  expr.set_expression(expression);
+
+  for(auto _ : state)
+  {
+    for(std::size_t i = 0; i < n; i++)
+    {
+      cur_x = bench.x[i];
+      cur_y = bench.y[i];
+      bench.out[i] = expr.value();
+    }
+    benchmark::DoNotOptimize(bench.out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_math_block(benchmark::State& state)
+{
+  const std::size_t n = state.range(0);
+  math_bench bench{n};
+  ossia::math_expression expr;
+  bench.setup_block(expr);
+  expr.set_expression(expression);
+
+  const double* inputs[] = {bench.x.data(), bench.y.data()};
+  for(auto _ : state)
+  {
+    expr.values(inputs, bench.out.data(), n);
+    benchmark::DoNotOptimize(bench.out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// An expression which cannot be evaluated per block, through values()
+static void BM_math_block_fallback(benchmark::State& state)
+{
+  const std::size_t n = state.range(0);
+  math_bench bench{n};
+  ossia::math_expression expr;
+  bench.setup_block(expr);
+  expr.set_expression("a * x + random(0, 1) * y");
+
+  const double* inputs[] = {bench.x.data(), bench.y.data()};
+  for(auto _ : state)
+  {
+    expr.values(inputs, bench.out.data(), n);
+    benchmark::DoNotOptimize(bench.out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Compiling 1000 mapping formulas, identical if the argument is 1.
+// Identical formulas share their compiled expression.
+static void BM_math_compile(benchmark::State& state)
+{
+  const bool identical = state.range(0);
+  for(auto _ : state)
+  {
+    std::vector<std::unique_ptr<ossia::math_expression>> exprs;
+    std::vector<double> vars(1000);
+    for(int i = 0; i < 1000; i++)
+    {
+      auto& e = *exprs.emplace_back(std::make_unique<ossia::math_expression>());
+      e.add_variable("x", vars[i]);
+      e.add_constants();
+      e.register_symbol_table();
+      e.set_expression(
+          "x * " + std::to_string(identical ? 2 : i) + " + sin(x * pi)");
+    }
+    benchmark::DoNotOptimize(exprs.data());
+  }
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+// value() on instances sharing their compiled expression, one per thread
+static void BM_math_value_shared(benchmark::State& state)
+{
+  double a = 0.5, x = 0.25;
+  ossia::math_expression expr;
+  expr.add_variable("a", a);
+  expr.add_variable("x", x);
+  expr.add_constants();
+  expr.register_symbol_table();
+  expr.set_expression("a * x + sin(x * 2 * pi)");
+
+  for(auto _ : state)
+    benchmark::DoNotOptimize(expr.value());
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_math_points)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_math_block)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_math_block_fallback)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_math_compile)->Arg(0)->Arg(1);
+BENCHMARK(BM_math_value_shared)->ThreadRange(1, 4);
+BENCHMARK_MAIN();
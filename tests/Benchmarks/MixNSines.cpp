@@ -34,6 +34,9 @@ void benchmark_main()
   // We need a graph
 
 
+  // Compare builds with and without OSSIA_AUDIO_FLOAT; cache misses can be
+  // measured with e.g. perf stat -e cache-misses
+  std::cout << "sample size: " << sizeof(ossia::dsp_sample) << " bytes\n";
   std::cout << "count\tnormal\tordered\tmerged\n";
   ossia::audio_device device;
   int64_t count = 0;
@@ -0,0 +1,148 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/context.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/local/local.hpp>
+#include <ossia/network/osc/detail/osc.hpp>
+#include <ossia/network/sockets/udp_socket.hpp>
+#include <ossia/protocols/osc/osc_generic_protocol.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <oscpack/osc/OscOutboundPacketStream.h>
+
+#include <optional>
+
+// Messages per second when applying received OSC messages to parameters.
+// BM_apply_generic goes through the conversion driven by the current value
+// of the parameter, which was the only path before the typed fast path
+// used by BM_apply_typed. BM_udp_receive measures a whole OSC device
+// receiving on a single UDP socket; its second argument is the size of the
+// batches read with recvmmsg (0: one datagram per read).
+// The first argument selects the parameter type: 0 float, 1 int, 2 vec3f.
+static const ossia::val_type types[] = {
+    ossia::val_type::FLOAT, ossia::val_type::INT, ossia::val_type::VEC3F};
+
+static std::size_t write_message(char* buf, std::size_t sz, ossia::val_type t)
+{
+  oscpack::OutboundPacketStream p{buf, sz};
+  p << oscpack::BeginMessage("/foo/bar");
+  switch(t)
+  {
+    case ossia::val_type::FLOAT:
+      p << 1.5f;
+      break;
+    case ossia::val_type::INT:
+      p << int32_t(12);
+      break;
+    default:
+      p << 1.f << 2.f << 3.f;
+      break;
+  }
+  p << oscpack::EndMessage;
+  return p.Size();
+}
+
+struct message_fixture
+{
+  ossia::net::generic_device device{
+      std::make_unique<ossia::net::multiplex_protocol>(), "bench"};
+  ossia::net::parameter_base* param{};
+  char buffer[256];
+  std::optional<oscpack::ReceivedMessage> message;
+  ossia::net::message_origin_identifier id{device.get_protocol()};
+
+  explicit message_fixture(ossia::val_type t)
+  {
+    param = ossia::net::create_node(device, "/foo/bar").create_parameter(t);
+    const auto sz = write_message(buffer, sizeof(buffer), t);
+    message.emplace(oscpack::ReceivedPacket{buffer, (oscpack::osc_bundle_element_size_t)sz});
+  }
+};
+
+static void BM_apply_generic(benchmark::State& state)
+{
+  message_fixture f{types[state.range(0)]};
+  const auto& m = *f.message;
+  for(auto _ : state)
+  {
+    auto v = ossia::net::get_filtered_value(
+        *f.param, m.ArgumentsBegin(), m.ArgumentsEnd(), m.ArgumentCount());
+    f.device.apply_incoming_message(f.id, *f.param, std::move(v));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_apply_typed(benchmark::State& state)
+{
+  message_fixture f{types[state.range(0)]};
+  const auto& m = *f.message;
+  for(auto _ : state)
+  {
+    auto v = ossia::net::get_filtered_value(*f.param, m);
+    f.device.apply_incoming_message(f.id, *f.param, std::move(v));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+struct message_counter
+{
+  int64_t count{};
+  void on_message(const ossia::net::parameter_base&) { count++; }
+};
+
+static void BM_udp_receive(benchmark::State& state)
+{
+  using namespace ossia::net;
+  using proto = osc_generic_bidir_protocol<
+      osc_protocol_client<osc_1_0_policy>, udp_send_socket, udp_receive_socket>;
+  static constexpr int batch = 64;
+
+  const auto t = types[state.range(0)];
+  auto ctx = std::make_shared<network_context>();
+  udp_configuration conf{
+      {receive_socket_configuration{{"127.0.0.1", 7771}},
+       send_socket_configuration{{"127.0.0.1", 7772}}}};
+  conf.local->batch_size = state.range(1);
+  auto p = std::make_unique<proto>(ctx, *conf.remote, *conf.local);
+  auto& socket = p->from_client;
+  generic_device device{std::move(p), "bench"};
+  create_node(device, "/foo/bar").create_parameter(t);
+
+  message_counter counter;
+  device.on_message.connect<&message_counter::on_message>(&counter);
+
+  udp_send_socket sender{socket_configuration{"127.0.0.1", 7771}, ctx->context};
+  sender.connect();
+
+  char buffer[256];
+  const auto sz = write_message(buffer, sizeof(buffer), t);
+
+  int64_t sent = 0;
+  for(auto _ : state)
+  {
+    for(int i = 0; i < batch; i++)
+      sender.write(buffer, sz);
+    sent += batch;
+
+    // Stop waiting if some datagrams were dropped by the OS
+    while(counter.count < sent)
+      if(ctx->context.run_one_for(std::chrono::milliseconds(100)) == 0)
+        break;
+  }
+  state.SetItemsProcessed(counter.count);
+  state.counters["lost"] = double(sent - counter.count);
+
+  const auto stats = socket.statistics();
+  state.counters["dropped"] = double(stats.dropped);
+  state.counters["overruns"] = double(stats.overruns);
+
+  device.on_message.disconnect<&message_counter::on_message>(&counter);
+}
+
+BENCHMARK(BM_apply_generic)->DenseRange(0, 2);
+BENCHMARK(BM_apply_typed)->DenseRange(0, 2);
+BENCHMARK(BM_udp_receive)->ArgsProduct({{0, 1, 2}, {0, 64}});
+BENCHMARK_MAIN();
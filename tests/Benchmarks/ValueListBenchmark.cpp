@@ -0,0 +1,122 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <ossia/dataflow/value_pool.hpp>
+#include <ossia/dataflow/value_port.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Counts the calls to the allocator, reported per tick
+static std::atomic<int64_t> allocations{};
+
+void* operator new(std::size_t n)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if(void* p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+struct allocation_counter
+{
+  benchmark::State& state;
+  int64_t start = allocations.load(std::memory_order_relaxed);
+  ~allocation_counter()
+  {
+    state.counters["allocs_per_tick"] = benchmark::Counter(
+        double(allocations.load(std::memory_order_relaxed) - start)
+        / double(state.iterations()));
+  }
+};
+
+// Cost of moving list values through the graph during a tick.
+// The argument is the size of the lists; each iteration is one tick
+// in which 8 lists are written, copied once, then cleared.
+static constexpr int lists_per_tick = 8;
+
+static ossia::value make_list(std::size_t n)
+{
+  std::vector<ossia::value> list;
+  for(std::size_t i = 0; i < n; i++)
+    list.emplace_back(float(i));
+  return ossia::value{std::move(list)};
+}
+
+// Plain copies, as without value_pool
+static void BM_list_copy(benchmark::State& state)
+{
+  const auto list = make_list(state.range(0));
+  std::vector<ossia::value> out, in;
+  allocation_counter count{state};
+  for(auto _ : state)
+  {
+    for(int i = 0; i < lists_per_tick; i++)
+      out.push_back(list);
+    for(const auto& v : out)
+      in.push_back(v);
+    benchmark::DoNotOptimize(in.data());
+    out.clear();
+    in.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * lists_per_tick);
+}
+
+static void BM_list_pooled_copy(benchmark::State& state)
+{
+  const auto list = make_list(state.range(0));
+  ossia::value_pool out_pool, in_pool;
+  std::vector<ossia::value> out, in;
+  allocation_counter count{state};
+  for(auto _ : state)
+  {
+    for(int i = 0; i < lists_per_tick; i++)
+      out.push_back(out_pool.copy(list));
+    for(const auto& v : out)
+      in.push_back(in_pool.copy(v));
+    benchmark::DoNotOptimize(in.data());
+    for(auto& v : out)
+      out_pool.recycle(v);
+    for(auto& v : in)
+      in_pool.recycle(v);
+    out.clear();
+    in.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * lists_per_tick);
+}
+
+static void BM_list_value_port(benchmark::State& state)
+{
+  const auto list = make_list(state.range(0));
+  ossia::value_port out, in;
+  allocation_counter count{state};
+  for(auto _ : state)
+  {
+    for(int i = 0; i < lists_per_tick; i++)
+      out.write_value(list, i);
+    in.add_port_values(out);
+    benchmark::DoNotOptimize(in.get_data().data());
+    out.clear();
+    in.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * lists_per_tick);
+}
+
+BENCHMARK(BM_list_copy)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK(BM_list_pooled_copy)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK(BM_list_value_port)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK_MAIN();
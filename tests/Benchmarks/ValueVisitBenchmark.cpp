@@ -0,0 +1,107 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <ossia/network/common/value_bounding.hpp>
+#include <ossia/network/domain/domain.hpp>
+#include <ossia/network/value/value.hpp>
+#include <ossia/network/value/value_conversion.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+// Per-message cost of the operations every incoming or outgoing value goes
+// through: visitation, conversion to the type of a parameter, and bounding
+// to its domain.
+static std::vector<ossia::value> make_values(ossia::val_type t)
+{
+  std::vector<ossia::value> values;
+  for(int i = 0; i < 256; i++)
+  {
+    if(t == ossia::val_type::FLOAT)
+      values.emplace_back(float(i) / 128.f - 0.5f);
+    else
+      values.emplace_back(int(i) - 64);
+  }
+  return values;
+}
+
+struct numeric_visitor
+{
+  float operator()(float f) const noexcept { return f; }
+  float operator()(int i) const noexcept { return float(i); }
+  template <typename T>
+  float operator()(const T&) const noexcept
+  {
+    return 0.f;
+  }
+  float operator()() const noexcept { return 0.f; }
+};
+
+static void BM_apply(benchmark::State& state)
+{
+  const auto values = make_values(ossia::val_type(state.range(0)));
+  for(auto _ : state)
+  {
+    float sum = 0.f;
+    for(const auto& v : values)
+      sum += v.apply(numeric_visitor{});
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+static void BM_convert_float(benchmark::State& state)
+{
+  const auto values = make_values(ossia::val_type(state.range(0)));
+  for(auto _ : state)
+  {
+    float sum = 0.f;
+    for(const auto& v : values)
+      sum += ossia::convert<float>(v);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+static void BM_convert_int(benchmark::State& state)
+{
+  const auto values = make_values(ossia::val_type(state.range(0)));
+  for(auto _ : state)
+  {
+    int sum = 0;
+    for(const auto& v : values)
+      sum += ossia::convert<int>(v);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+static void BM_bound_value(benchmark::State& state)
+{
+  const auto t = ossia::val_type(state.range(0));
+  const auto values = make_values(t);
+  const ossia::domain dom = t == ossia::val_type::FLOAT
+                                ? ossia::make_domain(0.f, 1.f)
+                                : ossia::make_domain(0, 100);
+  for(auto _ : state)
+  {
+    for(const auto& v : values)
+    {
+      auto res = ossia::bound_value(dom, v, ossia::bounding_mode::CLIP);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+#define OSSIA_VALUE_BENCH(name)                  \
+  BENCHMARK(name)                                \
+      ->Arg(int(ossia::val_type::FLOAT))         \
+      ->Arg(int(ossia::val_type::INT))
+
+OSSIA_VALUE_BENCH(BM_apply);
+OSSIA_VALUE_BENCH(BM_convert_float);
+OSSIA_VALUE_BENCH(BM_convert_int);
+OSSIA_VALUE_BENCH(BM_bound_value);
+BENCHMARK_MAIN();
@@ -0,0 +1,173 @@
+#include <catch.hpp>
+#include <ossia/dataflow/audio_kernels.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace ossia;
+
+// Every instruction set must give the results of the scalar kernels,
+// including for the sizes which are not a multiple of the vector width.
+static std::vector<const audio_kernel_table*> available_kernels()
+{
+  std::vector<const audio_kernel_table*> res;
+  for(auto isa : {simd_isa::sse2, simd_isa::avx2, simd_isa::neon})
+    if(auto k = audio_kernels_for(isa))
+      res.push_back(k);
+  return res;
+}
+
+TEST_CASE ("test_audio_kernels_mix", "test_audio_kernels_mix")
+{
+  const auto& ref = *audio_kernels_for(simd_isa::scalar);
+  REQUIRE(audio_kernels().name != nullptr);
+
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<float> dist{-1.f, 1.f};
+
+  for(auto kp : available_kernels())
+  {
+    const auto& k = *kp;
+    INFO(k.name);
+    for(std::size_t n : {0, 1, 3, 7, 8, 17, 64, 511})
+    {
+      std::vector<double> src(n), dst(n);
+      std::vector<float> fsrc(n), fdst(n);
+      for(std::size_t i = 0; i < n; i++)
+      {
+        src[i] = dist(rng);
+        dst[i] = dist(rng);
+        fsrc[i] = dist(rng);
+        fdst[i] = dist(rng);
+      }
+
+      auto dst_ref = dst;
+      k.mix(src.data(), dst.data(), n);
+      ref.mix(src.data(), dst_ref.data(), n);
+      REQUIRE(dst == dst_ref);
+
+      k.copy_gain(dst.data(), dst.data(), n, 0.5);
+      ref.copy_gain(dst_ref.data(), dst_ref.data(), n, 0.5);
+      REQUIRE(dst == dst_ref);
+
+      k.mix_gain(src.data(), dst.data(), n, 0.25);
+      ref.mix_gain(src.data(), dst_ref.data(), n, 0.25);
+      for(std::size_t i = 0; i < n; i++)
+        REQUIRE(std::abs(dst[i] - dst_ref[i]) < 1e-12);
+
+      dst_ref = dst;
+      k.mix_from_float(fsrc.data(), dst.data(), n);
+      ref.mix_from_float(fsrc.data(), dst_ref.data(), n);
+      REQUIRE(dst == dst_ref);
+
+      auto fdst_ref = fdst;
+      k.mix_to_float(src.data(), fdst.data(), n, 0.75);
+      ref.mix_to_float(src.data(), fdst_ref.data(), n, 0.75);
+      REQUIRE(fdst == fdst_ref);
+
+      // Single precision graph
+      k.mix_f(fsrc.data(), fdst.data(), n);
+      ref.mix_f(fsrc.data(), fdst_ref.data(), n);
+      REQUIRE(fdst == fdst_ref);
+
+      k.copy_gain_f(fdst.data(), fdst.data(), n, 0.5f);
+      ref.copy_gain_f(fdst_ref.data(), fdst_ref.data(), n, 0.5f);
+      REQUIRE(fdst == fdst_ref);
+
+      k.mix_gain_f(fsrc.data(), fdst.data(), n, 0.25f);
+      ref.mix_gain_f(fsrc.data(), fdst_ref.data(), n, 0.25f);
+      for(std::size_t i = 0; i < n; i++)
+        REQUIRE(std::abs(fdst[i] - fdst_ref[i]) < 1e-6f);
+    }
+  }
+}
+
+TEST_CASE ("test_audio_kernels_interleave", "test_audio_kernels_interleave")
+{
+  const auto& ref = *audio_kernels_for(simd_isa::scalar);
+  for(auto kp : available_kernels())
+  {
+    const auto& k = *kp;
+    INFO(k.name);
+    for(std::size_t channels : {1, 2, 3})
+    {
+      const std::size_t n = 37;
+      std::vector<std::vector<float>> in(channels, std::vector<float>(n));
+      std::vector<const float*> in_p;
+      for(std::size_t c = 0; c < channels; c++)
+      {
+        for(std::size_t i = 0; i < n; i++)
+          in[c][i] = float(c * 1000 + i);
+        in_p.push_back(in[c].data());
+      }
+
+      std::vector<float> inter(n * channels), inter_ref(n * channels);
+      k.interleave(in_p.data(), inter.data(), channels, n);
+      ref.interleave(in_p.data(), inter_ref.data(), channels, n);
+      REQUIRE(inter == inter_ref);
+      REQUIRE(inter[channels] == 1.f);
+
+      std::vector<std::vector<float>> out(channels, std::vector<float>(n));
+      std::vector<float*> out_p;
+      for(auto& c : out)
+        out_p.push_back(c.data());
+      k.deinterleave(inter.data(), out_p.data(), channels, n);
+      REQUIRE(out == in);
+    }
+  }
+}
+
+TEST_CASE ("test_audio_kernels_convert", "test_audio_kernels_convert")
+{
+  const auto& ref = *audio_kernels_for(simd_isa::scalar);
+
+  // Out of range samples saturate
+  std::vector<float> in{0.f, 0.5f, -0.5f, 1.f, -1.f, 2.f, -2.f, 1e10f, -1e10f};
+  for(int i = 0; i < 40; i++)
+    in.push_back(std::sin(i * 0.3f));
+  const auto n = in.size();
+
+  std::vector<int16_t> s16(n);
+  ref.float_to_s16(in.data(), s16.data(), n);
+  REQUIRE(s16[3] == 32767);
+  REQUIRE(s16[5] == 32767);
+  REQUIRE(s16[8] == -32768);
+
+  std::vector<int32_t> s32(n);
+  ref.float_to_s32(in.data(), s32.data(), n);
+  REQUIRE(s32[4] == std::numeric_limits<int32_t>::min());
+  REQUIRE(s32[7] > 2147483000);
+
+  for(auto kp : available_kernels())
+  {
+    const auto& k = *kp;
+    INFO(k.name);
+
+    std::vector<int16_t> o16(n);
+    k.float_to_s16(in.data(), o16.data(), n);
+    for(std::size_t i = 0; i < n; i++)
+      REQUIRE(std::abs(o16[i] - s16[i]) <= 1);
+
+    std::vector<int32_t> o24(n), r24(n);
+    k.float_to_s24(in.data(), o24.data(), n);
+    ref.float_to_s24(in.data(), r24.data(), n);
+    for(std::size_t i = 0; i < n; i++)
+      REQUIRE(std::abs(o24[i] - r24[i]) <= 1);
+
+    std::vector<int32_t> o32(n);
+    k.float_to_s32(in.data(), o32.data(), n);
+    REQUIRE(o32 == s32);
+
+    std::vector<float> f(n), f_ref(n);
+    k.s16_to_float(s16.data(), f.data(), n);
+    ref.s16_to_float(s16.data(), f_ref.data(), n);
+    REQUIRE(f == f_ref);
+
+    k.s32_to_float(s32.data(), f.data(), n);
+    ref.s32_to_float(s32.data(), f_ref.data(), n);
+    REQUIRE(f == f_ref);
+  }
+}
@@ -0,0 +1,143 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <catch.hpp>
+#include <ossia/dataflow/audio_port.hpp>
+#include <ossia/dataflow/data_copy.hpp>
+
+#include <cstdint>
+
+using namespace ossia;
+
+static void run_tick(audio_port& p, std::size_t channels, std::size_t samples)
+{
+  p.set_channels(0);
+  p.set_channels(channels);
+  for(std::size_t c = 0; c < channels; c++)
+    p.channel(c).resize(samples);
+}
+
+TEST_CASE ("test_audio_port_arena", "test_audio_port_arena")
+{
+  audio_port p{audio_port::with_arena};
+  auto arena = p.get_allocator().arena();
+  REQUIRE(arena);
+
+  // The first tick measures what the port needs, the following ones reuse a
+  // single slab.
+  for(int tick = 0; tick < 3; tick++)
+    run_tick(p, 16, 512);
+
+  REQUIRE(arena->capacity() >= 16 * 512 * sizeof(dsp_sample));
+  for(std::size_t c = 0; c < 16; c++)
+  {
+    REQUIRE(arena->owns(p.channel(c).data()));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p.channel(c).data()) % audio_arena::alignment == 0);
+  }
+  REQUIRE(p.channel(1).data() == p.channel(0).data() + 512);
+
+  const auto used = arena->used();
+  run_tick(p, 16, 512);
+  REQUIRE(arena->used() == used);
+  REQUIRE(arena->allocations() == 16);
+}
+
+TEST_CASE ("test_audio_port_arena_escape", "test_audio_port_arena_escape")
+{
+  audio_channel moved;
+  audio_channel copied;
+  {
+    audio_port p{audio_port::with_arena};
+    run_tick(p, 2, 64);
+    p.channel(0)[10] = 0.5;
+    p.channel(1)[10] = 0.25;
+
+    // Copies do not use the arena of the port
+    copied = p.channel(1);
+    REQUIRE(!copied.get_stored_allocator().arena());
+
+    // Moved channels keep it alive
+    moved = std::move(p.channel(0));
+    REQUIRE(moved.get_stored_allocator().arena() == p.get_allocator().arena());
+  }
+  REQUIRE(moved.size() == 64);
+  REQUIRE(moved[10] == 0.5);
+  REQUIRE(copied[10] == 0.25);
+  moved.resize(4096);
+  REQUIRE(moved[10] == 0.5);
+}
+
+TEST_CASE ("test_audio_port_arena_copy", "test_audio_port_arena_copy")
+{
+  audio_port p{audio_port::with_arena};
+  REQUIRE(p.get_allocator().arena());
+
+  // Only inlets and outlets get an arena, not copies or temporaries
+  REQUIRE(!audio_port{}.get_allocator().arena());
+  audio_port copy = p;
+  REQUIRE(!copy.get_allocator().arena());
+  REQUIRE(!copy.channel(0).get_stored_allocator().arena());
+}
+
+/*! channels moved to another port are resized in the arena they come from */
+TEST_CASE ("test_audio_port_arena_move", "test_audio_port_arena_move")
+{
+  audio_port out{audio_port::with_arena};
+  audio_port in{audio_port::with_arena};
+  auto out_arena = out.get_allocator().arena();
+  auto in_arena = in.get_allocator().arena();
+
+  for(int tick = 0; tick < 3; tick++)
+  {
+    run_tick(out, 2, 64);
+    run_tick(in, 2, 64);
+    out.channel(0)[10] = 0.5;
+    out.channel(1)[10] = 0.25;
+    in.channel(0)[10] = 0.125;
+
+    // What the graph does for a cable between an outlet and an inlet
+    move_data{}(out, in);
+    REQUIRE(in.channel(0).get_stored_allocator().arena() == out_arena);
+    REQUIRE(out.channel(0).get_stored_allocator().arena() == in_arena);
+
+    // Both ports are resized, each with the channels of the other
+    in.channel(0).resize(256);
+    in.channel(1).resize(32);
+    in.set_channels(3);
+    in.channel(2).resize(128);
+    out.channel(0).resize(512);
+    out.set_channels(1);
+
+    REQUIRE(in.channel(0)[10] == 0.5);
+    REQUIRE(in.channel(1)[10] == 0.25);
+    REQUIRE(in.channel(2).get_stored_allocator().arena() == in_arena);
+    REQUIRE(out.channel(0)[10] == 0.125);
+    REQUIRE(out.channels() == 1);
+
+    REQUIRE(out_arena->allocations() == 2);
+    REQUIRE(in_arena->allocations() == 2);
+  }
+
+  // Once the ports are cleared, each arena is rewound
+  out.set_channels(0);
+  in.set_channels(0);
+  REQUIRE(out_arena->allocations() == 0);
+  REQUIRE(in_arena->allocations() == 0);
+}
+
+TEST_CASE ("test_audio_port_mix", "test_audio_port_mix")
+{
+  audio_port src;
+  run_tick(src, 2, 64);
+  for(auto& c : src)
+    for(auto& s : c)
+      s = 0.5;
+
+  audio_port sink;
+  sink.set_channels(0);
+  mix(src.get(), sink);
+  mix(src.get(), sink);
+  REQUIRE(sink.channels() == 2);
+  REQUIRE(sink.channel(1)[63] == 1.);
+  REQUIRE(sink.channel(0).get_stored_allocator() == sink.get_allocator());
+}
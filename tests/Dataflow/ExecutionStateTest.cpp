@@ -0,0 +1,132 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <catch.hpp>
+#include <ossia/detail/config.hpp>
+#include <ossia/audio/audio_parameter.hpp>
+#include <ossia/dataflow/execution_state.hpp>
+#include <ossia/dataflow/parameter_slots.hpp>
+#include <ossia/dataflow/port.hpp>
+#include "../Network/TestUtils.hpp"
+
+using namespace ossia;
+
+namespace
+{
+audio_port make_port(std::size_t channels, std::size_t samples, double value)
+{
+  audio_port p;
+  p.set_channels(channels);
+  for(auto& c : p.get())
+    c.assign(samples, value);
+  return p;
+}
+}
+
+/*! the slot cached in a parameter is only used by the instance which gave it */
+TEST_CASE ("parameter_slots", "parameter_slots")
+{
+  ossia::net::generic_device device{"test"};
+  auto a = device.create_child("a")->create_parameter(val_type::FLOAT);
+  auto b = device.create_child("b")->create_parameter(val_type::INT);
+  auto c = device.create_child("c")->create_parameter(val_type::BOOL);
+
+  parameter_slots s1, s2;
+  REQUIRE(s1.find(a) == parameter_slots::no_slot);
+
+  REQUIRE(s1.acquire(a) == 0);
+  REQUIRE(s1.acquire(b) == 1);
+  REQUIRE(s1.find(a) == 0);
+
+  // a is cached with the slot of s2, where b does not exist
+  REQUIRE(s2.acquire(b) == 0);
+  REQUIRE(s2.acquire(a) == 1);
+  REQUIRE(s1.find(a) == 0);
+  REQUIRE(s1.find(b) == 1);
+  REQUIRE(s2.find(b) == 0);
+
+  // A released slot is given to another parameter
+  s1.release(a);
+  REQUIRE(s1.find(a) == parameter_slots::no_slot);
+  REQUIRE(s1.acquire(c) == 0);
+  REQUIRE(s1.find(a) == parameter_slots::no_slot);
+  REQUIRE(s1.find(c) == 0);
+
+  s2.clear();
+  REQUIRE(s2.find(a) == parameter_slots::no_slot);
+  REQUIRE(s2.find(b) == parameter_slots::no_slot);
+
+  // Execution time parameters get a slot too
+  parameter_slot_map<net::parameter_base, int> map{s2};
+  map[a] = 1;
+  map[b] = 2;
+  REQUIRE(map.find(a)->second == 1);
+  REQUIRE(map.find(b)->second == 2);
+  REQUIRE(map.find(c) == map.end());
+}
+
+TEST_CASE ("parallel_state_merge_order", "parallel_state_merge_order")
+{
+  TestDevice test;
+  execution_state e;
+
+  // Nodes finishing out of order: the merge follows the execution order
+  e.begin_parallel_node(2);
+  e.insert(*test.float_addr, typed_value{ossia::value(3.f)});
+  e.end_parallel_node();
+
+  e.begin_parallel_node(0);
+  e.insert(*test.float_addr, typed_value{ossia::value(1.f)});
+  e.insert(*test.float_addr, typed_value{ossia::value(2.f)});
+  e.end_parallel_node();
+
+  REQUIRE(e.in_local_scope(*test.float_addr));
+  e.merge_parallel_state();
+
+  auto& vec = e.m_valueState[test.float_addr];
+  REQUIRE(vec.size() == 3);
+#if defined(OSSIA_PARALLEL)
+  REQUIRE(vec[0].first.value == ossia::value(1.f));
+  REQUIRE(vec[1].first.value == ossia::value(2.f));
+  REQUIRE(vec[2].first.value == ossia::value(3.f));
+  REQUIRE(vec[0].second < vec[1].second);
+  REQUIRE(vec[1].second < vec[2].second);
+#endif
+}
+
+/*! the buffers of the parallel writes are reused by ports of another shape */
+TEST_CASE ("parallel_state_audio", "parallel_state_audio")
+{
+  TestDevice test;
+  auto node = test.device.create_child("audio");
+  auto param = std::make_unique<virtual_audio_parameter>(2, *node);
+  auto& audio = *param;
+  node->set_parameter(std::move(param));
+
+  execution_state e;
+  auto tick = [&](const audio_port& a, const audio_port& b) {
+    e.begin_parallel_node(0);
+    e.insert(audio, a);
+    e.insert(audio, b);
+    e.end_parallel_node();
+    e.merge_parallel_state();
+
+    audio_port res = e.m_audioState[&audio];
+    e.m_audioState[&audio].set_channels(0);
+    return res;
+  };
+
+  auto res = tick(make_port(2, 8, 1.), make_port(1, 4, 2.));
+  REQUIRE(res.channels() == 2);
+  REQUIRE(res.channel(0).size() == 8);
+  REQUIRE(res.channel(0)[0] == 3.);
+  REQUIRE(res.channel(0)[7] == 1.);
+  REQUIRE(res.channel(1)[0] == 1.);
+
+  // Narrower then wider than the previous tick
+  res = tick(make_port(1, 4, 1.), make_port(3, 4, 2.));
+  REQUIRE(res.channels() == 3);
+  REQUIRE(res.channel(0)[0] == 3.);
+  REQUIRE(res.channel(1)[0] == 2.);
+  REQUIRE(res.channel(2)[0] == 2.);
+}
@@ -0,0 +1,137 @@
+#include <ossia/dataflow/graph/graph_parallel.hpp>
+#include <ossia/dataflow/graph_node.hpp>
+#include <ossia/dataflow/graph_edge_helpers.hpp>
+#include <ossia/dataflow/execution_state.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+
+// Compares the shared-queue executor with the work-stealing one
+// on a DAW-like graph: N parallel chains merged in two levels of groups.
+static const constexpr int NUM_TAKES = 2000;
+static const constexpr auto NUM_NODES = {100, 500, 1000};
+static const constexpr auto NUM_THREADS = {1, 2, 4, 6, 8, 12, 16};
+
+using namespace ossia;
+
+class node_busy_mock final : public graph_node
+{
+public:
+  node_busy_mock()
+  {
+    m_inlets.push_back(new ossia::value_inlet);
+    m_outlets.push_back(new ossia::value_outlet);
+  }
+
+  void run(const token_request& t, exec_state_facade e) noexcept override
+  {
+    // Roughly the cost of a small DSP node on a 64-sample buffer
+    double acc = 0.;
+    for(int i = 0; i < 64; i++)
+      acc += std::sin(i * 0.1);
+    sink = acc;
+  }
+
+  volatile double sink{};
+};
+
+struct setup_dawlike
+{
+  int chain_count = 100;
+  template <typename T>
+  auto operator()(int num_nodes, T& g) const
+  {
+    using chain = std::vector<std::shared_ptr<node_busy_mock>>;
+    std::vector<std::shared_ptr<node_busy_mock>> nodes;
+    std::vector<chain> chains(chain_count);
+
+    auto connect = [&](auto& prev, auto& next) {
+      g.connect(g.allocate_edge(
+          ossia::immediate_strict_connection{}, prev->root_outputs()[0],
+          next->root_inputs()[0], prev, next));
+    };
+
+    for(auto& chain : chains)
+    {
+      for(int i = 0; i < num_nodes / chain_count; i++)
+      {
+        auto n = std::make_shared<node_busy_mock>();
+        nodes.push_back(n);
+        g.add_node(n);
+        if(!chain.empty())
+          connect(chain.back(), n);
+        chain.push_back(n);
+      }
+    }
+
+    std::vector<std::shared_ptr<node_busy_mock>> groups;
+    for(int i = 0; i < chain_count / 4; i++)
+    {
+      auto n = std::make_shared<node_busy_mock>();
+      nodes.push_back(n);
+      groups.push_back(n);
+      g.add_node(n);
+      for(int j = 4 * i; j < 4 * i + 4; j++)
+        if(!chains[j].empty())
+          connect(chains[j].back(), n);
+    }
+
+    auto master = std::make_shared<node_busy_mock>();
+    nodes.push_back(master);
+    g.add_node(master);
+    for(auto& n : groups)
+      connect(n, master);
+
+    return nodes;
+  }
+};
+
+template <typename Graph_T>
+double measure(int num_nodes, int num_threads)
+{
+  // The graph is too large for the stack
+  auto graph = std::make_unique<Graph_T>();
+  auto& g = *graph;
+  g.update_fun.set_num_threads(num_threads);
+  auto nodes = setup_dawlike{}(num_nodes, g);
+
+  ossia::execution_state e;
+
+  // ensure that a tick happens to make it clean
+  g.state(e);
+
+  auto t0 = std::chrono::steady_clock::now();
+  for(int i = 0; i < NUM_TAKES; i++)
+  {
+    for(auto& node : nodes)
+      node->request({});
+    g.state(e);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()
+         / (1000. * NUM_TAKES);
+}
+
+int main()
+{
+  using queue_graph = graph_static<
+      custom_parallel_update<simple_update, ossia::executor>, custom_parallel_exec>;
+  using stealing_graph = graph_static<
+      custom_parallel_update<simple_update, ossia::work_stealing_executor>,
+      custom_parallel_exec>;
+
+  std::cout << "nodes\tthreads\tqueue (us/tick)\twork-stealing (us/tick)\n";
+  for(int n : NUM_NODES)
+  {
+    for(int t : NUM_THREADS)
+    {
+      const double q = measure<queue_graph>(n, t);
+      const double ws = measure<stealing_graph>(n, t);
+      std::cout << n << "\t" << t << "\t" << q << "\t" << ws << std::endl;
+    }
+  }
+}
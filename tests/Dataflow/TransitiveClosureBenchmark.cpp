@@ -0,0 +1,122 @@
+#include <ossia/dataflow/graph/graph_static.hpp>
+#include <ossia/dataflow/graph_edge_helpers.hpp>
+#include <ossia/dataflow/graph_node.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+// Applies random connections / disconnections to a graph and measures
+// the time taken to bring the transitive closure up to date after each edit,
+// with a full recomputation (fast_tc) and incrementally (incremental_tc).
+static const constexpr auto NUM_NODES = {1000, 5000};
+static const constexpr int NUM_EDITS = 200;
+static const constexpr int NUM_FULL_EDITS = 10;
+static const constexpr double EDGE_RATIO = 2.;
+
+using namespace ossia;
+
+static std::mt19937 mt{1234};
+
+class node_empty_mock final : public graph_node
+{
+public:
+  node_empty_mock()
+  {
+    m_inlets.push_back(new ossia::value_inlet);
+    m_outlets.push_back(new ossia::value_outlet);
+  }
+
+  void run(const token_request& t, exec_state_facade e) noexcept override { }
+};
+
+using graph_type = graph_static<simple_update, static_exec>;
+
+struct random_editor
+{
+  graph_type& g;
+  std::vector<std::shared_ptr<node_empty_mock>>& nodes;
+  std::vector<ossia::edge_ptr> edges;
+
+  void connect()
+  {
+    // Edges always go forward in the creation order so the graph stays a DAG
+    std::size_t i = std::uniform_int_distribution<std::size_t>{0, nodes.size() - 2}(mt);
+    std::size_t j
+        = std::uniform_int_distribution<std::size_t>{i + 1, nodes.size() - 1}(mt);
+    auto edge = g.allocate_edge(
+        ossia::immediate_strict_connection{}, nodes[i]->root_outputs()[0],
+        nodes[j]->root_inputs()[0], nodes[i], nodes[j]);
+    g.connect(edge);
+    edges.push_back(std::move(edge));
+  }
+
+  void disconnect()
+  {
+    std::size_t i = std::uniform_int_distribution<std::size_t>{0, edges.size() - 1}(mt);
+    g.disconnect(edges[i]);
+    edges.erase(edges.begin() + i);
+  }
+
+  void operator()()
+  {
+    if(edges.empty() || mt() % 2)
+      connect();
+    else
+      disconnect();
+  }
+};
+
+int main()
+{
+  std::cout << "nodes\tfull (us/edit)\tincremental (us/edit)\n";
+  for(int num_nodes : NUM_NODES)
+  {
+    graph_type g;
+    std::vector<std::shared_ptr<node_empty_mock>> nodes;
+    for(int i = 0; i < num_nodes; i++)
+    {
+      nodes.push_back(std::make_shared<node_empty_mock>());
+      g.add_node(nodes.back());
+    }
+
+    random_editor edit{g, nodes};
+    for(int i = 0; i < num_nodes * EDGE_RATIO; i++)
+      edit.connect();
+
+    fast_tc full;
+    incremental_tc incremental;
+
+    auto sync = [&] {
+      g.update_fun(g, std::vector<ossia::net::device_base*>{});
+      incremental.update(g.m_graph, g.m_topo_order, g.m_edits);
+      g.m_edits.clear();
+    };
+    sync();
+
+    double full_time = 0.;
+    double incremental_time = 0.;
+    for(int i = 0; i < NUM_EDITS; i++)
+    {
+      edit();
+      g.update_fun(g, std::vector<ossia::net::device_base*>{});
+
+      if(i < NUM_FULL_EDITS)
+      {
+        auto t0 = std::chrono::steady_clock::now();
+        full.update(g.m_graph);
+        auto t1 = std::chrono::steady_clock::now();
+        full_time += std::chrono::duration<double, std::micro>(t1 - t0).count();
+      }
+
+      auto t0 = std::chrono::steady_clock::now();
+      incremental.update(g.m_graph, g.m_topo_order, g.m_edits);
+      auto t1 = std::chrono::steady_clock::now();
+      incremental_time += std::chrono::duration<double, std::micro>(t1 - t0).count();
+      g.m_edits.clear();
+    }
+
+    std::cout << num_nodes << "\t" << full_time / NUM_FULL_EDITS << "\t"
+              << incremental_time / NUM_EDITS << std::endl;
+  }
+}
@@ -0,0 +1,249 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <catch.hpp>
+#include <ossia/detail/config.hpp>
+#include <ossia/dataflow/graph/graph_static.hpp>
+#include <ossia/dataflow/graph_edge_helpers.hpp>
+#include <ossia/dataflow/graph_node.hpp>
+#include <ossia/detail/algorithms.hpp>
+
+#include <memory>
+#include <random>
+
+using namespace ossia;
+
+namespace
+{
+class node_empty_mock final : public graph_node
+{
+public:
+  node_empty_mock()
+  {
+    m_inlets.push_back(new ossia::value_inlet);
+    m_outlets.push_back(new ossia::value_outlet);
+  }
+
+  void run(const token_request& t, exec_state_facade e) noexcept override { }
+};
+
+using graph_type = graph_static<simple_update, static_exec>;
+
+// The graph keeps large inline buffers: too large for the stack
+std::unique_ptr<graph_type> make_graph()
+{
+  return std::make_unique<graph_type>();
+}
+
+// Reachability computed from scratch with a search from each vertex
+std::vector<std::vector<bool>> full_closure(const graph_t& g)
+{
+  const std::size_t N = boost::num_vertices(g);
+  std::vector<std::vector<bool>> res(N, std::vector<bool>(N, false));
+  std::vector<std::size_t> stack;
+  for(std::size_t v = 0; v < N; v++)
+  {
+    stack.assign(1, v);
+    while(!stack.empty())
+    {
+      const auto u = stack.back();
+      stack.pop_back();
+      for(auto [it, end] = boost::out_edges(u, g); it != end; ++it)
+      {
+        const std::size_t w = boost::target(*it, g);
+        if(!res[v][w])
+        {
+          res[v][w] = true;
+          stack.push_back(w);
+        }
+      }
+    }
+  }
+  return res;
+}
+
+struct random_editor
+{
+  graph_type& g;
+  std::mt19937& mt;
+  std::vector<std::shared_ptr<node_empty_mock>> nodes;
+  std::vector<ossia::edge_ptr> edges;
+
+  std::size_t pick(std::size_t min, std::size_t max)
+  {
+    return std::uniform_int_distribution<std::size_t>{min, max}(mt);
+  }
+
+  void add_node()
+  {
+    nodes.push_back(std::make_shared<node_empty_mock>());
+    g.add_node(nodes.back());
+  }
+
+  void remove_node()
+  {
+    auto node = nodes[pick(0, nodes.size() - 1)];
+    ossia::remove_erase_if(edges, [&](const ossia::edge_ptr& e) {
+      return e->in_node == node || e->out_node == node;
+    });
+    g.remove_node(node);
+    ossia::remove_one(nodes, node);
+  }
+
+  void connect()
+  {
+    // Edges always go forward in the creation order so the graph stays a DAG
+    const std::size_t i = pick(0, nodes.size() - 2);
+    const std::size_t j = pick(i + 1, nodes.size() - 1);
+    auto edge = g.allocate_edge(
+        ossia::immediate_strict_connection{}, nodes[i]->root_outputs()[0],
+        nodes[j]->root_inputs()[0], nodes[i], nodes[j]);
+    g.connect(edge);
+    edges.push_back(std::move(edge));
+  }
+
+  void disconnect()
+  {
+    const std::size_t i = pick(0, edges.size() - 1);
+    g.disconnect(edges[i]);
+    edges.erase(edges.begin() + i);
+  }
+};
+
+void check_closure(graph_type& g, incremental_tc& tc)
+{
+  g.update_fun(g, std::vector<ossia::net::device_base*>{});
+  tc.update(g.m_graph, g.m_topo_order, g.m_edits);
+  g.m_edits.clear();
+
+  const auto expected = full_closure(g.m_graph);
+  const std::size_t N = expected.size();
+  for(std::size_t i = 0; i < N; i++)
+    for(std::size_t j = 0; j < N; j++)
+      REQUIRE(tc.has_edge(i, j) == expected[i][j]);
+}
+}
+
+/*! the incremental closure matches a full recomputation after random edits */
+TEST_CASE ("test_incremental_edges", "test_incremental_edges")
+{
+  std::mt19937 mt{1234};
+  auto graph = make_graph();
+  auto& g = *graph;
+  random_editor edit{g, mt};
+  for(int i = 0; i < 80; i++)
+    edit.add_node();
+  for(int i = 0; i < 120; i++)
+    edit.connect();
+
+  incremental_tc tc;
+  check_closure(g, tc);
+
+  for(int i = 0; i < 300; i++)
+  {
+    // Several edits between two updates, as between two ticks
+    const int count = 1 + mt() % 4;
+    for(int k = 0; k < count; k++)
+    {
+      if(edit.edges.empty() || mt() % 2)
+        edit.connect();
+      else
+        edit.disconnect();
+    }
+    check_closure(g, tc);
+  }
+}
+
+/*! vertex insertions and removals are handled too */
+TEST_CASE ("test_incremental_vertices", "test_incremental_vertices")
+{
+  std::mt19937 mt{4321};
+  auto graph = make_graph();
+  auto& g = *graph;
+  random_editor edit{g, mt};
+  for(int i = 0; i < 40; i++)
+    edit.add_node();
+  for(int i = 0; i < 60; i++)
+    edit.connect();
+
+  incremental_tc tc;
+  check_closure(g, tc);
+
+  for(int i = 0; i < 200; i++)
+  {
+    switch(mt() % 6)
+    {
+      case 0:
+        edit.add_node();
+        break;
+      case 1:
+        if(edit.nodes.size() > 10)
+          edit.remove_node();
+        break;
+      case 2:
+      case 3:
+        edit.connect();
+        break;
+      default:
+        if(!edit.edges.empty())
+          edit.disconnect();
+        break;
+    }
+    check_closure(g, tc);
+  }
+}
+
+/*! the topological order is kept up to date across edits */
+TEST_CASE ("test_incremental_topological_order", "test_incremental_topological_order")
+{
+  auto graph = make_graph();
+  auto& g = *graph;
+
+  auto n1 = std::make_shared<node_empty_mock>();
+  auto n2 = std::make_shared<node_empty_mock>();
+  auto n3 = std::make_shared<node_empty_mock>();
+
+  g.add_node(n1);
+  g.add_node(n2);
+  g.add_node(n3);
+
+  auto is_before = [&] (graph_node* a, graph_node* b) {
+    auto& o = g.m_all_nodes;
+    return ossia::find(o, a) < ossia::find(o, b);
+  };
+  auto strict_edge = [&] (const auto& out, const auto& in) {
+    return g.allocate_edge(
+        immediate_strict_connection{}, out->root_outputs()[0],
+        in->root_inputs()[0], out, in);
+  };
+
+  // n3 -> n2 -> n1: the order has to be reversed
+  auto c1 = strict_edge(n3, n2);
+  auto c2 = strict_edge(n2, n1);
+  g.connect(c1);
+  g.connect(c2);
+  g.update_fun(g, std::vector<ossia::net::device_base*>{});
+
+  REQUIRE(g.m_topo_order.valid());
+  REQUIRE(g.m_all_nodes.size() == 3);
+  REQUIRE(is_before(n3.get(), n2.get()));
+  REQUIRE(is_before(n2.get(), n1.get()));
+
+  // n1 -> n3 after removing n3 -> n2
+  g.disconnect(c1);
+  auto c3 = strict_edge(n1, n3);
+  g.connect(c3);
+  g.update_fun(g, std::vector<ossia::net::device_base*>{});
+
+  REQUIRE(g.m_topo_order.valid());
+  REQUIRE(is_before(n2.get(), n1.get()));
+  REQUIRE(is_before(n1.get(), n3.get()));
+
+  // Removing a node renumbers the vertices
+  g.remove_node(n2);
+  g.update_fun(g, std::vector<ossia::net::device_base*>{});
+
+  REQUIRE(g.m_topo_order.valid());
+  REQUIRE(g.m_all_nodes.size() == 2);
+  REQUIRE(is_before(n1.get(), n3.get()));
+}
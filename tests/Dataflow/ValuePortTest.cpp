@@ -288,3 +288,78 @@ TEMPLATE_TEST_CASE ("test_add_global_value", "test_add_global_value",
     }
   }
 }
+
+TEST_CASE ("test_write_value_timestamps", "test_write_value_timestamps")
+{
+  ossia::value_port p;
+  p.write_value(1, 0);
+  p.write_value(2, 12);
+  ossia::value v{3};
+  p.write_value(v, 31);
+
+  REQUIRE(p.get_data().size() == 3);
+  REQUIRE(p.get_data()[0].timestamp == 0);
+  REQUIRE(p.get_data()[1].timestamp == 12);
+  REQUIRE(p.get_data()[2].timestamp == 31);
+}
+
+TEST_CASE ("test_write_value_replace", "test_write_value_replace")
+{
+  // With mix_replace, only the values written at the same timestamp replace
+  // each other
+  ossia::value_port p;
+  p.mix_method = ossia::data_mix_method::mix_replace;
+  p.write_value(1, 0);
+  p.write_value(2, 12);
+  REQUIRE(p.get_data().size() == 2);
+
+  p.write_value(3, 12);
+  ossia::value v{4};
+  p.write_value(v, 0);
+  REQUIRE(p.get_data().size() == 2);
+  REQUIRE(p.get_data()[0].timestamp == 0);
+  REQUIRE(p.get_data()[0].value == 4);
+  REQUIRE(p.get_data()[1].timestamp == 12);
+  REQUIRE(p.get_data()[1].value == 3);
+
+  p.write_value(5, 31);
+  REQUIRE(p.get_data().size() == 3);
+  REQUIRE(p.get_data()[2].timestamp == 31);
+}
+
+TEST_CASE ("test_list_storage_reuse", "test_list_storage_reuse")
+{
+  // Lists and strings written at a tick reuse the buffers of the previous one
+  const std::string text(64, 'x');
+  const ossia::value list{std::vector<ossia::value>{
+      1.f, 2, std::vector<ossia::value>{3.f, 4.f}, text}};
+
+  ossia::value_port p, q;
+  p.write_value(list, 0);
+  q.add_port_values(p);
+  REQUIRE(q.get_data().size() == 1);
+  REQUIRE(q.get_data()[0].value == list);
+
+  const auto& written = q.get_data()[0].value.get<std::vector<ossia::value>>();
+  const void* outer = written.data();
+  const void* inner = written[2].get<std::vector<ossia::value>>().data();
+  const void* str = written[3].get<std::string>().data();
+
+  p.clear();
+  q.clear();
+
+  p.write_value(list, 0);
+  q.add_port_values(p);
+  REQUIRE(q.get_data()[0].value == list);
+
+  const auto& rewritten = q.get_data()[0].value.get<std::vector<ossia::value>>();
+  const void* buffers[] = {
+      rewritten.data(), rewritten[2].get<std::vector<ossia::value>>().data(),
+      rewritten[3].get<std::string>().data()};
+  for(const void* buf : {outer, inner, str})
+    REQUIRE(std::find(std::begin(buffers), std::end(buffers), buf) != std::end(buffers));
+
+  // The source is left untouched
+  REQUIRE(list.get<std::vector<ossia::value>>().size() == 4);
+  REQUIRE(list.get<std::vector<ossia::value>>()[3].get<std::string>() == text);
+}
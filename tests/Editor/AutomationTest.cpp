@@ -1,6 +1,146 @@
-// TODO
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
-int main()
+#include <catch.hpp>
+#include <ossia/detail/config.hpp>
+#include <ossia/dataflow/execution_state.hpp>
+#include <ossia/dataflow/nodes/automation.hpp>
+#include <ossia/editor/curve/curve.hpp>
+#include <ossia/editor/curve/curve_segment/linear.hpp>
+
+using namespace ossia;
+
+namespace
+{
+// A ramp from 0 to 1 over the whole automation
+curve<double, float> ramp()
+{
+  curve<double, float> c;
+  c.set_x0(0.);
+  c.set_y0(0.);
+  c.add_point(curve_segment_linear<float>{}, 1., 1.);
+  return c;
+}
+
+// The first half of an automation lasting 128 samples, in a 64 samples buffer:
+// sample k of the tick is at position (k + 1) / 128.
+const token_request first_half = simple_token_request{0_tv, 64_tv, 128_tv, 0_tv};
+
+void run(graph_node& node, const token_request& t, execution_state& e)
+{
+  node.run(t, exec_state_facade{&e});
+}
+
+const ossia::value_vector<timed_value>& values(graph_node& node)
 {
+  return node.root_outputs()[0]->target<ossia::value_port>()->get_data();
+}
+
+void check_value(const timed_value& v, float expected, int64_t timestamp)
+{
+  REQUIRE(v.timestamp == timestamp);
+  REQUIRE(ossia::convert<float>(v.value) == Approx(expected));
+}
+}
+
+/*! without a control rate, a tick writes the value at its end */
+TEST_CASE ("test_tick_rate", "test_tick_rate")
+{
+  execution_state e;
+  e.bufferSize = 64;
+
+  auto node = std::make_shared<nodes::float_automation>();
+  node->set_behavior(ramp());
+  run(*node, first_half, e);
+
+  REQUIRE(values(*node).size() == 1);
+  check_value(values(*node)[0], 0.5f, 0);
+}
+
+/*! a value per sub-block, taken at the end of the sub-block */
+TEST_CASE ("test_control_rate", "test_control_rate")
+{
+  execution_state e;
+  e.bufferSize = 64;
+
+  SECTION("float_automation")
+  {
+    auto node = std::make_shared<nodes::float_automation>();
+    node->set_behavior(ramp());
+    nodes::automation_process proc{node};
+    proc.set_control_rate(16);
+    run(*node, first_half, e);
+
+    auto& v = values(*node);
+    REQUIRE(v.size() == 4);
+    for(int i = 0; i < 4; i++)
+      check_value(v[i], (i + 1) * 16 / 128.f, i * 16);
+  }
+
+  SECTION("float_automation, incomplete last sub-block")
+  {
+    auto node = std::make_shared<nodes::float_automation>();
+    node->set_behavior(ramp());
+    nodes::automation_process proc{node};
+    proc.set_control_rate(24);
+    run(*node, first_half, e);
+
+    auto& v = values(*node);
+    REQUIRE(v.size() == 3);
+    check_value(v[0], 24 / 128.f, 0);
+    check_value(v[1], 48 / 128.f, 24);
+    check_value(v[2], 64 / 128.f, 48);
+  }
+
+  SECTION("automation")
+  {
+    auto node = std::make_shared<nodes::automation>();
+    node->set_behavior(std::make_shared<curve<double, float>>(ramp()));
+    nodes::automation_process proc{node};
+    proc.set_control_rate(32);
+    run(*node, first_half, e);
+
+    auto& v = values(*node);
+    REQUIRE(v.size() == 2);
+    check_value(v[0], 0.25f, 0);
+    check_value(v[1], 0.5f, 32);
+  }
+
+  SECTION("a rate larger than the tick")
+  {
+    auto node = std::make_shared<nodes::float_automation>();
+    node->set_behavior(ramp());
+    nodes::automation_process proc{node};
+    proc.set_control_rate(128);
+    run(*node, first_half, e);
+
+    REQUIRE(values(*node).size() == 1);
+    check_value(values(*node)[0], 0.5f, 0);
+  }
+}
+
+/*! every sample of the tick is written */
+TEST_CASE ("test_audio_rate", "test_audio_rate")
+{
+  execution_state e;
+  e.bufferSize = 64;
+
+  auto node = std::make_shared<nodes::audio_automation>();
+  node->set_behavior(ramp());
+  nodes::automation_process proc{node};
+  proc.set_control_rate(16);
+  auto& audio = *node->root_outputs()[0]->target<ossia::audio_port>();
+
+  run(*node, first_half, e);
+  REQUIRE(audio.channels() == 1);
+  REQUIRE(audio.channel(0).size() == 64);
+  for(int k = 0; k < 64; k++)
+    REQUIRE(audio.channel(0)[k] == Approx((k + 1) / 128.));
 
+  // A tick starting in the middle of the buffer
+  const token_request t = simple_token_request{64_tv, 96_tv, 128_tv, 16_tv};
+  run(*node, t, e);
+  REQUIRE(audio.channel(0).size() == 48);
+  for(int k = 0; k < 32; k++)
+    REQUIRE(audio.channel(0)[16 + k] == Approx((64 + k + 1) / 128.));
 }
@@ -1,5 +1,104 @@
-// TODO
-int main()
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <catch.hpp>
+#include <ossia/detail/config.hpp>
+#include <ossia/editor/scenario/clock.hpp>
+#include <ossia/editor/scenario/time_event.hpp>
+#include <ossia/editor/scenario/time_interval.hpp>
+#include <ossia/editor/scenario/time_sync.hpp>
+
+#include <thread>
+
+using namespace ossia;
+using namespace std::literals;
+
+// The syncs own the events the interval refers to
+struct test_interval
 {
+  std::shared_ptr<time_sync> start_node = std::make_shared<time_sync>();
+  std::shared_ptr<time_sync> end_node = std::make_shared<time_sync>();
+  std::shared_ptr<time_interval> interval;
+
+  explicit test_interval(ossia::time_value duration)
+  {
+    auto start_event = *(start_node->emplace(start_node->get_time_events().begin(), {}));
+    auto end_event = *(end_node->emplace(end_node->get_time_events().begin(), {}));
+    interval = time_interval::create(
+        {}, *start_event, *end_event, duration, duration, duration);
+  }
+};
+
+/*! test accessors */
+TEST_CASE ("test_basic", "test_basic")
+{
+  test_interval itv{100._tv};
+  ossia::clock c{*itv.interval};
+
+  REQUIRE(c.get_wait_strategy() == clock::wait_strategy::HYBRID);
+  c.set_wait_strategy(clock::wait_strategy::TIMERFD);
+  REQUIRE(c.get_wait_strategy() == clock::wait_strategy::TIMERFD);
+
+  REQUIRE(c.get_statistics().ticks == 0);
+}
+
+/*! test that the date of the clock follows the monotonic clock */
+TEST_CASE ("test_wait_strategies", "test_wait_strategies")
+{
+  using namespace std::chrono;
+  for(auto strategy :
+      {clock::wait_strategy::HYBRID, clock::wait_strategy::NANOSLEEP,
+       clock::wait_strategy::TIMERFD})
+  {
+    // The interval lasts 100 ms, the dates of the clock are in microseconds
+    test_interval itv{100._tv};
+    ossia::clock c{*itv.interval};
+    c.set_granularity(1ms);
+    c.set_wait_strategy(strategy);
+
+    const auto t0 = clock_type::now();
+    c.start_and_tick();
+    while(c.running())
+      std::this_thread::sleep_for(1ms);
+    const auto elapsed = duration_cast<microseconds>(clock_type::now() - t0);
+
+    // The clock ends on the first tick after its duration
+    const auto date = microseconds(c.get_date().impl);
+    REQUIRE(date >= 100ms);
+    REQUIRE(elapsed >= date);
+
+    // The date does not drift from the monotonic clock: it only lags behind
+    // it by the time needed to notice the end of the clock.
+    // The tolerances are loose so that loaded machines pass.
+    REQUIRE(elapsed - date < 50ms);
+
+    const auto stats = c.get_statistics();
+    REQUIRE(stats.ticks > 0);
+    REQUIRE(stats.ticks + stats.missed_ticks >= 100);
+    REQUIRE(stats.max_lateness >= stats.mean_lateness());
+
+    // Ticks are on time on average, and most of them are not skipped
+    REQUIRE(stats.mean_lateness() < 2ms);
+    REQUIRE(stats.missed_ticks < stats.ticks);
+  }
+}
+
+/*! test that the clock can be started again as soon as it ended */
+TEST_CASE ("test_restart", "test_restart")
+{
+  test_interval itv{10._tv};
+  ossia::clock c{*itv.interval};
+  c.set_granularity(1ms);
+
+  for(int i = 0; i < 3; i++)
+  {
+    // The thread of the previous run may still be finishing here
+    c.start_and_tick();
+    while(c.running())
+      std::this_thread::sleep_for(1ms);
 
+    const auto stats = c.get_statistics();
+    REQUIRE(stats.ticks + stats.missed_ticks >= 10);
+    REQUIRE(stats.ticks + stats.missed_ticks < 100);
+  }
 }
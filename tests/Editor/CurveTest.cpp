@@ -134,3 +134,140 @@ TEST_CASE ("test_destination", "test_destination")
   REQUIRE(c->value_at(0.5) == 0.5);
   REQUIRE(c->value_at(1.) == 1.);
 }
+
+namespace
+{
+// Reference implementation: linear scan over all the points
+template <typename X, typename Y>
+Y scan_value_at(const curve<X, Y>& c, X abscissa)
+{
+  X lastAbscissa = c.get_x0();
+  Y lastValue = c.get_y0();
+  for(const auto& [x, point] : c.get_points())
+  {
+    if(abscissa > lastAbscissa && abscissa <= x)
+      return point.second(
+          ((double)abscissa - (double)lastAbscissa)
+              / ((double)x - (double)lastAbscissa),
+          lastValue, point.first);
+    else if(abscissa > x)
+    {
+      lastAbscissa = x;
+      lastValue = point.first;
+    }
+    else
+      break;
+  }
+  return lastValue;
+}
+}
+
+TEST_CASE ("test_many_points", "test_many_points")
+{
+  curve<double, double> c;
+  c.set_x0(0.);
+  c.set_y0(0.);
+  for(int i = 1; i <= 1000; i++)
+  {
+    if(i % 3 == 0)
+      c.add_point(curve_segment_linear<double>{}, i, (i * 7919) % 100);
+    else if(i % 3 == 1)
+      c.add_point(curve_segment_power<double>{}(0.5 + (i % 5)), i, (i * 7919) % 100);
+    else
+      c.add_point(
+          curve_segment_ease<double, easing::cubicInOut>{}, i, (i * 7919) % 100);
+  }
+
+  // Playback: the cursor moves to the next segment
+  for(double x = -1.; x <= 1001.; x += 0.125)
+    REQUIRE(c.value_at(x) == scan_value_at(c, x));
+
+  // Seeking: binary search
+  for(int i = 0; i < 5000; i++)
+  {
+    const double x = ((i * 104729) % 10020) / 10. - 1.;
+    REQUIRE(c.value_at(x) == scan_value_at(c, x));
+  }
+
+  // The cursor follows the points being removed
+  for(int i = 2; i <= 1000; i += 2)
+    REQUIRE(c.remove_point(i));
+  REQUIRE(!c.remove_point(2.));
+  REQUIRE(c.get_points().size() == 500);
+  for(double x = 1001.; x >= -1.; x -= 0.25)
+    REQUIRE(c.value_at(x) == scan_value_at(c, x));
+}
+
+TEST_CASE ("test_segment_kinds", "test_segment_kinds")
+{
+  // Inline evaluation and type-erased evaluation give the same results
+  curve<double, float> fast, erased;
+  for(auto* c : {&fast, &erased})
+  {
+    c->set_x0(0.);
+    c->set_y0(-1.);
+  }
+
+  fast.add_point(curve_segment_linear<float>{}, 1., 1.);
+  erased.add_point(curve_segment<float>{curve_segment_linear<float>{}}, 1., 1.);
+  fast.add_point(curve_segment_power<float>{}(2.5), 2., 0.);
+  erased.add_point(curve_segment<float>{curve_segment_power<float>{}(2.5)}, 2., 0.);
+  fast.add_point(curve_segment_ease<float, easing::quarticOut>{}, 3., 0.5);
+  erased.add_point(
+      curve_segment<float>{curve_segment_ease<float, easing::quarticOut>{}}, 3., 0.5);
+
+  for(double x = -0.5; x <= 3.5; x += 1. / 64.)
+    REQUIRE(fast.value_at(x) == erased.value_at(x));
+
+  // Copies keep the kind of their segments
+  curve<double, float> copy{fast};
+  for(double x = 3.5; x >= -0.5; x -= 1. / 64.)
+    REQUIRE(copy.value_at(x) == erased.value_at(x));
+}
+
+TEST_CASE ("test_values_at", "test_values_at")
+{
+  curve<double, float> c;
+  c.set_x0(0.);
+  c.set_y0(1.);
+  for(int i = 1; i <= 100; i++)
+  {
+    if(i % 4 == 0)
+      c.add_point(curve_segment_linear<float>{}, i / 100., (i * 7919) % 100 / 50.f);
+    else if(i % 4 == 1)
+      c.add_point(curve_segment_power<float>{}(1.5), i / 100., (i * 7919) % 100 / 50.f);
+    else if(i % 4 == 2)
+      c.add_point(
+          curve_segment_ease<float, easing::sineIn>{}, i / 100., (i * 7919) % 100 / 50.f);
+    else
+      c.add_point(
+          [](double ratio, float start, float end) { return ratio < 0.5 ? start : end; },
+          i / 100., (i * 7919) % 100 / 50.f);
+  }
+
+  for(const double start : {-0.1, 0., 0.005, 0.5, 0.99, 1.5})
+  {
+    for(const double step : {1e-5, 1. / 4096., 0.01, 0.037, 0.5, 0., -0.01})
+    {
+      std::vector<float> block(2048);
+      c.values_at(start, step, block.data(), block.size());
+
+      std::vector<double> block_d(2048);
+      c.values_at(start, step, block_d.data(), block_d.size());
+
+      for(std::size_t k = 0; k < block.size(); k++)
+      {
+        const float expected = c.value_at(start + double(k * step));
+        REQUIRE(block[k] == expected);
+        REQUIRE(block_d[k] == double(expected));
+      }
+    }
+  }
+
+  curve<double, float> empty;
+  empty.set_y0(3.);
+  float out[4];
+  empty.values_at(0., 0.1, out, 4);
+  for(float v : out)
+    REQUIRE(v == 3.f);
+}
@@ -0,0 +1,171 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <catch.hpp>
+#include <ossia/detail/config.hpp>
+
+#include <ossia/math/math_expression.hpp>
+
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Evaluates expr at each point of x and y, with values() and with value()
+static void check_values(const std::string& expr_txt, std::size_t n, bool per_block)
+{
+  std::vector<double> x(n), y(n), block(n), points(n);
+  for(std::size_t i = 0; i < n; i++)
+  {
+    x[i] = double(i) / n - 0.5;
+    y[i] = 2. * double(i) / n;
+  }
+
+  double a = 0.5;
+  ossia::math_expression block_expr;
+  block_expr.add_variable("a", a);
+  block_expr.add_array("x");
+  block_expr.add_array("y");
+  block_expr.add_constants();
+  block_expr.register_symbol_table();
+  REQUIRE(block_expr.set_expression(expr_txt));
+
+  double cur_x{}, cur_y{};
+  ossia::math_expression point_expr;
+  point_expr.add_variable("a", a);
+  point_expr.add_variable("x", cur_x);
+  point_expr.add_variable("y", cur_y);
+  point_expr.add_constants();
+  point_expr.register_symbol_table();
+  REQUIRE(point_expr.set_expression(expr_txt));
+
+  const double* inputs[] = {x.data(), y.data()};
+  block_expr.values(inputs, block.data(), n);
+  REQUIRE(block_expr.evaluates_blocks() == per_block);
+
+  for(std::size_t i = 0; i < n; i++)
+  {
+    cur_x = x[i];
+    cur_y = y[i];
+    points[i] = point_expr.value();
+    REQUIRE(std::abs(block[i] - points[i]) < 1e-9);
+  }
+}
+
+TEST_CASE("test_values_block", "test_values_block")
+{
+  // Evaluated per block
+  check_values("a * x + sin(y * 2 * pi) * (a / 3)", 64, true);
+  check_values("abs(x) + sqrt(y) - floor(y)", 100, true);
+  check_values("a * 3", 16, true);
+
+  // Evaluated point by point
+  check_values("x > 0 ? x : y", 64, false);
+  check_values("max(x, y)", 64, false);
+  check_values("var z := x * 2; z + y", 64, false);
+}
+
+TEST_CASE("test_values_block_size", "test_values_block_size")
+{
+  double a = 2.;
+  ossia::math_expression expr;
+  expr.add_variable("a", a);
+  expr.add_array("x");
+  expr.register_symbol_table();
+  REQUIRE(expr.set_expression("x * a + 1"));
+
+  // Smaller blocks than the largest one run on a prefix of it
+  for(std::size_t n : {8, 8, 32, 5, 32, 1})
+  {
+    std::vector<double> x(n), out(n);
+    for(std::size_t i = 0; i < n; i++)
+      x[i] = i;
+    const double* inputs[] = {x.data()};
+    expr.values(inputs, out.data(), n);
+    REQUIRE(expr.evaluates_blocks());
+    for(std::size_t i = 0; i < n; i++)
+      REQUIRE(out[i] == x[i] * a + 1);
+
+    // Scalar variables are read at each evaluation
+    a += 1.;
+  }
+}
+
+TEST_CASE("test_shared_expressions", "test_shared_expressions")
+{
+  const auto before = ossia::math_expression::cache_stats();
+
+  // Same text and variables: compiled once
+  double a1 = 1., a2 = 2.;
+  ossia::math_expression e1, e2;
+  e1.add_variable("a", a1);
+  e2.add_variable("a", a2);
+  e1.register_symbol_table();
+  e2.register_symbol_table();
+  REQUIRE(e1.set_expression("a := a + 1; a * 10"));
+  REQUIRE(e2.set_expression("a := a + 1; a * 10"));
+
+  auto after = ossia::math_expression::cache_stats();
+  REQUIRE(after.misses == before.misses + 1);
+  REQUIRE(after.hits == before.hits + 1);
+
+  // Each instance evaluates with its own variables
+  REQUIRE(e1.value() == 20.);
+  REQUIRE(e2.value() == 30.);
+  REQUIRE(e1.value() == 30.);
+  REQUIRE(a1 == 3.);
+  REQUIRE(a2 == 3.);
+  REQUIRE(e1.has_variable("a"));
+
+  // Another constant value is another compiled expression
+  double c1 = 1., c2 = 2.;
+  ossia::math_expression k1, k2;
+  k1.add_constant("c", c1);
+  k2.add_constant("c", c2);
+  k1.register_symbol_table();
+  k2.register_symbol_table();
+  REQUIRE(k1.set_expression("c * 2"));
+  REQUIRE(k2.set_expression("c * 2"));
+  REQUIRE(k1.value() == 2.);
+  REQUIRE(k2.value() == 4.);
+  REQUIRE(ossia::math_expression::cache_stats().misses == after.misses + 2);
+
+  // Compilation errors are still reported
+  ossia::math_expression bad;
+  bad.register_symbol_table();
+  REQUIRE(!bad.set_expression("1 +"));
+  REQUIRE(!bad.error().empty());
+}
+
+TEST_CASE("test_shared_expressions_threads", "test_shared_expressions_threads")
+{
+  // Instances sharing an expression, evaluated at the same time
+  constexpr int count = 4;
+  constexpr int iterations = 10000;
+  double vars[count]{};
+  std::vector<std::unique_ptr<ossia::math_expression>> exprs;
+  for(int i = 0; i < count; i++)
+  {
+    auto& e = *exprs.emplace_back(std::make_unique<ossia::math_expression>());
+    e.add_variable("a", vars[i]);
+    e.register_symbol_table();
+    REQUIRE(e.set_expression("a := a + 1; a * 2"));
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<double> last(count);
+  for(int i = 0; i < count; i++)
+    threads.emplace_back([&, i] {
+      for(int k = 0; k < iterations; k++)
+        last[i] = exprs[i]->value();
+    });
+  for(auto& t : threads)
+    t.join();
+
+  // No evaluation saw the variables of another instance
+  for(int i = 0; i < count; i++)
+  {
+    REQUIRE(vars[i] == iterations);
+    REQUIRE(last[i] == 2. * iterations);
+  }
+}
@@ -1583,3 +1583,112 @@ TEST_CASE ("test_exec_chain_loop", "test_exec_chain_loop")
   REQUIRE(c0->get_date() == 5_tv);
   REQUIRE(c1->get_date() == 0_tv);
 }
+
+TEST_CASE ("test_compiled_scenario", "test_compiled_scenario")
+{
+  using namespace ossia;
+  root_scenario s;
+
+  ossia::scenario& scenario = *s.scenario;
+  std::shared_ptr<time_event> e0 = start_event(scenario);
+  std::shared_ptr<time_event> e1 = create_event(scenario);
+  std::shared_ptr<time_event> e2 = create_event(scenario);
+
+  std::shared_ptr<time_interval> c0 = time_interval::create({}, *e0, *e1, 10_tv, 10_tv, 10_tv);
+  std::shared_ptr<time_interval> c1 = time_interval::create({}, *e1, *e2, 10_tv, 10_tv, 10_tv);
+  std::shared_ptr<time_interval> c2 = time_interval::create({}, *e0, *e2, 10_tv, 10_tv, 10_tv);
+  scenario.add_time_interval(c0);
+  scenario.add_time_interval(c1);
+  scenario.add_time_interval(c2);
+
+  compiled_scenario cs;
+  cs.build(scenario.get_time_syncs(), scenario.get_time_intervals());
+  REQUIRE(cs.interval_count() == 3);
+  REQUIRE(cs.event_count() == 3);
+
+  auto to_vec = [] (compiled_scenario::index_range r) {
+    return std::vector<compiled_scenario::index>(r.begin(), r.end());
+  };
+  const auto i0 = cs.index_of(c0.get());
+  const auto i1 = cs.index_of(c1.get());
+  const auto i2 = cs.index_of(c2.get());
+
+  REQUIRE(to_vec(cs.previous_intervals(cs.index_of(e0.get()))).empty());
+  REQUIRE(to_vec(cs.next_intervals(cs.index_of(e0.get()))) == std::vector{i0, i2});
+  REQUIRE(to_vec(cs.previous_intervals(cs.index_of(e1.get()))) == std::vector{i0});
+  REQUIRE(to_vec(cs.next_intervals(cs.index_of(e1.get()))) == std::vector{i1});
+  REQUIRE(to_vec(cs.previous_intervals(cs.index_of(e2.get()))) == std::vector{i1, i2});
+
+  REQUIRE(cs.get_interval(i1).start_event == cs.index_of(e1.get()));
+  REQUIRE(cs.get_interval(i1).end_event == cs.index_of(e2.get()));
+
+  interval_bitset running;
+  running.resize(cs.interval_count());
+  running.insert(i2);
+  running.insert(i0);
+  REQUIRE(running.size() == 2);
+
+  std::vector<compiled_scenario::index> visited;
+  running.for_each([&] (auto i) { visited.push_back(i); running.erase(i); });
+  REQUIRE(visited == std::vector{i0, i2});
+  REQUIRE(running.empty());
+
+  // Removed intervals are not part of the next build
+  scenario.remove_time_interval(c2);
+  cs.build(scenario.get_time_syncs(), scenario.get_time_intervals());
+  REQUIRE(cs.index_of(c2.get()) == compiled_scenario::invalid);
+  REQUIRE(to_vec(cs.previous_intervals(cs.index_of(e2.get()))) == std::vector{cs.index_of(c1.get())});
+}
+
+TEST_CASE ("test_edit_while_running", "test_edit_while_running")
+{
+  using namespace ossia;
+  root_scenario s;
+
+  ossia::scenario& scenario = *s.scenario;
+  std::shared_ptr<time_event> e0 = start_event(scenario);
+  std::shared_ptr<time_event> e1 = create_event(scenario);
+  std::shared_ptr<time_event> e2 = create_event(scenario);
+  std::shared_ptr<time_event> e3 = create_event(scenario);
+
+  std::shared_ptr<time_interval> c0 = time_interval::create({}, *e0, *e1, 5000_tv, 5000_tv, 5000_tv);
+  std::shared_ptr<time_interval> c2 = time_interval::create({}, *e0, *e3, 8000_tv, 8000_tv, 8000_tv);
+  scenario.add_time_interval(c0);
+  scenario.add_time_interval(c2);
+
+  s.interval->start_and_tick();
+  s.interval->tick(1000_tv, default_request());
+  REQUIRE(c0->get_date() == 1000_tv);
+  REQUIRE(c2->get_date() == 1000_tv);
+
+  // Edits between two ticks: the scenario is built again on the next tick
+  scenario.remove_time_interval(c2);
+  std::shared_ptr<time_interval> c1 = time_interval::create({}, *e1, *e2, 5000_tv, 5000_tv, 5000_tv);
+  scenario.add_time_interval(c1);
+
+  // The running interval survives the rebuild, the removed one stops
+  s.interval->tick(1000_tv, default_request());
+  REQUIRE(c0->get_date() == 2000_tv);
+  REQUIRE(c2->get_date() == 1000_tv);
+  REQUIRE(c1->get_date() == 0_tv);
+
+  // An event added to a sync without touching the scenario is not part
+  // of the build; it still happens with its sync
+  auto& sync1 = e1->get_time_sync();
+  auto e4 = std::make_shared<time_event>(
+      time_event::exec_callback{}, sync1, expressions::make_expression_true());
+  sync1.insert(sync1.get_time_events().end(), e4);
+
+  // The end of c0 starts the interval added during the execution
+  s.interval->tick(4000_tv, default_request());
+  auto happened = [] (const time_event& e) {
+    return uint8_t(e.get_status()) & uint8_t(time_event::status::HAPPENED);
+  };
+  REQUIRE(happened(*e1));
+  REQUIRE(happened(*e4));
+  REQUIRE(c1->get_date() == 1000_tv);
+
+  s.interval->tick(1000_tv, default_request());
+  REQUIRE(c1->get_date() == 2000_tv);
+  REQUIRE(c2->get_date() == 1000_tv);
+}
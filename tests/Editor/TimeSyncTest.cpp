@@ -5,6 +5,7 @@
 #include <ossia/detail/config.hpp>
 #include <ossia/editor/scenario/time_event.hpp>
 #include <ossia/editor/scenario/time_sync.hpp>
+#include <ossia/network/generic/generic_device.hpp>
 
 #include <iostream>
 
@@ -52,3 +53,79 @@ TEST_CASE ("test_edition", "test_edition")
 
   REQUIRE(node->get_time_events().size() == 1);
 }
+
+/*! test that an observed expression is only evaluated when its inputs change */
+TEST_CASE ("test_observed_expression", "test_observed_expression")
+{
+  ossia::net::generic_device device{"test"};
+  auto param = device.create_child("my_int")->create_parameter(val_type::INT);
+  param->set_value(0);
+
+  auto node = std::make_shared<time_sync>();
+  node->set_expression(expressions::make_expression_atom(
+      destination(*param), expressions::comparator::GREATER, 5));
+
+  // Not observed: the parameter is polled
+  REQUIRE(node->evaluate_expression() == false);
+  param->set_value_quiet(10);
+  REQUIRE(node->evaluate_expression() == true);
+  param->set_value(0);
+
+  node->observe_expression(true);
+  REQUIRE(node->evaluate_expression() == false);
+
+  // set_value_quiet does not notify: as long as nothing notifies,
+  // the expression is not evaluated again and the previous result is kept
+  param->set_value_quiet(10);
+  for(int i = 0; i < 3; i++)
+    REQUIRE(node->evaluate_expression() == false);
+
+  // set_value notifies: the expression is evaluated again, once
+  param->set_value(10);
+  REQUIRE(node->evaluate_expression() == true);
+  param->set_value_quiet(0);
+  REQUIRE(node->evaluate_expression() == true);
+
+  param->set_value(3);
+  REQUIRE(node->evaluate_expression() == false);
+
+  node->observe_expression(false);
+  param->set_value_quiet(10);
+  REQUIRE(node->evaluate_expression() == true);
+}
+
+/*! test that replacing an observed expression observes the new one */
+TEST_CASE ("test_observed_set_expression", "test_observed_set_expression")
+{
+  ossia::net::generic_device device{"test"};
+  auto a = device.create_child("a")->create_parameter(val_type::INT);
+  auto b = device.create_child("b")->create_parameter(val_type::INT);
+  a->set_value(0);
+  b->set_value(0);
+
+  auto node = std::make_shared<time_sync>();
+  node->set_expression(expressions::make_expression_atom(
+      destination(*a), expressions::comparator::GREATER, 5));
+  node->observe_expression(true);
+  REQUIRE(node->evaluate_expression() == false);
+  REQUIRE(a->callback_count() == 1);
+
+  node->set_expression(expressions::make_expression_atom(
+      destination(*b), expressions::comparator::GREATER, 5));
+  REQUIRE(a->callback_count() == 0);
+  REQUIRE(b->callback_count() == 1);
+  REQUIRE(node->evaluate_expression() == false);
+
+  // Changes of the new expression are seen
+  b->set_value(10);
+  REQUIRE(node->evaluate_expression() == true);
+
+  // Changes of the old one are not
+  b->set_value_quiet(0);
+  a->set_value(10);
+  REQUIRE(node->evaluate_expression() == true);
+
+  node->observe_expression(false);
+  REQUIRE(b->callback_count() == 0);
+  REQUIRE(node->evaluate_expression() == false);
+}
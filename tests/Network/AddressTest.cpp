@@ -10,7 +10,10 @@
 #include <ossia/network/common/complex_type.hpp>
 #include <ossia/network/domain/domain.hpp>
 
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <thread>
 #include <ossia/detail/for_each.hpp>
 #include <ossia/network/oscquery/oscquery_server.hpp>
 #include "../Benchmarks/Random.hpp"
@@ -65,6 +68,87 @@ TEST_CASE( "Units", "[Units]" )
     });
   });
 }
+TEST_CASE( "Concurrent values", "[Parameters]" )
+{
+  ossia::net::generic_device device{"test"};
+  auto param = device.create_child("child")->create_parameter(val_type::VEC3F);
+
+  // Vectors are read without locking: a reader must never see half a write
+  std::atomic_bool done{};
+  std::thread writer{[&] {
+    for(int i = 0; i < 100000; i++)
+      param->set_value(ossia::make_vec(float(i), float(i), float(i)));
+    param->set_value(std::string("foo"));
+    done = true;
+  }};
+
+  while(!done)
+  {
+    auto v = param->value();
+    if(auto vec = v.target<ossia::vec3f>())
+    {
+      REQUIRE((*vec)[0] == (*vec)[1]);
+      REQUIRE((*vec)[1] == (*vec)[2]);
+    }
+  }
+  writer.join();
+
+  // Strings and lists go through the lock
+  REQUIRE(param->value() == ossia::value{std::string("foo")});
+  param->set_value(std::vector<ossia::value>{1, 2.f});
+  REQUIRE(param->value() == ossia::value{std::vector<ossia::value>{1, 2.f}});
+  param->set_value(ossia::make_vec(1.f, 2.f, 3.f));
+  REQUIRE(param->value() == ossia::value{ossia::make_vec(1.f, 2.f, 3.f)});
+}
+
+TEST_CASE( "Concurrent callbacks", "[Parameters]" )
+{
+  ossia::net::generic_device device{"test"};
+  auto param = device.create_child("child")->create_parameter(val_type::FLOAT);
+
+  std::atomic_bool done{};
+  std::thread sender{[&] {
+    while(!done)
+      param->set_value(1.f);
+  }};
+
+  // Once remove_callback returns, the callback is not running anymore
+  // and what it uses can be destroyed
+  for(int i = 0; i < 1000; i++)
+  {
+    auto count = std::make_unique<std::atomic_int>(0);
+    auto it = param->add_callback([c = count.get()](const ossia::value&) { (*c)++; });
+    std::this_thread::yield();
+    param->remove_callback(it);
+    count.reset();
+  }
+
+  done = true;
+  sender.join();
+  REQUIRE(param->callbacks_empty());
+}
+
+TEST_CASE( "Moved callbacks", "[Parameters]" )
+{
+  using container = ossia::callback_container<std::function<void(int)>>;
+  int calls = 0;
+
+  // The callbacks belong to the target: the source must not call them anymore
+  container source;
+  source.add_callback([&](int) { calls++; });
+  container target;
+  target = std::move(source);
+  source.send(1);
+  REQUIRE(calls == 0);
+  REQUIRE(source.callbacks_empty());
+  target.send(1);
+  REQUIRE(calls == 1);
+
+  container constructed{std::move(target)};
+  constructed.send(1);
+  REQUIRE(calls == 2);
+}
+
 /*
 // TODO this is a benchmark not a test
 TEST_CASE( "Parameters", "[Parameters]")
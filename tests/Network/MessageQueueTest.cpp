@@ -0,0 +1,83 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <catch.hpp>
+#include <ossia/detail/config.hpp>
+
+#include <ossia/network/base/message_queue.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace ossia;
+using namespace ossia::net;
+
+TEST_CASE ("test_message_queue_drain", "test_message_queue_drain")
+{
+  generic_device device{"test"};
+  auto a = device.create_child("a")->create_parameter(val_type::INT);
+  auto b = device.create_child("b")->create_parameter(val_type::INT);
+
+  message_queue mq{device};
+  mq.reg(*a);
+  mq.reg(*b);
+
+  for(int i = 0; i < 200; i++)
+  {
+    a->push_value(i);
+    b->push_value(-i);
+  }
+
+  std::vector<int> va, vb;
+  auto n = mq.drain([&](received_value&& v) {
+    (v.address == a ? va : vb).push_back(v.value.get<int>());
+  });
+
+  REQUIRE(n == 400);
+  REQUIRE(va.size() == 200);
+  REQUIRE(vb.size() == 200);
+  for(int i = 0; i < 200; i++)
+  {
+    REQUIRE(va[i] == i);
+    REQUIRE(vb[i] == -i);
+  }
+
+  REQUIRE(mq.drain([](auto&&) { }) == 0);
+}
+
+TEST_CASE ("test_message_queue_coalesce", "test_message_queue_coalesce")
+{
+  generic_device device{"test"};
+  auto a = device.create_child("a")->create_parameter(val_type::INT);
+  auto b = device.create_child("b")->create_parameter(val_type::INT);
+
+  message_queue mq{device};
+  mq.set_coalesce(true);
+  mq.reg(*a);
+  mq.reg(*b);
+
+  std::thread t{[&] {
+    for(int i = 0; i <= 1000; i++)
+      a->push_value(i);
+  }};
+  for(int i = 0; i <= 1000; i++)
+    b->push_value(i);
+  t.join();
+
+  int last_a = -1, last_b = -1;
+  auto n = mq.drain([&](received_value&& v) {
+    (v.address == a ? last_a : last_b) = v.value.get<int>();
+  });
+  REQUIRE(n == 2);
+  REQUIRE(last_a == 1000);
+  REQUIRE(last_b == 1000);
+
+  // The next value is queued again once the previous one was taken
+  a->push_value(5);
+  received_value v;
+  REQUIRE(mq.try_dequeue(v));
+  REQUIRE(v.address == a);
+  REQUIRE(v.value == ossia::value{5});
+  REQUIRE(!mq.try_dequeue(v));
+}
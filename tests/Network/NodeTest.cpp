@@ -8,6 +8,7 @@
 #include <ossia/network/common/path.hpp>
 #include <ossia/network/generic/generic_device.hpp>
 #include <ossia/network/generic/generic_parameter.hpp>
+#include <ossia/network/base/parameter_index.hpp>
 #include <ossia/network/common/complex_type.hpp>
 
 #include <regex>
@@ -520,3 +521,36 @@ TEST_CASE ("test_pattern_matching", "test_pattern_matching")
     }
   }
 }
+
+TEST_CASE ("test_parameter_index", "test_parameter_index")
+{
+  ossia::net::generic_device device{"test"};
+  auto& index = *device.get_parameter_index();
+
+  auto& baz = ossia::net::create_node(device, "/foo/bar/baz");
+  auto& blop = ossia::net::create_node(device, "/foo/blop");
+  auto p_baz = baz.create_parameter(ossia::val_type::FLOAT);
+  auto p_blop = blop.create_parameter(ossia::val_type::INT);
+
+  REQUIRE(index.size() == 2);
+  REQUIRE(device.find_parameter("/foo/bar/baz") == p_baz);
+  REQUIRE(device.find_parameter("/foo/blop") == p_blop);
+  REQUIRE(device.find_parameter("/foo/bar") == nullptr);
+
+  // Renaming a node moves its whole subtree
+  baz.get_parent()->set_name("war");
+  REQUIRE(index.find("/foo/bar/baz") == nullptr);
+  REQUIRE(index.find("/foo/war/baz") == p_baz);
+
+  blop.remove_parameter();
+  REQUIRE(index.find("/foo/blop") == nullptr);
+
+  device.remove_child("foo");
+  REQUIRE(index.size() == 0);
+
+  // Rebuilt from the current tree when enabled again
+  device.set_parameter_index_enabled(false);
+  auto p = ossia::net::create_node(device, "/a/b").create_parameter();
+  device.set_parameter_index_enabled(true);
+  REQUIRE(device.get_parameter_index()->find("/a/b") == p);
+}
@@ -1,9 +1,13 @@
 
 #include <catch.hpp>
+#include <ossia/network/base/node_functions.hpp>
 #include <ossia/network/context.hpp>
 #include <ossia/network/sockets/udp_socket.hpp>
 #include "AsyncTestUtils.hpp"
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace ossia;
 
@@ -83,6 +87,182 @@ TEST_CASE ("test_comm_osc_udp_big", "test_comm_osc_udp_big")
   REQUIRE(received_from_server ==  ossia::value{long_str});
 }
 
+TEST_CASE ("test_comm_osc_udp_coalesced", "test_comm_osc_udp_coalesced")
+{
+  using namespace ossia::net;
+  using proto = osc_generic_bidir_protocol<osc_protocol_client<osc_1_0_policy>, udp_send_socket, udp_receive_socket>;
+
+  auto ctx = std::make_shared<ossia::net::network_context>();
+
+  ossia::net::generic_device server{std::make_unique<proto>(ctx, *server_conf.remote, *server_conf.local), "a"};
+  ossia::net::generic_device client{std::make_unique<proto>(ctx, *client_conf.remote, *client_conf.local), "b"};
+
+  auto& client_proto = static_cast<proto&>(client.get_protocol());
+  client_proto.set_output_coalescing(true);
+
+  auto server_a = ossia::net::create_node(server, "/a").create_parameter(ossia::val_type::INT);
+  auto server_b = ossia::net::create_node(server, "/b").create_parameter(ossia::val_type::INT);
+  auto client_a = ossia::net::create_node(client, "/a").create_parameter(ossia::val_type::INT);
+  auto client_b = ossia::net::create_node(client, "/b").create_parameter(ossia::val_type::INT);
+
+  int received = 0;
+  auto on_message = [&] (const ossia::net::parameter_base&) { received++; };
+  server.on_message.connect<decltype(on_message)>(on_message);
+
+  // Nothing is sent before the end of the tick
+  client_proto.begin_tick();
+  client_a->push_value(1);
+  client_a->push_value(2);
+  client_b->push_value(3);
+  client_a->push_value(4);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ctx->context.poll();
+  REQUIRE(received == 0);
+
+  // A single bundle with the last value of each parameter
+  client_proto.flush_output();
+  ctx->context.run_one();
+
+  REQUIRE(received == 2);
+  REQUIRE(server_a->value() == ossia::value{4});
+  REQUIRE(server_b->value() == ossia::value{3});
+
+  // The buffer was cleared: a single message is not wrapped in a bundle
+  client_proto.begin_tick();
+  client_b->push_value(5);
+  client_proto.flush_output();
+  ctx->context.run_one();
+
+  REQUIRE(received == 3);
+  REQUIRE(server_b->value() == ossia::value{5});
+
+  // Outside of a tick, messages are sent immediately
+  client_a->push_value(6);
+  ctx->context.run_one();
+
+  REQUIRE(received == 4);
+  REQUIRE(server_a->value() == ossia::value{6});
+}
+
+TEST_CASE ("test_comm_osc_udp_coalesced_split", "test_comm_osc_udp_coalesced_split")
+{
+  using namespace ossia::net;
+  using proto = osc_generic_bidir_protocol<osc_protocol_client<osc_1_0_policy>, udp_send_socket, udp_receive_socket>;
+
+  auto ctx = std::make_shared<ossia::net::network_context>();
+
+  ossia::net::generic_device server{std::make_unique<proto>(ctx, *server_conf.remote, *server_conf.local), "a"};
+  ossia::net::generic_device client{std::make_unique<proto>(ctx, *client_conf.remote, *client_conf.local), "b"};
+
+  // "/pN" with an int is 12 bytes, 16 in a bundle: with the 16 bytes of
+  // the bundle header, 3 messages fit in 64 bytes.
+  auto& client_proto = static_cast<proto&>(client.get_protocol());
+  client_proto.set_output_coalescing(true, 64);
+
+  constexpr int count = 10;
+  std::vector<ossia::net::parameter_base*> server_params, client_params;
+  for(int i = 0; i < count; i++)
+  {
+    const auto name = "/p" + std::to_string(i);
+    server_params.push_back(ossia::net::create_node(server, name).create_parameter(ossia::val_type::INT));
+    client_params.push_back(ossia::net::create_node(client, name).create_parameter(ossia::val_type::INT));
+  }
+
+  int received = 0;
+  auto on_message = [&] (const ossia::net::parameter_base&) { received++; };
+  server.on_message.connect<decltype(on_message)>(on_message);
+
+  client_proto.begin_tick();
+  for(int i = 0; i < count; i++)
+    client_params[i]->push_value(100 + i);
+  client_proto.flush_output();
+
+  // Three bundles of three messages, then the last one on its own
+  for(int i = 0; i < 4; i++)
+    ctx->context.run_one();
+
+  REQUIRE(received == count);
+  for(int i = 0; i < count; i++)
+    REQUIRE(server_params[i]->value() == ossia::value{100 + i});
+}
+
+TEST_CASE ("test_osc_output_coalescer", "test_osc_output_coalescer")
+{
+  using namespace ossia::net;
+  osc_output_coalescer c;
+  c.set_output_coalescing(true, 64);
+
+  auto message = [] (std::size_t sz) {
+    return [sz] (osc_output_coalescer::message_writer w) {
+      std::string m(sz, 'x');
+      w(m.data(), m.size());
+    };
+  };
+
+  // Not in a tick: nothing is buffered
+  int keys[8]{};
+  REQUIRE(!c.buffer_message(&keys[0], message(12)));
+
+  c.begin_output_tick();
+  for(int i = 0; i < 8; i++)
+    REQUIRE(c.buffer_message(&keys[i], message(12)));
+  // Replaces the pending message of the same key
+  REQUIRE(c.buffer_message(&keys[0], message(20)));
+
+  std::vector<std::string> sent;
+  c.flush_output_buffer([&] (const std::vector<std::string>& datagrams) {
+    sent = datagrams;
+  });
+
+  // 16 + (4 + 20) + (4 + 12) = 56, then 16 + 3 * (4 + 12) = 64, twice
+  REQUIRE(sent.size() == 3);
+  REQUIRE(sent[0].size() == 56);
+  REQUIRE(sent[1].size() == 64);
+  REQUIRE(sent[2].size() == 64);
+  for(const auto& d : sent)
+    REQUIRE(d.compare(0, 8, std::string("#bundle\0", 8)) == 0);
+
+  // The tick is over
+  REQUIRE(!c.buffer_message(&keys[0], message(12)));
+}
+
+TEST_CASE ("test_comm_osc_udp_batched_receive", "test_comm_osc_udp_batched_receive")
+{
+  using namespace ossia::net;
+  using proto = osc_generic_bidir_protocol<osc_protocol_client<osc_1_0_policy>, udp_send_socket, udp_receive_socket>;
+
+  auto ctx = std::make_shared<ossia::net::network_context>();
+
+  auto conf = server_conf;
+  conf.local->batch_size = 16;
+  auto server_proto = std::make_unique<proto>(ctx, *conf.remote, *conf.local);
+  auto& server_socket = server_proto->from_client;
+  ossia::net::generic_device server{std::move(server_proto), "a"};
+  ossia::net::generic_device client{std::make_unique<proto>(ctx, *client_conf.remote, *client_conf.local), "b"};
+
+  auto server_a = ossia::net::create_node(server, "/a").create_parameter(ossia::val_type::INT);
+
+  int received = 0;
+  auto on_message = [&] (const ossia::net::parameter_base&) { received++; };
+  server.on_message.connect<decltype(on_message)>(on_message);
+
+  // More datagrams than the size of a batch
+  for(int i = 0; i < 40; i++)
+    client.get_protocol().push_raw({"/a", ossia::value{i}});
+
+  while(received < 40)
+    if(ctx->context.run_one_for(std::chrono::seconds(1)) == 0)
+      break;
+
+  REQUIRE(received == 40);
+  REQUIRE(server_a->value() == ossia::value{39});
+
+  const auto stats = server_socket.statistics();
+  REQUIRE(stats.received == 40);
+  REQUIRE(stats.dropped == 0);
+}
+
 TEST_CASE ("test_comm_osc_udp", "test_comm_osc_udp")
 {
   using namespace ossia::net;
@@ -98,3 +278,55 @@ TEST_CASE ("test_comm_osc_udp", "test_comm_osc_udp")
 }
 
 #endif
+
+#if defined(__linux__)
+TEST_CASE ("test_udp_batched_receive_again", "test_udp_batched_receive_again")
+{
+  // receive() can be called again after the socket was closed and reopened,
+  // with the same or another batch size
+  using namespace ossia::net;
+  boost::asio::io_context ctx;
+
+  receive_socket_configuration recv_conf{{"127.0.0.1", 9876}};
+  recv_conf.batch_size = 4;
+  udp_receive_socket receiver{recv_conf, ctx};
+  udp_send_socket sender{socket_configuration{"127.0.0.1", 9876}, ctx};
+  sender.connect();
+
+  std::vector<std::string> received;
+  auto on_datagram = [&](const char* data, std::size_t sz) {
+    received.emplace_back(data, sz);
+  };
+
+  auto send_and_receive = [&](int count) {
+    received.clear();
+    for(int i = 0; i < count; i++)
+    {
+      const auto str = std::to_string(i);
+      sender.write(str.data(), str.size());
+    }
+    for(int i = 0; i < 100 && int(received.size()) < count; i++)
+      ctx.run_one_for(std::chrono::milliseconds(10));
+
+    REQUIRE(int(received.size()) == count);
+    for(int i = 0; i < count; i++)
+      REQUIRE(received[i] == std::to_string(i));
+  };
+
+  for(std::size_t batch : {4, 4, 8})
+  {
+    receiver.set_batch_size(batch);
+    receiver.open();
+    receiver.receive(on_datagram);
+    send_and_receive(10);
+
+    receiver.close();
+    ctx.run_for(std::chrono::milliseconds(10));
+    ctx.restart();
+  }
+
+  const auto stats = receiver.statistics();
+  REQUIRE(stats.received == 30);
+  REQUIRE(stats.dropped == 0);
+}
+#endif
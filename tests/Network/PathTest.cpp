@@ -9,6 +9,7 @@
 #include <set>
 
 #include <ossia/network/common/path.hpp>
+#include <ossia/network/common/path_pattern.hpp>
 #include <ossia/detail/algorithms.hpp>
 #include <ossia/network/base/osc_address.hpp>
 #include <boost/algorithm/string/replace.hpp>
@@ -633,3 +634,94 @@ TEST_CASE ("test_device", "test_device")
   REQUIRE(vec == (std::vector<ossia::net::node_base*>{&b2}));
 
 }
+
+TEST_CASE ("test_segment_pattern", "test_segment_pattern")
+{
+  auto match = [] (std::string_view p, std::string_view s) {
+    return traversal::segment_pattern{p}.match(s);
+  };
+
+  REQUIRE(match("b??", "bar"));
+  REQUIRE(match("b?*", "b"));
+  REQUIRE(!match("b??", "bars"));
+  REQUIRE(match("[bw]*", "war"));
+  REQUIRE(!match("[bw]*", "kar"));
+  REQUIRE(match("[!bw]ar", "kar"));
+  REQUIRE(match("[a-c]", "b"));
+  REQUIRE(match("*a*b", "xxaab"));
+  REQUIRE(!match("*a*b", "xxaa"));
+  REQUIRE(match("{foo,b*r}x", "bzzrx"));
+  REQUIRE(!match("{foo,bar}", "baz"));
+  REQUIRE(match("{a,{b,c}d}", "cd"));
+  REQUIRE(match("bar!", "bar.1"));
+  REQUIRE(!match("bar!", "bar.1.2"));
+  REQUIRE(match("bar!!", "bar.1.2"));
+  REQUIRE(!match("bar.*", "barX1"));
+  REQUIRE(match("spot\\.*", "spot.count"));
+
+  REQUIRE_THROWS(traversal::segment_pattern{"[abc"});
+  REQUIRE_THROWS(traversal::segment_pattern{"{abc"});
+}
+
+TEST_CASE ("test_segment_pattern_complexity", "test_segment_pattern_complexity")
+{
+  // Patterns come from the network: matching must not backtrack
+  // exponentially on stars, instances or alternatives
+  using namespace std::chrono;
+  std::string stars;
+  for(int i = 0; i < 16; i++)
+    stars += "*a";
+  stars += "*b";
+
+  std::string alternatives;
+  for(int i = 0; i < 16; i++)
+    alternatives += "{*a,a*,?}";
+  alternatives += "b";
+
+  std::string instances(24, '!');
+  instances += "x";
+
+  std::string dotted;
+  for(int i = 0; i < 20; i++)
+    dotted += ".a";
+
+  const std::string name(40, 'a');
+  // Pattern, name it does not match, name it matches
+  const std::tuple<std::string, std::string, std::string> cases[]{
+      {stars, name, name + "b"},
+      {alternatives, name, name + "b"},
+      {instances, dotted, dotted + "x"}};
+  for(const auto& [pattern, no, yes] : cases)
+  {
+    const traversal::segment_pattern p{pattern};
+    const auto t0 = steady_clock::now();
+    for(int i = 0; i < 100; i++)
+    {
+      REQUIRE(!p.match(no));
+      REQUIRE(p.match(yes));
+    }
+    REQUIRE(steady_clock::now() - t0 < 1s);
+  }
+}
+
+TEST_CASE ("test_path_cache", "test_path_cache")
+{
+  traversal::path_cache cache{2};
+
+  auto p1 = cache.get("/foo/*");
+  REQUIRE(p1);
+  REQUIRE(cache.get("/foo/*") == p1);
+  REQUIRE(cache.size() == 1);
+
+  cache.get("/bar/*");
+  cache.get("/foo/*");
+  cache.get("/baz/*");
+
+  // "/bar/*" was the least recently used
+  REQUIRE(cache.size() == 2);
+  REQUIRE(cache.get("/foo/*") == p1);
+  REQUIRE(p1->pattern == "/foo/*");
+
+  cache.clear();
+  REQUIRE(cache.size() == 0);
+}
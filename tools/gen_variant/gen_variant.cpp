@@ -300,6 +300,10 @@ struct gen_var
   std::string class_name;
   std::string constexpr_token = "";
 
+  //! The first hot_types alternatives are tested before the switch
+  //! in the single-variant apply functions
+  int hot_types = 0;
+
   str_writer str;
 
   using var_impl = brigand::transform<var_type, brigand::bind<var_member, brigand::_1>>;
@@ -773,6 +777,18 @@ static Type matching_type();
       i++;
     });
   }
+  void write_apply_hot_types(std::string orn_before, std::string orn_after)
+  {
+    if(hot_types == 0)
+      return;
+    str << "  // Float and int first: most values are one or the other\n";
+    for(int i = 0; i < hot_types; i++)
+    {
+      str << "  if(var.m_type == " << class_name << "::Type::Type" << i << ")\n";
+      str << "    return functor(" << orn_before << "var.m_impl.m_value" << i << orn_after << ");\n";
+    }
+  }
+
   struct cref
   {
     std::string type_prefix = "const";
@@ -800,6 +816,7 @@ static Type matching_type();
   {
     str << "template<typename Visitor>\n";
     str << "auto apply_nonnull(Visitor&& functor, " << r.type_prefix << " " << class_name << r.type_suffix << " var) {\n";
+    write_apply_hot_types(r.val_prefix, r.val_suffix);
     str << "  switch (var.m_type) { \n";
     write_apply_switch(r.val_prefix, r.val_suffix);
     str << "  default: throw std::runtime_error(\"" << class_name << ": bad type\");\n";
@@ -812,6 +829,7 @@ static Type matching_type();
   {
     str << "template<typename Visitor>\n";
     str << "auto apply(Visitor&& functor, " << r.type_prefix << " " << class_name << r.type_suffix << " var) {\n";
+    write_apply_hot_types(r.val_prefix, r.val_suffix);
     str << "  switch (var.m_type) { \n";
     write_apply_switch(r.val_prefix, r.val_suffix);
     str << "  default: return functor();\n";
@@ -973,6 +991,7 @@ int main()
     std::ofstream f("/home/jcelerier/score/API/ossia/ossia/network/value/value_variant_impl.hpp");
 
     gen_var<value_list> value_gen("value_variant_type");
+    value_gen.hot_types = 2;
     value_gen.write_class();
     f << value_gen.str.str();
 